@@ -0,0 +1,83 @@
+## @file
+#  Time LzmaCompress on the FV images of an OvmfPkg build with different
+#  numbers of encoder threads, and check that the output does not change.
+#
+#  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+VersionNumber = '0.1'
+import os
+import sys
+import glob
+import time
+import filecmp
+import argparse
+import tempfile
+import subprocess
+
+DefaultFvNames = ['PEIFV.Fv', 'DXEFV.Fv']
+
+def FindFvFiles(Workspace):
+    FvFiles = []
+    for FvName in DefaultFvNames:
+        FvFiles += glob.glob(os.path.join(Workspace, 'Build', 'Ovmf*', '*', 'FV', FvName))
+    return sorted(FvFiles)
+
+def Compress(Tool, FvFile, OutputFile, Threads, Options):
+    Cmd = [Tool, '-e', '-q', '--threads', str(Threads), '-o', OutputFile] + Options + [FvFile]
+    Start = time.time()
+    subprocess.check_call(Cmd)
+    return time.time() - Start
+
+def Main():
+    PARSER = argparse.ArgumentParser(
+        description='Time LzmaCompress on OvmfPkg FV images with different thread counts - Version ' + VersionNumber)
+    PARSER.add_argument('FvFiles', nargs='*',
+                        help='FV images to compress. Default: PEIFV.Fv and DXEFV.Fv of all OvmfPkg builds in the WORKSPACE.')
+    PARSER.add_argument('--tool', default='LzmaCompress',
+                        help='LzmaCompress executable to run. Default: LzmaCompress found in PATH.')
+    PARSER.add_argument('--threads', default='1,2',
+                        help='Comma separated list of thread counts to time. Default: 1,2')
+    PARSER.add_argument('--repeat', type=int, default=3,
+                        help='Number of runs per thread count, the fastest one is reported. Default: 3')
+    PARSER.add_argument('--f86', action='store_true',
+                        help='Enable the x86 converter, as the LZMAF86 GUIDed tool does.')
+
+    ARGS = PARSER.parse_args()
+    FvFiles = ARGS.FvFiles
+    if not FvFiles:
+        FvFiles = FindFvFiles(os.environ.get('WORKSPACE', os.getcwd()))
+    if not FvFiles:
+        print ("ERROR: No FV image found. Build OvmfPkg first or name the FV images on the command line.")
+        return 1
+    ThreadList = [int(Threads) for Threads in ARGS.threads.split(',')]
+    Options = ['--f86'] if ARGS.f86 else []
+
+    TempDir = tempfile.mkdtemp()
+    Status = 0
+    try:
+        for FvFile in FvFiles:
+            print ("%s (%d bytes)" % (FvFile, os.path.getsize(FvFile)))
+            Reference = None
+            for Threads in ThreadList:
+                OutputFile = os.path.join(TempDir, 'Output%d' % Threads)
+                Elapsed = min(Compress(ARGS.tool, FvFile, OutputFile, Threads, Options) for Index in range(ARGS.repeat))
+                if Reference is None:
+                    Reference = OutputFile
+                    Same = 'reference'
+                elif filecmp.cmp(Reference, OutputFile, shallow=False):
+                    Same = 'identical'
+                else:
+                    Same = 'DIFFERENT'
+                    Status = 1
+                print ("  threads %d: %8.2f s  %d bytes  %s" % (Threads, Elapsed, os.path.getsize(OutputFile), Same))
+    finally:
+        for File in os.listdir(TempDir):
+            os.remove(os.path.join(TempDir, File))
+        os.rmdir(TempDir)
+    return Status
+
+if __name__ == '__main__':
+    sys.exit(Main())
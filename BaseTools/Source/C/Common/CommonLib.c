@@ -12,12 +12,29 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <ctype.h>
 #ifdef __GNUC__
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #else
+#include <windows.h>
+#include <io.h>
 #include <direct.h>
 #endif
 #include "CommonLib.h"
 #include "EfiUtilityMsgs.h"
 
+//
+// Files mapped by MapFileImage.  UnmapFileImage uses this table to tell them
+// apart from the buffers of the read fallback.
+//
+#define MAX_MAPPED_FILE_IMAGES  64
+
+typedef struct {
+  CHAR8   *FileImage;
+  UINT32  FileSize;
+} MAPPED_FILE_IMAGE;
+
+STATIC MAPPED_FILE_IMAGE  mMappedFileImages[MAX_MAPPED_FILE_IMAGES];
+
 #define SAFE_STRING_CONSTRAINT_CHECK(Expression, Status)  \
   do { \
     ASSERT (Expression); \
@@ -255,6 +272,145 @@ Returns:
   return EFI_SUCCESS;
 }
 
+EFI_STATUS
+MapFileImage (
+  IN CHAR8    *InputFileName,
+  OUT CHAR8   **InputFileImage,
+  OUT UINT32  *FileSize
+  )
+/*++
+
+Routine Description:
+
+  This function maps a file into memory instead of reading it into a buffer.
+  The mapping is copy-on-write, so the caller may change the memory without
+  changing the file.  Files that cannot be mapped, such as empty files, are
+  read with GetFileImage.  Either way the memory must be released with
+  UnmapFileImage.
+
+Arguments:
+
+  InputFileName     The name of the file to map.
+  InputFileImage    A pointer to the mapped file.
+  FileSize          The size of the file.
+
+Returns:
+
+  EFI_SUCCESS              The function completed successfully.
+  EFI_INVALID_PARAMETER    One of the input parameters was invalid.
+  EFI_ABORTED              An error occurred.
+  EFI_OUT_OF_RESOURCES     No resource to complete operations.
+
+--*/
+{
+  FILE    *InputFile;
+  UINT32  Index;
+  UINT32  Size;
+  CHAR8   *Image;
+#ifdef __GNUC__
+  struct stat  Stat;
+#else
+  HANDLE  Mapping;
+#endif
+
+  if (InputFileName == NULL || strlen (InputFileName) == 0 || InputFileImage == NULL || FileSize == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  for (Index = 0; Index < MAX_MAPPED_FILE_IMAGES; Index++) {
+    if (mMappedFileImages[Index].FileImage == NULL) {
+      break;
+    }
+  }
+  if (Index == MAX_MAPPED_FILE_IMAGES) {
+    return GetFileImage (InputFileName, InputFileImage, FileSize);
+  }
+
+  InputFile = fopen (LongFilePath (InputFileName), "rb");
+  if (InputFile == NULL) {
+    Error (NULL, 0, 0001, "Error opening the input file", InputFileName);
+    return EFI_ABORTED;
+  }
+
+  Image = NULL;
+#ifdef __GNUC__
+  Size = 0;
+  if (fstat (fileno (InputFile), &Stat) == 0 && Stat.st_size > 0 && Stat.st_size <= MAX_UINT32) {
+    Size  = (UINT32) Stat.st_size;
+    Image = mmap (NULL, Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno (InputFile), 0);
+    if (Image == MAP_FAILED) {
+      Image = NULL;
+    }
+  }
+#else
+  Size = (UINT32) _filelength (fileno (InputFile));
+  if (Size > 0) {
+    Mapping = CreateFileMapping ((HANDLE) _get_osfhandle (fileno (InputFile)), NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (Mapping != NULL) {
+      Image = MapViewOfFile (Mapping, FILE_MAP_COPY, 0, 0, 0);
+      CloseHandle (Mapping);
+    }
+  }
+#endif
+  fclose (InputFile);
+
+  if (Image == NULL) {
+    return GetFileImage (InputFileName, InputFileImage, FileSize);
+  }
+
+  mMappedFileImages[Index].FileImage = Image;
+  mMappedFileImages[Index].FileSize  = Size;
+  *InputFileImage = Image;
+  *FileSize       = Size;
+
+  return EFI_SUCCESS;
+}
+
+VOID
+UnmapFileImage (
+  IN CHAR8    *InputFileImage
+  )
+/*++
+
+Routine Description:
+
+  This function releases a file image returned by MapFileImage.
+
+Arguments:
+
+  InputFileImage    The file image to release.
+
+Returns:
+
+  None
+
+--*/
+{
+  UINT32  Index;
+
+  if (InputFileImage == NULL) {
+    return;
+  }
+
+  for (Index = 0; Index < MAX_MAPPED_FILE_IMAGES; Index++) {
+    if (mMappedFileImages[Index].FileImage == InputFileImage) {
+#ifdef __GNUC__
+      munmap (InputFileImage, mMappedFileImages[Index].FileSize);
+#else
+      UnmapViewOfFile (InputFileImage);
+#endif
+      mMappedFileImages[Index].FileImage = NULL;
+      mMappedFileImages[Index].FileSize  = 0;
+      return;
+    }
+  }
+
+  //
+  // Not mapped, so it was read by GetFileImage.
+  //
+  free (InputFileImage);
+}
+
 EFI_STATUS
 PutFileImage (
   IN CHAR8    *OutputFileName,
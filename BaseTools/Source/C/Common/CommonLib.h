@@ -95,6 +95,20 @@ GetFileImage (
   )
 ;
 
+EFI_STATUS
+MapFileImage (
+  IN CHAR8    *InputFileName,
+  OUT CHAR8   **InputFileImage,
+  OUT UINT32  *FileSize
+  )
+;
+
+VOID
+UnmapFileImage (
+  IN CHAR8    *InputFileImage
+  )
+;
+
 EFI_STATUS
 PutFileImage (
   IN CHAR8    *OutputFileName,
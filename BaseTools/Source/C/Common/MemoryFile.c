@@ -56,14 +56,14 @@ Returns:
   UINT32      BytesRead;
   MEMORY_FILE *NewMemoryFile;
 
-  Status = GetFileImage (InputFileName, &InputFileImage, &BytesRead);
+  Status = MapFileImage (InputFileName, &InputFileImage, &BytesRead);
   if (EFI_ERROR (Status)) {
     return Status;
   }
 
   NewMemoryFile = malloc (sizeof (*NewMemoryFile));
   if (NewMemoryFile == NULL) {
-    free (InputFileImage);
+    UnmapFileImage (InputFileImage);
     return EFI_OUT_OF_RESOURCES;
   }
 
@@ -105,7 +105,7 @@ Returns:
 
   MemoryFile = (MEMORY_FILE*)InputMemoryFile;
 
-  free (MemoryFile->FileImage);
+  UnmapFileImage (MemoryFile->FileImage);
 
   //
   // Invalidate state of MEMORY_FILE structure to catch invalid usage.
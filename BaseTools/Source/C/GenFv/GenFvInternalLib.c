@@ -33,6 +33,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "GenFvInternalLib.h"
 #include "FvLib.h"
 #include "PeCoffLib.h"
+#include "Crc32.h"
 
 #define ARM64_UNCONDITIONAL_JUMP_INSTRUCTION      0x14000000
 
@@ -184,6 +185,19 @@ BOOLEAN                     mIsLargeFfs = FALSE;
 EFI_PHYSICAL_ADDRESS mFvBaseAddress[0x10];
 UINT32               mFvBaseAddressNumber = 0;
 
+//
+// Rebased FFS files of the previous build of this FV and of the current one.
+//
+STATIC BOOLEAN                mRebaseCacheEnabled = FALSE;
+STATIC UINT8                  *mPrevFvImage = NULL;
+STATIC UINT8                  *mPrevFvInput = NULL;
+STATIC UINT8                  *mFvInput = NULL;
+STATIC UINTN                  mFvInputSize = 0;
+STATIC FV_REBASE_CACHE_ENTRY  mPrevRebaseCache[MAX_NUMBER_OF_FILES_IN_FV];
+STATIC UINT32                 mPrevRebaseCacheNumber = 0;
+STATIC FV_REBASE_CACHE_ENTRY  mRebaseCache[MAX_NUMBER_OF_FILES_IN_FV];
+STATIC UINT32                 mRebaseCacheNumber = 0;
+
 EFI_STATUS
 ParseFvInf (
   IN  MEMORY_FILE  *InfFile,
@@ -1034,6 +1048,317 @@ Returns:
   return EFI_SUCCESS;
 }
 
+STATIC
+VOID
+LoadRebaseCache (
+  IN CHAR8    *CacheFileName,
+  IN CHAR8    *InputFileName,
+  IN CHAR8    *FvFileName,
+  IN FV_INFO  *FvInfo
+  )
+/*++
+
+Routine Description:
+
+  This function loads the rebase cache and the image left by the previous
+  build of the FV, together with the FFS files as they were before being
+  rebased.  They are only used if the FV base address, size and attributes
+  are unchanged and the image still matches its recorded CRC.  The cache
+  files are removed afterwards, so a failed build cannot leave a cache
+  behind that no longer describes the FV file.
+
+Arguments:
+
+  CacheFileName   Rebase cache file of the FV.
+  InputFileName   File holding the FFS files of the previous build before
+                  they were rebased, at their offset in the FV.
+  FvFileName      The FV file of the previous build.
+  FvInfo          Pointer to information about the FV.
+
+Returns:
+
+  None
+
+--*/
+{
+  FILE                *CacheFile;
+  FILE                *PrevFvFile;
+  FILE                *PrevInputFile;
+  UINT8               *PrevFvImage;
+  UINT8               *PrevFvInput;
+  UINT32              Crc32;
+  unsigned long long  BaseAddress;
+  unsigned            Size;
+  unsigned            Attributes;
+  int                 ForceRebase;
+  unsigned            FvCrc32;
+  unsigned            Offset;
+  unsigned            Length;
+  unsigned            FileCrc32;
+
+  mPrevRebaseCacheNumber = 0;
+
+  CacheFile = fopen (LongFilePath (CacheFileName), "r");
+  if (CacheFile == NULL) {
+    return;
+  }
+
+  if (fscanf (CacheFile, "%llx %x %x %d %x", &BaseAddress, &Size, &Attributes, &ForceRebase, &FvCrc32) != 5 ||
+      BaseAddress != FvInfo->BaseAddress ||
+      Size != FvInfo->Size ||
+      Attributes != FvInfo->FvAttributes ||
+      ForceRebase != FvInfo->ForceRebase) {
+    goto Done;
+  }
+
+  //
+  // Read the previous FV image, which is overwritten by this build.
+  //
+  PrevFvFile = fopen (LongFilePath (FvFileName), "rb");
+  if (PrevFvFile == NULL) {
+    goto Done;
+  }
+  PrevFvImage = NULL;
+  if ((UINTN) _filelength (fileno (PrevFvFile)) == Size) {
+    PrevFvImage = malloc (Size);
+    if (PrevFvImage != NULL && fread (PrevFvImage, 1, Size, PrevFvFile) != Size) {
+      free (PrevFvImage);
+      PrevFvImage = NULL;
+    }
+  }
+  fclose (PrevFvFile);
+  if (PrevFvImage == NULL) {
+    goto Done;
+  }
+
+  Crc32 = 0;
+  CalculateCrc32 (PrevFvImage, Size, &Crc32);
+  if (Crc32 != FvCrc32) {
+    free (PrevFvImage);
+    goto Done;
+  }
+
+  //
+  // Read the FFS files of the previous build before they were rebased.
+  //
+  PrevFvInput   = NULL;
+  PrevInputFile = fopen (LongFilePath (InputFileName), "rb");
+  if (PrevInputFile != NULL) {
+    if ((UINTN) _filelength (fileno (PrevInputFile)) == Size) {
+      PrevFvInput = malloc (Size);
+      if (PrevFvInput != NULL && fread (PrevFvInput, 1, Size, PrevInputFile) != Size) {
+        free (PrevFvInput);
+        PrevFvInput = NULL;
+      }
+    }
+    fclose (PrevInputFile);
+  }
+  if (PrevFvInput == NULL) {
+    free (PrevFvImage);
+    goto Done;
+  }
+
+  while (mPrevRebaseCacheNumber < MAX_NUMBER_OF_FILES_IN_FV &&
+         fscanf (CacheFile, "%x %x %x", &Offset, &Length, &FileCrc32) == 3) {
+    if (Offset > Size || Length > Size - Offset) {
+      break;
+    }
+    mPrevRebaseCache[mPrevRebaseCacheNumber].Offset = Offset;
+    mPrevRebaseCache[mPrevRebaseCacheNumber].Length = Length;
+    mPrevRebaseCache[mPrevRebaseCacheNumber].Crc32  = FileCrc32;
+    mPrevRebaseCacheNumber++;
+  }
+  mPrevFvImage = PrevFvImage;
+  mPrevFvInput = PrevFvInput;
+  DebugMsg (NULL, 0, 9, "Rebase cache", "%u rebased files of the previous build can be reused", (unsigned) mPrevRebaseCacheNumber);
+
+Done:
+  fclose (CacheFile);
+  remove (LongFilePath (CacheFileName));
+  remove (LongFilePath (InputFileName));
+}
+
+STATIC
+VOID
+SaveRebaseCache (
+  IN CHAR8    *CacheFileName,
+  IN CHAR8    *InputFileName,
+  IN FV_INFO  *FvInfo,
+  IN UINT8    *FvImage,
+  IN UINTN    FvImageSize
+  )
+/*++
+
+Routine Description:
+
+  This function writes the rebase cache for the next build of the FV, and the
+  rebased FFS files as they were before being rebased.  It must only be
+  called after the FV file has been written successfully.
+
+Arguments:
+
+  CacheFileName   Rebase cache file of the FV.
+  InputFileName   File receiving the FFS files before they were rebased.
+  FvInfo          Pointer to information about the FV.
+  FvImage         The FV image as written to the FV file.
+  FvImageSize     Size of the FV image.
+
+Returns:
+
+  None
+
+--*/
+{
+  FILE    *CacheFile;
+  FILE    *InputFile;
+  UINT32  Crc32;
+  UINT32  Index;
+
+  if (!mRebaseCacheEnabled || mRebaseCacheNumber == 0 || mFvInputSize != FvImageSize) {
+    return;
+  }
+
+  //
+  // The input file is written first: the cache is not used without it.
+  //
+  InputFile = fopen (LongFilePath (InputFileName), "wb");
+  if (InputFile == NULL) {
+    VerboseMsg ("the rebase cache %s cannot be written", InputFileName);
+    return;
+  }
+  if (fwrite (mFvInput, 1, mFvInputSize, InputFile) != mFvInputSize) {
+    VerboseMsg ("the rebase cache %s cannot be written", InputFileName);
+    fclose (InputFile);
+    remove (LongFilePath (InputFileName));
+    return;
+  }
+  fclose (InputFile);
+
+  CacheFile = fopen (LongFilePath (CacheFileName), "w");
+  if (CacheFile == NULL) {
+    VerboseMsg ("the rebase cache %s cannot be written", CacheFileName);
+    return;
+  }
+
+  Crc32 = 0;
+  CalculateCrc32 (FvImage, FvImageSize, &Crc32);
+  fprintf (
+    CacheFile,
+    "%llx %x %x %d %x\n",
+    (unsigned long long) FvInfo->BaseAddress,
+    (unsigned) FvImageSize,
+    (unsigned) FvInfo->FvAttributes,
+    (int) FvInfo->ForceRebase,
+    (unsigned) Crc32
+    );
+  for (Index = 0; Index < mRebaseCacheNumber; Index++) {
+    fprintf (
+      CacheFile,
+      "%x %x %x\n",
+      (unsigned) mRebaseCache[Index].Offset,
+      (unsigned) mRebaseCache[Index].Length,
+      (unsigned) mRebaseCache[Index].Crc32
+      );
+  }
+  fclose (CacheFile);
+}
+
+STATIC
+EFI_STATUS
+FfsRebaseCached (
+  IN OUT  FV_INFO               *FvInfo,
+  IN      CHAR8                 *FileName,
+  IN OUT  EFI_FFS_FILE_HEADER   *FfsFile,
+  IN      UINTN                 FileSize,
+  IN      UINTN                 XipOffset,
+  IN      FILE                  *FvMapFile
+  )
+/*++
+
+Routine Description:
+
+  This function rebases an FFS file like FfsRebase.  If the previous build of
+  the FV placed the same file at the same offset, the rebased file is copied
+  from the previous FV image instead of relocating its images again.  The
+  file is only considered the same if its content is identical to the input
+  recorded by the previous build; the CRC32 merely rejects most other files
+  quickly.
+
+Arguments:
+
+  FvInfo            A pointer to FV_INFO structure.
+  FileName          Ffs File PathName
+  FfsFile           A pointer to Ffs file image.
+  FileSize          Size of the Ffs file image.
+  XipOffset         The offset address to use for rebasing the XIP file image.
+  FvMapFile         FvMapFile to record the function address in one Fvimage
+
+Returns:
+
+  EFI_SUCCESS       The image was properly rebased.
+  Others            Error status returned by FfsRebase.
+
+--*/
+{
+  EFI_STATUS  Status;
+  UINT32      Crc32;
+  UINT32      Index;
+  UINT8       *RebasedFile;
+
+  if (!mRebaseCacheEnabled || mRebaseCacheNumber >= MAX_NUMBER_OF_FILES_IN_FV ||
+      XipOffset > mFvInputSize || FileSize > mFvInputSize - XipOffset) {
+    return FfsRebase (FvInfo, FileName, FfsFile, XipOffset, FvMapFile, TRUE);
+  }
+
+  //
+  // Only the file types rebased by FfsRebase are cached.
+  //
+  switch (FfsFile->Type) {
+    case EFI_FV_FILETYPE_SECURITY_CORE:
+    case EFI_FV_FILETYPE_PEI_CORE:
+    case EFI_FV_FILETYPE_PEIM:
+    case EFI_FV_FILETYPE_COMBINED_PEIM_DRIVER:
+    case EFI_FV_FILETYPE_DRIVER:
+    case EFI_FV_FILETYPE_DXE_CORE:
+    case EFI_FV_FILETYPE_FIRMWARE_VOLUME_IMAGE:
+      break;
+    default:
+      return FfsRebase (FvInfo, FileName, FfsFile, XipOffset, FvMapFile, TRUE);
+  }
+
+  Crc32 = 0;
+  CalculateCrc32 ((UINT8 *) FfsFile, FileSize, &Crc32);
+  memcpy (mFvInput + XipOffset, FfsFile, FileSize);
+
+  RebasedFile = NULL;
+  for (Index = 0; Index < mPrevRebaseCacheNumber; Index++) {
+    if (mPrevRebaseCache[Index].Offset == XipOffset &&
+        mPrevRebaseCache[Index].Length == FileSize &&
+        mPrevRebaseCache[Index].Crc32 == Crc32 &&
+        memcmp (mPrevFvInput + XipOffset, FfsFile, FileSize) == 0) {
+      RebasedFile = mPrevFvImage + XipOffset;
+      break;
+    }
+  }
+
+  Status = FfsRebase (FvInfo, FileName, FfsFile, XipOffset, FvMapFile, (BOOLEAN) (RebasedFile == NULL));
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  if (RebasedFile != NULL) {
+    DebugMsg (NULL, 0, 9, "Reuse rebased file", "%s at offset 0x%x", FileName, (unsigned) XipOffset);
+    memcpy (FfsFile, RebasedFile, FileSize);
+  }
+
+  mRebaseCache[mRebaseCacheNumber].Offset = (UINT32) XipOffset;
+  mRebaseCache[mRebaseCacheNumber].Length = (UINT32) FileSize;
+  mRebaseCache[mRebaseCacheNumber].Crc32  = Crc32;
+  mRebaseCacheNumber++;
+
+  return EFI_SUCCESS;
+}
+
 STATIC
 BOOLEAN
 AdjustInternalFfsPadding (
@@ -1217,10 +1542,9 @@ Returns:
 
 --*/
 {
-  FILE                  *NewFile;
   UINTN                 FileSize;
+  UINT32                FileImageSize;
   UINT8                 *FileBuffer;
-  UINTN                 NumBytesRead;
   UINT32                CurrentFileAlignment;
   EFI_STATUS            Status;
   UINTN                 Index1;
@@ -1235,45 +1559,15 @@ Returns:
   }
 
   //
-  // Read the file to add
-  //
-  NewFile = fopen (LongFilePath (FvInfo->FvFiles[Index]), "rb");
-
-  if (NewFile == NULL) {
-    Error (NULL, 0, 0001, "Error opening file", FvInfo->FvFiles[Index]);
-    return EFI_ABORTED;
-  }
-
-  //
-  // Get the file size
-  //
-  FileSize = _filelength (fileno (NewFile));
-
-  //
-  // Read the file into a buffer
-  //
-  FileBuffer = malloc (FileSize);
-  if (FileBuffer == NULL) {
-    fclose (NewFile);
-    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
-    return EFI_OUT_OF_RESOURCES;
-  }
-
-  NumBytesRead = fread (FileBuffer, sizeof (UINT8), FileSize, NewFile);
-
-  //
-  // Done with the file, from this point on we will just use the buffer read.
-  //
-  fclose (NewFile);
-
-  //
-  // Verify read successful
+  // Map the file to add.  The mapping is copy-on-write, so the file state,
+  // padding and rebase updates below do not change the input file.
   //
-  if (NumBytesRead != sizeof (UINT8) * FileSize) {
-    free  (FileBuffer);
+  Status = MapFileImage (FvInfo->FvFiles[Index], (CHAR8 **) &FileBuffer, &FileImageSize);
+  if (EFI_ERROR (Status)) {
     Error (NULL, 0, 0004, "Error reading file", FvInfo->FvFiles[Index]);
-    return EFI_ABORTED;
+    return Status;
   }
+  FileSize = FileImageSize;
 
   //
   // For None PI Ffs file, directly add them into FvImage.
@@ -1293,7 +1587,7 @@ Returns:
   //
   Status = VerifyFfsFile ((EFI_FFS_FILE_HEADER *)FileBuffer);
   if (EFI_ERROR (Status)) {
-    free (FileBuffer);
+    UnmapFileImage ((CHAR8 *) FileBuffer);
     Error (NULL, 0, 3000, "Invalid", "%s is not a valid FFS file.", FvInfo->FvFiles[Index]);
     return EFI_INVALID_PARAMETER;
   }
@@ -1302,7 +1596,7 @@ Returns:
   // Verify space exists to add the file
   //
   if (FileSize > (UINTN) ((UINTN) *VtfFileImage - (UINTN) FvImage->CurrentFilePointer)) {
-    free (FileBuffer);
+    UnmapFileImage ((CHAR8 *) FileBuffer);
     Error (NULL, 0, 4002, "Resource", "FV space is full, not enough room to add file %s.", FvInfo->FvFiles[Index]);
     return EFI_OUT_OF_RESOURCES;
   }
@@ -1314,7 +1608,7 @@ Returns:
     if (CompareGuid ((EFI_GUID *) FileBuffer, &mFileGuidArray [Index1]) == 0) {
       Error (NULL, 0, 2000, "Invalid parameter", "the %dth file and %uth file have the same file GUID.", (unsigned) Index1 + 1, (unsigned) Index + 1);
       PrintGuid ((EFI_GUID *) FileBuffer);
-      free (FileBuffer);
+      UnmapFileImage ((CHAR8 *) FileBuffer);
       return EFI_INVALID_PARAMETER;
     }
   }
@@ -1353,14 +1647,14 @@ Returns:
       //
       if (((UINTN) *VtfFileImage + GetFfsHeaderLength((EFI_FFS_FILE_HEADER *)FileBuffer) - (UINTN) FvImage->FileImage) % (1 << CurrentFileAlignment)) {
         Error (NULL, 0, 3000, "Invalid", "VTF file cannot be aligned on a %u-byte boundary.", (unsigned) (1 << CurrentFileAlignment));
-        free (FileBuffer);
+        UnmapFileImage ((CHAR8 *) FileBuffer);
         return EFI_ABORTED;
       }
       //
       // Rebase the PE or TE image in FileBuffer of FFS file for XIP
       // Rebase for the debug genfvmap tool
       //
-      Status = FfsRebase (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, (UINTN) *VtfFileImage - (UINTN) FvImage->FileImage, FvMapFile);
+      Status = FfsRebase (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, (UINTN) *VtfFileImage - (UINTN) FvImage->FileImage, FvMapFile, TRUE);
       if (EFI_ERROR (Status)) {
         Error (NULL, 0, 3000, "Invalid", "Could not rebase %s.", FvInfo->FvFiles[Index]);
         return Status;
@@ -1373,7 +1667,7 @@ Returns:
       PrintGuidToBuffer ((EFI_GUID *) FileBuffer, FileGuidString, sizeof (FileGuidString), TRUE);
       fprintf (FvReportFile, "0x%08X %s\n", (unsigned)(UINTN) (((UINT8 *)*VtfFileImage) - (UINTN)FvImage->FileImage), FileGuidString);
 
-      free (FileBuffer);
+      UnmapFileImage ((CHAR8 *) FileBuffer);
       DebugMsg (NULL, 0, 9, "Add VTF FFS file in FV image", NULL);
       return EFI_SUCCESS;
     } else {
@@ -1381,7 +1675,7 @@ Returns:
       // Already found a VTF file.
       //
       Error (NULL, 0, 3000, "Invalid", "multiple VTF files are not permitted within a single FV.");
-      free (FileBuffer);
+      UnmapFileImage ((CHAR8 *) FileBuffer);
       return EFI_ABORTED;
     }
   }
@@ -1394,7 +1688,7 @@ Returns:
     Status = AddPadFile (FvImage, 1 << CurrentFileAlignment, *VtfFileImage, NULL, FileSize);
     if (EFI_ERROR (Status)) {
       Error (NULL, 0, 4002, "Resource", "FV space is full, could not add pad file for data alignment property.");
-      free (FileBuffer);
+      UnmapFileImage ((CHAR8 *) FileBuffer);
       return EFI_ABORTED;
     }
   }
@@ -1406,7 +1700,7 @@ Returns:
     // Rebase the PE or TE image in FileBuffer of FFS file for XIP.
     // Rebase Bs and Rt drivers for the debug genfvmap tool.
     //
-    Status = FfsRebase (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, (UINTN) FvImage->CurrentFilePointer - (UINTN) FvImage->FileImage, FvMapFile);
+    Status = FfsRebaseCached (FvInfo, FvInfo->FvFiles[Index], (EFI_FFS_FILE_HEADER *) FileBuffer, FileSize, (UINTN) FvImage->CurrentFilePointer - (UINTN) FvImage->FileImage, FvMapFile);
   if (EFI_ERROR (Status)) {
     Error (NULL, 0, 3000, "Invalid", "Could not rebase %s.", FvInfo->FvFiles[Index]);
     return Status;
@@ -1420,7 +1714,7 @@ Returns:
     FvImage->CurrentFilePointer += FileSize;
   } else {
     Error (NULL, 0, 4002, "Resource", "FV space is full, cannot add file %s.", FvInfo->FvFiles[Index]);
-    free (FileBuffer);
+    UnmapFileImage ((CHAR8 *) FileBuffer);
     return EFI_ABORTED;
   }
   //
@@ -1434,7 +1728,7 @@ Done:
   //
   // Free allocated memory.
   //
-  free (FileBuffer);
+  UnmapFileImage ((CHAR8 *) FileBuffer);
 
   return EFI_SUCCESS;
 }
@@ -2563,6 +2857,8 @@ Returns:
   UINTN                           FileSize;
   CHAR8                           *FvReportName;
   FILE                            *FvReportFile;
+  CHAR8                           *FvCacheName;
+  CHAR8                           *FvCacheInputName;
 
   FvBufferHeader = NULL;
   FvFile         = NULL;
@@ -2570,6 +2866,8 @@ Returns:
   FvMapFile      = NULL;
   FvReportName   = NULL;
   FvReportFile   = NULL;
+  FvCacheName    = NULL;
+  FvCacheInputName = NULL;
 
   if (InfFileImage != NULL) {
     //
@@ -2758,6 +3056,35 @@ Returns:
   strcpy (FvReportName, FvFileName);
   strcat (FvReportName, ".txt");
 
+  //
+  // FvCache file to record the rebased files for the next build of this FV
+  //
+  if (strlen (FvFileName) + strlen (".cache.input") > MAX_LONG_FILE_PATH - 1) {
+    Error (NULL, 0, 1003, "Invalid option value", "FvFileName %s is too long!", FvFileName);
+    Status = EFI_ABORTED;
+    goto Finish;
+  }
+
+  FvCacheName = malloc (strlen (FvFileName) + strlen (".cache") + 1);
+  if (FvCacheName == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Finish;
+  }
+
+  strcpy (FvCacheName, FvFileName);
+  strcat (FvCacheName, ".cache");
+
+  FvCacheInputName = malloc (strlen (FvFileName) + strlen (".cache.input") + 1);
+  if (FvCacheInputName == NULL) {
+    Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    Status = EFI_OUT_OF_RESOURCES;
+    goto Finish;
+  }
+
+  strcpy (FvCacheInputName, FvFileName);
+  strcat (FvCacheInputName, ".cache.input");
+
   //
   // Calculate the FV size and Update Fv Size based on the actual FFS files.
   // And Update mFvDataInfo data.
@@ -2792,6 +3119,22 @@ Returns:
     //
     mFvDataInfo.FvAttributes = FV_DEFAULT_ATTRIBUTE;
   }
+
+  //
+  // Files rebased by the previous build of this FV are reused if they are
+  // placed at the same offset again.
+  //
+  mRebaseCacheEnabled = (BOOLEAN) (mFvDataInfo.IsPiFvImage &&
+                                   (mFvDataInfo.ForceRebase == 1 ||
+                                    (mFvDataInfo.ForceRebase == -1 && mFvDataInfo.BaseAddress != 0)));
+  if (mRebaseCacheEnabled) {
+    mFvInput = calloc (1, FvImageSize);
+    if (mFvInput != NULL) {
+      mFvInputSize = FvImageSize;
+    }
+  }
+  LoadRebaseCache (FvCacheName, FvCacheInputName, FvFileName, &mFvDataInfo);
+
   if (mFvDataInfo.FvAttributes & EFI_FVB2_ERASE_POLARITY) {
     memset (FvImage, -1, FvImageSize);
   } else {
@@ -3043,6 +3386,8 @@ WriteFile:
     goto Finish;
   }
 
+  SaveRebaseCache (FvCacheName, FvCacheInputName, &mFvDataInfo, FvImage, FvImageSize);
+
 Finish:
   if (FvBufferHeader != NULL) {
     free (FvBufferHeader);
@@ -3060,6 +3405,30 @@ Finish:
     free (FvReportName);
   }
 
+  if (FvCacheName != NULL) {
+    free (FvCacheName);
+  }
+
+  if (FvCacheInputName != NULL) {
+    free (FvCacheInputName);
+  }
+
+  if (mPrevFvImage != NULL) {
+    free (mPrevFvImage);
+    mPrevFvImage = NULL;
+  }
+
+  if (mPrevFvInput != NULL) {
+    free (mPrevFvInput);
+    mPrevFvInput = NULL;
+  }
+
+  if (mFvInput != NULL) {
+    free (mFvInput);
+    mFvInput     = NULL;
+    mFvInputSize = 0;
+  }
+
   if (FvFile != NULL) {
     fflush (FvFile);
     fclose (FvFile);
@@ -3468,7 +3837,8 @@ FfsRebase (
   IN      CHAR8                 *FileName,
   IN OUT  EFI_FFS_FILE_HEADER   *FfsFile,
   IN      UINTN                 XipOffset,
-  IN      FILE                  *FvMapFile
+  IN      FILE                  *FvMapFile,
+  IN      BOOLEAN               Relocate
   )
 /*++
 
@@ -3484,6 +3854,8 @@ Arguments:
   FfsFile           A pointer to Ffs file image.
   XipOffset         The offset address to use for rebasing the XIP file image.
   FvMapFile         FvMapFile to record the function address in one Fvimage
+  Relocate          FALSE if the caller copies in the file already rebased to
+                    XipOffset, then only the map file and child FVs are updated.
 
 Returns:
 
@@ -3738,88 +4110,94 @@ Returns:
     }
 
     //
-    // Relocation exist and rebase
+    // The caller holds this file rebased to the same address by a previous
+    // build when Relocate is FALSE, so only the map file is written.
     //
-    //
-    // Load and Relocate Image Data
-    //
-    MemoryImagePointer = (UINT8 *) malloc ((UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
-    if (MemoryImagePointer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated on rebase of %s", FileName);
-      return EFI_OUT_OF_RESOURCES;
-    }
-    memset ((VOID *) MemoryImagePointer, 0, (UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
-    ImageContext.ImageAddress = ((UINTN) MemoryImagePointer + ImageContext.SectionAlignment - 1) & (~((UINTN) ImageContext.SectionAlignment - 1));
+    if (Relocate) {
+      //
+      // Relocation exist and rebase
+      //
+      //
+      // Load and Relocate Image Data
+      //
+      MemoryImagePointer = (UINT8 *) malloc ((UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
+      if (MemoryImagePointer == NULL) {
+        Error (NULL, 0, 4001, "Resource", "memory cannot be allocated on rebase of %s", FileName);
+        return EFI_OUT_OF_RESOURCES;
+      }
+      memset ((VOID *) MemoryImagePointer, 0, (UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
+      ImageContext.ImageAddress = ((UINTN) MemoryImagePointer + ImageContext.SectionAlignment - 1) & (~((UINTN) ImageContext.SectionAlignment - 1));
 
-    Status =  PeCoffLoaderLoadImage (&ImageContext);
-    if (EFI_ERROR (Status)) {
-      Error (NULL, 0, 3000, "Invalid", "LocateImage() call failed on rebase of %s", FileName);
-      free ((VOID *) MemoryImagePointer);
-      return Status;
-    }
+      Status =  PeCoffLoaderLoadImage (&ImageContext);
+      if (EFI_ERROR (Status)) {
+        Error (NULL, 0, 3000, "Invalid", "LocateImage() call failed on rebase of %s", FileName);
+        free ((VOID *) MemoryImagePointer);
+        return Status;
+      }
+
+      ImageContext.DestinationAddress = NewPe32BaseAddress;
+      Status                          = PeCoffLoaderRelocateImage (&ImageContext);
+      if (EFI_ERROR (Status)) {
+        Error (NULL, 0, 3000, "Invalid", "RelocateImage() call failed on rebase of %s Status=%d", FileName, Status);
+        free ((VOID *) MemoryImagePointer);
+        return Status;
+      }
+
+      //
+      // Copy Relocated data to raw image file.
+      //
+      SectionHeader = (EFI_IMAGE_SECTION_HEADER *) (
+                         (UINTN) ImgHdr +
+                         sizeof (UINT32) +
+                         sizeof (EFI_IMAGE_FILE_HEADER) +
+                         ImgHdr->Pe32.FileHeader.SizeOfOptionalHeader
+                         );
+
+      for (Index = 0; Index < ImgHdr->Pe32.FileHeader.NumberOfSections; Index ++, SectionHeader ++) {
+        CopyMem (
+          (UINT8 *) CurrentPe32Section.Pe32Section + CurSecHdrSize + SectionHeader->PointerToRawData,
+          (VOID*) (UINTN) (ImageContext.ImageAddress + SectionHeader->VirtualAddress),
+          SectionHeader->SizeOfRawData
+          );
+      }
 
-    ImageContext.DestinationAddress = NewPe32BaseAddress;
-    Status                          = PeCoffLoaderRelocateImage (&ImageContext);
-    if (EFI_ERROR (Status)) {
-      Error (NULL, 0, 3000, "Invalid", "RelocateImage() call failed on rebase of %s Status=%d", FileName, Status);
       free ((VOID *) MemoryImagePointer);
-      return Status;
-    }
+      MemoryImagePointer = NULL;
 
-    //
-    // Copy Relocated data to raw image file.
-    //
-    SectionHeader = (EFI_IMAGE_SECTION_HEADER *) (
-                       (UINTN) ImgHdr +
-                       sizeof (UINT32) +
-                       sizeof (EFI_IMAGE_FILE_HEADER) +
-                       ImgHdr->Pe32.FileHeader.SizeOfOptionalHeader
-                       );
+      //
+      // Update Image Base Address
+      //
+      if (ImgHdr->Pe32.OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
+        ImgHdr->Pe32.OptionalHeader.ImageBase = (UINT32) NewPe32BaseAddress;
+      } else if (ImgHdr->Pe32Plus.OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+        ImgHdr->Pe32Plus.OptionalHeader.ImageBase = NewPe32BaseAddress;
+      } else {
+        Error (NULL, 0, 3000, "Invalid", "unknown PE magic signature %X in PE32 image %s",
+          ImgHdr->Pe32.OptionalHeader.Magic,
+          FileName
+          );
+        return EFI_ABORTED;
+      }
 
-    for (Index = 0; Index < ImgHdr->Pe32.FileHeader.NumberOfSections; Index ++, SectionHeader ++) {
-      CopyMem (
-        (UINT8 *) CurrentPe32Section.Pe32Section + CurSecHdrSize + SectionHeader->PointerToRawData,
-        (VOID*) (UINTN) (ImageContext.ImageAddress + SectionHeader->VirtualAddress),
-        SectionHeader->SizeOfRawData
-        );
+      //
+      // Now update file checksum
+      //
+      if (FfsFile->Attributes & FFS_ATTRIB_CHECKSUM) {
+        SavedState  = FfsFile->State;
+        FfsFile->IntegrityCheck.Checksum.File = 0;
+        FfsFile->State                        = 0;
+        FfsFile->IntegrityCheck.Checksum.File = CalculateChecksum8 (
+                                                  (UINT8 *) ((UINT8 *)FfsFile + FfsHeaderSize),
+                                                  GetFfsFileLength (FfsFile) - FfsHeaderSize
+                                                  );
+        FfsFile->State = SavedState;
+      }
     }
-
-    free ((VOID *) MemoryImagePointer);
-    MemoryImagePointer = NULL;
     if (PeFileBuffer != NULL) {
       free (PeFileBuffer);
       PeFileBuffer = NULL;
     }
 
-    //
-    // Update Image Base Address
-    //
-    if (ImgHdr->Pe32.OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
-      ImgHdr->Pe32.OptionalHeader.ImageBase = (UINT32) NewPe32BaseAddress;
-    } else if (ImgHdr->Pe32Plus.OptionalHeader.Magic == EFI_IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
-      ImgHdr->Pe32Plus.OptionalHeader.ImageBase = NewPe32BaseAddress;
-    } else {
-      Error (NULL, 0, 3000, "Invalid", "unknown PE magic signature %X in PE32 image %s",
-        ImgHdr->Pe32.OptionalHeader.Magic,
-        FileName
-        );
-      return EFI_ABORTED;
-    }
-
-    //
-    // Now update file checksum
-    //
-    if (FfsFile->Attributes & FFS_ATTRIB_CHECKSUM) {
-      SavedState  = FfsFile->State;
-      FfsFile->IntegrityCheck.Checksum.File = 0;
-      FfsFile->State                        = 0;
-      FfsFile->IntegrityCheck.Checksum.File = CalculateChecksum8 (
-                                                (UINT8 *) ((UINT8 *)FfsFile + FfsHeaderSize),
-                                                GetFfsFileLength (FfsFile) - FfsHeaderSize
-                                                );
-      FfsFile->State = SavedState;
-    }
-
     //
     // Get this module function address from ModulePeMapFile and add them into FvMap file
     //
@@ -3974,84 +4352,91 @@ Returns:
     }
 
     //
-    // Relocation exist and rebase
-    //
-    //
-    // Load and Relocate Image Data
+    // The caller holds this file rebased to the same address by a previous
+    // build when Relocate is FALSE, so only the map file is written.
     //
-    MemoryImagePointer = (UINT8 *) malloc ((UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
-    if (MemoryImagePointer == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated on rebase of %s", FileName);
-      return EFI_OUT_OF_RESOURCES;
-    }
-    memset ((VOID *) MemoryImagePointer, 0, (UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
-    ImageContext.ImageAddress = ((UINTN) MemoryImagePointer + ImageContext.SectionAlignment - 1) & (~((UINTN) ImageContext.SectionAlignment - 1));
+    if (Relocate) {
+      //
+      // Relocation exist and rebase
+      //
+      //
+      // Load and Relocate Image Data
+      //
+      MemoryImagePointer = (UINT8 *) malloc ((UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
+      if (MemoryImagePointer == NULL) {
+        Error (NULL, 0, 4001, "Resource", "memory cannot be allocated on rebase of %s", FileName);
+        return EFI_OUT_OF_RESOURCES;
+      }
+      memset ((VOID *) MemoryImagePointer, 0, (UINTN) ImageContext.ImageSize + ImageContext.SectionAlignment);
+      ImageContext.ImageAddress = ((UINTN) MemoryImagePointer + ImageContext.SectionAlignment - 1) & (~((UINTN) ImageContext.SectionAlignment - 1));
 
-    Status =  PeCoffLoaderLoadImage (&ImageContext);
-    if (EFI_ERROR (Status)) {
-      Error (NULL, 0, 3000, "Invalid", "LocateImage() call failed on rebase of %s", FileName);
-      free ((VOID *) MemoryImagePointer);
-      return Status;
-    }
-    //
-    // Reloacate TeImage
-    //
-    ImageContext.DestinationAddress = NewPe32BaseAddress;
-    Status                          = PeCoffLoaderRelocateImage (&ImageContext);
-    if (EFI_ERROR (Status)) {
-      Error (NULL, 0, 3000, "Invalid", "RelocateImage() call failed on rebase of TE image %s", FileName);
+      Status =  PeCoffLoaderLoadImage (&ImageContext);
+      if (EFI_ERROR (Status)) {
+        Error (NULL, 0, 3000, "Invalid", "LocateImage() call failed on rebase of %s", FileName);
+        free ((VOID *) MemoryImagePointer);
+        return Status;
+      }
+      //
+      // Reloacate TeImage
+      //
+      ImageContext.DestinationAddress = NewPe32BaseAddress;
+      Status                          = PeCoffLoaderRelocateImage (&ImageContext);
+      if (EFI_ERROR (Status)) {
+        Error (NULL, 0, 3000, "Invalid", "RelocateImage() call failed on rebase of TE image %s", FileName);
+        free ((VOID *) MemoryImagePointer);
+        return Status;
+      }
+
+      //
+      // Copy the relocated image into raw image file.
+      //
+      SectionHeader = (EFI_IMAGE_SECTION_HEADER *) (TEImageHeader + 1);
+      for (Index = 0; Index < TEImageHeader->NumberOfSections; Index ++, SectionHeader ++) {
+        if (!ImageContext.IsTeImage) {
+          CopyMem (
+            (UINT8 *) TEImageHeader + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->PointerToRawData,
+            (VOID*) (UINTN) (ImageContext.ImageAddress + SectionHeader->VirtualAddress),
+            SectionHeader->SizeOfRawData
+            );
+        } else {
+          CopyMem (
+            (UINT8 *) TEImageHeader + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->PointerToRawData,
+            (VOID*) (UINTN) (ImageContext.ImageAddress + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->VirtualAddress),
+            SectionHeader->SizeOfRawData
+            );
+        }
+      }
+
+      //
+      // Free the allocated memory resource
+      //
       free ((VOID *) MemoryImagePointer);
-      return Status;
-    }
+      MemoryImagePointer = NULL;
 
-    //
-    // Copy the relocated image into raw image file.
-    //
-    SectionHeader = (EFI_IMAGE_SECTION_HEADER *) (TEImageHeader + 1);
-    for (Index = 0; Index < TEImageHeader->NumberOfSections; Index ++, SectionHeader ++) {
-      if (!ImageContext.IsTeImage) {
-        CopyMem (
-          (UINT8 *) TEImageHeader + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->PointerToRawData,
-          (VOID*) (UINTN) (ImageContext.ImageAddress + SectionHeader->VirtualAddress),
-          SectionHeader->SizeOfRawData
-          );
-      } else {
-        CopyMem (
-          (UINT8 *) TEImageHeader + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->PointerToRawData,
-          (VOID*) (UINTN) (ImageContext.ImageAddress + sizeof (EFI_TE_IMAGE_HEADER) - TEImageHeader->StrippedSize + SectionHeader->VirtualAddress),
-          SectionHeader->SizeOfRawData
-          );
+      //
+      // Update Image Base Address
+      //
+      TEImageHeader->ImageBase = NewPe32BaseAddress;
+
+      //
+      // Now update file checksum
+      //
+      if (FfsFile->Attributes & FFS_ATTRIB_CHECKSUM) {
+        SavedState  = FfsFile->State;
+        FfsFile->IntegrityCheck.Checksum.File = 0;
+        FfsFile->State                        = 0;
+        FfsFile->IntegrityCheck.Checksum.File = CalculateChecksum8 (
+                                                  (UINT8 *)((UINT8 *)FfsFile + FfsHeaderSize),
+                                                  GetFfsFileLength (FfsFile) - FfsHeaderSize
+                                                  );
+        FfsFile->State = SavedState;
       }
     }
-
-    //
-    // Free the allocated memory resource
-    //
-    free ((VOID *) MemoryImagePointer);
-    MemoryImagePointer = NULL;
     if (PeFileBuffer != NULL) {
       free (PeFileBuffer);
       PeFileBuffer = NULL;
     }
 
-    //
-    // Update Image Base Address
-    //
-    TEImageHeader->ImageBase = NewPe32BaseAddress;
-
-    //
-    // Now update file checksum
-    //
-    if (FfsFile->Attributes & FFS_ATTRIB_CHECKSUM) {
-      SavedState  = FfsFile->State;
-      FfsFile->IntegrityCheck.Checksum.File = 0;
-      FfsFile->State                        = 0;
-      FfsFile->IntegrityCheck.Checksum.File = CalculateChecksum8 (
-                                                (UINT8 *)((UINT8 *)FfsFile + FfsHeaderSize),
-                                                GetFfsFileLength (FfsFile) - FfsHeaderSize
-                                                );
-      FfsFile->State = SavedState;
-    }
     //
     // Get this module function address from ModulePeMapFile and add them into FvMap file
     //
@@ -215,6 +215,16 @@ typedef struct {
   INT8                    ForceRebase;
 } FV_INFO;
 
+//
+// An FFS file rebased into the FV, recorded so that the next build of the
+// same FV can copy it back instead of relocating it again.
+//
+typedef struct {
+  UINT32                  Offset;
+  UINT32                  Length;
+  UINT32                  Crc32;
+} FV_REBASE_CACHE_ENTRY;
+
 typedef struct {
   EFI_GUID                CapGuid;
   UINT32                  HeaderSize;
@@ -333,7 +343,8 @@ FfsRebase (
   IN      CHAR8                 *FileName,
   IN OUT  EFI_FFS_FILE_HEADER   *FfsFile,
   IN      UINTN                 XipOffset,
-  IN      FILE                  *FvMapFile
+  IN      FILE                  *FvMapFile,
+  IN      BOOLEAN               Relocate
   );
 
 //
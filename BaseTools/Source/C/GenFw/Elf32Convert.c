@@ -88,6 +88,13 @@ STATIC Elf_Ehdr *mEhdr;
 STATIC Elf_Shdr *mShdrBase;
 STATIC Elf_Phdr *mPhdrBase;
 
+//
+// Section name string table and symbol string table section, located
+// once and then reused by every section and symbol name lookup.
+//
+STATIC CHAR8    *mShStrtab = NULL;
+STATIC Elf_Shdr *mStrtabShdr = NULL;
+
 //
 // Coff information
 //
@@ -155,6 +162,8 @@ InitializeElf32 (
   //
   mShdrBase  = (Elf_Shdr *)((UINT8 *)mEhdr + mEhdr->e_shoff);
   mPhdrBase = (Elf_Phdr *)((UINT8 *)mEhdr + mEhdr->e_phoff);
+  mShStrtab = NULL;
+  mStrtabShdr = NULL;
 
   //
   // Create COFF Section offset buffer and zero.
@@ -229,6 +238,18 @@ DebugRvaAlign (
   return (Offset + 3) & ~3;
 }
 
+STATIC
+CHAR8 *
+GetShStrtab (
+  VOID
+  )
+{
+  if (mShStrtab == NULL) {
+    mShStrtab = (CHAR8*)mEhdr + GetShdrByIndex(mEhdr->e_shstrndx)->sh_offset;
+  }
+  return mShStrtab;
+}
+
 //
 // filter functions
 //
@@ -248,9 +269,7 @@ IsHiiRsrcShdr (
   Elf_Shdr *Shdr
   )
 {
-  Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
-
-  return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
+  return (BOOLEAN) (strcmp(GetShStrtab() + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
 }
 
 STATIC
@@ -271,9 +290,7 @@ IsStrtabShdr (
   Elf_Shdr *Shdr
   )
 {
-  Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
-
-  return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_STRTAB_SECTION_NAME) == 0);
+  return (BOOLEAN) (strcmp(GetShStrtab() + Shdr->sh_name, ELF_STRTAB_SECTION_NAME) == 0);
 }
 
 STATIC
@@ -283,9 +300,13 @@ FindStrtabShdr (
   )
 {
   UINT32 i;
+  if (mStrtabShdr != NULL) {
+    return mStrtabShdr;
+  }
   for (i = 0; i < mEhdr->e_shnum; i++) {
     Elf_Shdr *shdr = GetShdrByIndex(i);
     if (IsStrtabShdr(shdr)) {
+      mStrtabShdr = shdr;
       return shdr;
     }
   }
@@ -541,6 +562,7 @@ ScanSections32 (
   }
   assert (mCoffFile != NULL);
   memset(mCoffFile, 0, mCoffOffset);
+  mCoffFileSize = mCoffOffset;
 
   //
   // Fill headers.
@@ -569,7 +591,11 @@ ScanSections32 (
   }
 
   NtHdr->Pe32.FileHeader.NumberOfSections = mCoffNbrSections;
-  NtHdr->Pe32.FileHeader.TimeDateStamp = (UINT32) time(NULL);
+  //
+  // The time stamp is zeroed with the debug data afterwards, so the image does
+  // not depend on the time of the conversion.
+  //
+  NtHdr->Pe32.FileHeader.TimeDateStamp = 0;
   mImageTimeStamp = NtHdr->Pe32.FileHeader.TimeDateStamp;
   NtHdr->Pe32.FileHeader.PointerToSymbolTable = 0;
   NtHdr->Pe32.FileHeader.NumberOfSymbols = 0;
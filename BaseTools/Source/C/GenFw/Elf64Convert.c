@@ -89,6 +89,13 @@ STATIC Elf_Ehdr *mEhdr;
 STATIC Elf_Shdr *mShdrBase;
 STATIC Elf_Phdr *mPhdrBase;
 
+//
+// Section name string table and symbol string table section, located
+// once and then reused by every section and symbol name lookup.
+//
+STATIC CHAR8    *mShStrtab = NULL;
+STATIC Elf_Shdr *mStrtabShdr = NULL;
+
 //
 // GOT information
 //
@@ -97,6 +104,7 @@ STATIC UINT32   mGOTShindex = 0;
 STATIC UINT32   *mGOTCoffEntries = NULL;
 STATIC UINT32   mGOTMaxCoffEntries = 0;
 STATIC UINT32   mGOTNumCoffEntries = 0;
+STATIC UINT8    *mGOTCoffEntrySeen = NULL;
 
 //
 // Coff information
@@ -177,6 +185,8 @@ InitializeElf64 (
   VerboseMsg ("Update Header Pointers");
   mShdrBase  = (Elf_Shdr *)((UINT8 *)mEhdr + mEhdr->e_shoff);
   mPhdrBase = (Elf_Phdr *)((UINT8 *)mEhdr + mEhdr->e_phoff);
+  mShStrtab = NULL;
+  mStrtabShdr = NULL;
 
   //
   // Create COFF Section offset buffer and zero.
@@ -239,6 +249,18 @@ DebugRvaAlign (
   return (Offset + 3) & ~3;
 }
 
+STATIC
+CHAR8 *
+GetShStrtab (
+  VOID
+  )
+{
+  if (mShStrtab == NULL) {
+    mShStrtab = (CHAR8*)mEhdr + GetShdrByIndex(mEhdr->e_shstrndx)->sh_offset;
+  }
+  return mShStrtab;
+}
+
 //
 // filter functions
 //
@@ -258,9 +280,7 @@ IsHiiRsrcShdr (
   Elf_Shdr *Shdr
   )
 {
-  Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
-
-  return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
+  return (BOOLEAN) (strcmp(GetShStrtab() + Shdr->sh_name, ELF_HII_SECTION_NAME) == 0);
 }
 
 STATIC
@@ -281,9 +301,7 @@ IsStrtabShdr (
   Elf_Shdr *Shdr
   )
 {
-  Elf_Shdr *Namedr = GetShdrByIndex(mEhdr->e_shstrndx);
-
-  return (BOOLEAN) (strcmp((CHAR8*)mEhdr + Namedr->sh_offset + Shdr->sh_name, ELF_STRTAB_SECTION_NAME) == 0);
+  return (BOOLEAN) (strcmp(GetShStrtab() + Shdr->sh_name, ELF_STRTAB_SECTION_NAME) == 0);
 }
 
 STATIC
@@ -293,9 +311,13 @@ FindStrtabShdr (
   )
 {
   UINT32 i;
+  if (mStrtabShdr != NULL) {
+    return mStrtabShdr;
+  }
   for (i = 0; i < mEhdr->e_shnum; i++) {
     Elf_Shdr *shdr = GetShdrByIndex(i);
     if (IsStrtabShdr(shdr)) {
+      mStrtabShdr = shdr;
       return shdr;
     }
   }
@@ -373,8 +395,10 @@ FindElfGOTSectionFromGOTEntryElfRva (
 //
 // Stores locations of GOT entries in COFF image.
 //   Returns TRUE if GOT entry is new.
-//   Simple implementation as number of GOT
-//   entries is expected to be low.
+//   Entries already seen are tracked in a bitmap
+//   indexed by the offset of the entry within the
+//   GOT section, so that large images with many
+//   GOT references do not pay for a linear search.
 //
 
 STATIC
@@ -383,14 +407,22 @@ AccumulateCoffGOTEntries (
   UINT32 GOTCoffEntry
   )
 {
-  UINT32 i;
-  if (mGOTCoffEntries != NULL) {
-    for (i = 0; i < mGOTNumCoffEntries; i++) {
-      if (mGOTCoffEntries[i] == GOTCoffEntry) {
-        return FALSE;
-      }
+  UINT32 GOTOffset;
+
+  GOTOffset = GOTCoffEntry - mCoffSectionsOffset[mGOTShindex];
+  assert (GOTOffset < mGOTShdr->sh_size);
+  if (mGOTCoffEntrySeen == NULL) {
+    mGOTCoffEntrySeen = (UINT8*)calloc((size_t)(mGOTShdr->sh_size + 7) / 8, 1);
+    if (mGOTCoffEntrySeen == NULL) {
+      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
     }
+    assert (mGOTCoffEntrySeen != NULL);
   }
+  if ((mGOTCoffEntrySeen[GOTOffset / 8] & (1 << (GOTOffset % 8))) != 0) {
+    return FALSE;
+  }
+  mGOTCoffEntrySeen[GOTOffset / 8] |= (UINT8)(1 << (GOTOffset % 8));
+
   if (mGOTCoffEntries == NULL) {
     mGOTCoffEntries = (UINT32*)malloc(5 * sizeof *mGOTCoffEntries);
     if (mGOTCoffEntries == NULL) {
@@ -458,7 +490,9 @@ EmitGOTRelocations (
       EFI_IMAGE_REL_BASED_DIR64);
   }
   free(mGOTCoffEntries);
+  free(mGOTCoffEntrySeen);
   mGOTCoffEntries = NULL;
+  mGOTCoffEntrySeen = NULL;
   mGOTMaxCoffEntries = 0;
   mGOTNumCoffEntries = 0;
 }
@@ -918,6 +952,7 @@ ScanSections64 (
   }
   assert (mCoffFile != NULL);
   memset(mCoffFile, 0, mCoffOffset);
+  mCoffFileSize = mCoffOffset;
 
   //
   // Fill headers.
@@ -951,7 +986,11 @@ ScanSections64 (
   }
 
   NtHdr->Pe32Plus.FileHeader.NumberOfSections = mCoffNbrSections;
-  NtHdr->Pe32Plus.FileHeader.TimeDateStamp = (UINT32) time(NULL);
+  //
+  // The time stamp is zeroed with the debug data afterwards, so the image does
+  // not depend on the time of the conversion.
+  //
+  NtHdr->Pe32Plus.FileHeader.TimeDateStamp = 0;
   mImageTimeStamp = NtHdr->Pe32Plus.FileHeader.TimeDateStamp;
   NtHdr->Pe32Plus.FileHeader.PointerToSymbolTable = 0;
   NtHdr->Pe32Plus.FileHeader.NumberOfSymbols = 0;
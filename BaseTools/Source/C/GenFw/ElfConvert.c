@@ -35,6 +35,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 UINT8 *mCoffFile = NULL;
 
+//
+// Allocated size of mCoffFile.
+//
+UINT32 mCoffFileSize = 0;
+
 //
 // COFF relocation data
 //
@@ -79,6 +84,8 @@ CoffAddFixup(
   UINT8  Type
   )
 {
+  UINT32 NewSize;
+
   if (mCoffBaseRel == NULL
       || mCoffBaseRel->VirtualAddress != (Offset & ~0xfff)) {
     if (mCoffBaseRel != NULL) {
@@ -94,18 +101,24 @@ CoffAddFixup(
         CoffAddFixupEntry (0);
     }
 
-    mCoffFile = realloc (
-      mCoffFile,
-      mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
-    if (mCoffFile == NULL) {
-      Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+    //
+    // Grow the buffer geometrically so that images with many relocation
+    // blocks are not reallocated (and copied) once per 4KB page.  The
+    // bytes beyond mCoffOffset are always kept zeroed.
+    //
+    NewSize = mCoffOffset + sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT;
+    if (NewSize > mCoffFileSize) {
+      if (NewSize < 2 * mCoffFileSize) {
+        NewSize = 2 * mCoffFileSize;
+      }
+      mCoffFile = realloc (mCoffFile, NewSize);
+      if (mCoffFile == NULL) {
+        Error (NULL, 0, 4001, "Resource", "memory cannot be allocated!");
+      }
+      assert (mCoffFile != NULL);
+      memset (mCoffFile + mCoffFileSize, 0, NewSize - mCoffFileSize);
+      mCoffFileSize = NewSize;
     }
-    assert (mCoffFile != NULL);
-    memset (
-      mCoffFile + mCoffOffset, 0,
-      sizeof(EFI_IMAGE_BASE_RELOCATION) + 2 * MAX_COFF_ALIGNMENT
-      );
 
     mCoffBaseRel = (EFI_IMAGE_BASE_RELOCATION*)(mCoffFile + mCoffOffset);
     mCoffBaseRel->VirtualAddress = Offset & ~0xfff;
@@ -45,7 +45,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 //
 #define UTILITY_NAME "GenFw"
 #define UTILITY_MAJOR_VERSION 0
-#define UTILITY_MINOR_VERSION 2
+#define UTILITY_MINOR_VERSION 3
 
 #define HII_RESOURCE_SECTION_INDEX  1
 #define HII_RESOURCE_SECTION_NAME   "HII"
@@ -54,6 +54,11 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define DEFAULT_MC_ALIGNMENT       16
 
 #define STATUS_IGNORE 0xA
+
+//
+// Suffix of the file recording which input produced an output image.
+//
+#define IMAGE_HASH_FILE_SUFFIX  ".hash"
 //
 // Structure definition for a microcode header
 //
@@ -1032,6 +1037,173 @@ Returns:
   return Status;
 }
 
+STATIC
+UINT64
+HashBuffer (
+  IN UINT64      Hash,
+  IN CONST VOID  *Buffer,
+  IN UINTN       Length
+  )
+/*++
+
+Routine Description:
+
+  Fold a buffer into a 64-bit FNV-1a hash.
+
+Arguments:
+
+  Hash          - The hash of the preceding data, or the FNV offset basis.
+  Buffer        - The data to hash.
+  Length        - The size of the data in bytes.
+
+Returns:
+
+  The updated hash value.
+
+--*/
+{
+  CONST UINT8  *Data;
+  UINTN        Index;
+
+  Data = (CONST UINT8 *) Buffer;
+  for (Index = 0; Index < Length; Index++) {
+    Hash ^= Data[Index];
+    Hash *= 0x100000001B3ULL;
+  }
+  return Hash;
+}
+
+STATIC
+UINT64
+GetImageKeyHash (
+  IN int          ArgCount,
+  IN char         **ArgList,
+  IN UINT8        *InputFileBuffer,
+  IN UINT32       InputFileLength
+  )
+/*++
+
+Routine Description:
+
+  Compute the hash identifying one conversion: the version of this utility,
+  the command line options and the content of the input file.
+
+Arguments:
+
+  ArgCount        - Number of command line parameters.
+  ArgList         - Array of pointers to command line parameter strings.
+  InputFileBuffer - Content of the input file.
+  InputFileLength - Size of the input file in bytes.
+
+Returns:
+
+  The hash value.
+
+--*/
+{
+  UINT64  Hash;
+  UINT32  Version;
+  int     Index;
+
+  Hash    = 0xCBF29CE484222325ULL;
+  Version = (UTILITY_MAJOR_VERSION << 16) | UTILITY_MINOR_VERSION;
+  Hash    = HashBuffer (Hash, &Version, sizeof (Version));
+  for (Index = 0; Index < ArgCount; Index++) {
+    Hash = HashBuffer (Hash, ArgList[Index], strlen (ArgList[Index]) + 1);
+  }
+  Hash = HashBuffer (Hash, &InputFileLength, sizeof (InputFileLength));
+  return HashBuffer (Hash, InputFileBuffer, InputFileLength);
+}
+
+STATIC
+BOOLEAN
+IsImageHashCurrent (
+  IN CHAR8   *HashFileName,
+  IN UINT64  KeyHash,
+  IN UINT8   *OutputFileBuffer,
+  IN UINT32  OutputFileLength
+  )
+/*++
+
+Routine Description:
+
+  Check whether the existing output file was produced by a conversion with
+  the given key hash and has not been modified since.
+
+Arguments:
+
+  HashFileName     - The file recording the hashes of the last conversion.
+  KeyHash          - The hash of the current conversion.
+  OutputFileBuffer - Content of the existing output file.
+  OutputFileLength - Size of the existing output file in bytes.
+
+Returns:
+
+  TRUE             - The output file is up to date.
+  FALSE            - The output file needs to be generated.
+
+--*/
+{
+  FILE                *HashFile;
+  unsigned long long  RecordedKeyHash;
+  unsigned long long  RecordedOutputHash;
+  int                 Count;
+
+  HashFile = fopen (LongFilePath (HashFileName), "r");
+  if (HashFile == NULL) {
+    return FALSE;
+  }
+  Count = fscanf (HashFile, "%llx %llx", &RecordedKeyHash, &RecordedOutputHash);
+  fclose (HashFile);
+
+  return (BOOLEAN) (Count == 2 &&
+                    RecordedKeyHash == KeyHash &&
+                    RecordedOutputHash == HashBuffer (0xCBF29CE484222325ULL, OutputFileBuffer, OutputFileLength));
+}
+
+STATIC
+VOID
+WriteImageHash (
+  IN CHAR8   *HashFileName,
+  IN UINT64  KeyHash,
+  IN UINT8   *FileBuffer,
+  IN UINT32  FileLength
+  )
+/*++
+
+Routine Description:
+
+  Record the key hash of this conversion together with the hash of the
+  output it produced.
+
+Arguments:
+
+  HashFileName  - The file recording the hashes.
+  KeyHash       - The hash of the current conversion.
+  FileBuffer    - Content of the output file.
+  FileLength    - Size of the output file in bytes.
+
+Returns:
+
+  None
+
+--*/
+{
+  FILE  *HashFile;
+
+  HashFile = fopen (LongFilePath (HashFileName), "w");
+  if (HashFile == NULL) {
+    return;
+  }
+  fprintf (
+    HashFile,
+    "%016llx %016llx\n",
+    (unsigned long long) KeyHash,
+    (unsigned long long) HashBuffer (0xCBF29CE484222325ULL, FileBuffer, FileLength)
+    );
+  fclose (HashFile);
+}
+
 int
 main (
   int  argc,
@@ -1116,6 +1288,12 @@ Returns:
   time_t                           OutputFileTime;
   struct stat                      Stat_Buf;
   BOOLEAN                          ZeroDebugFlag;
+  int                              OptionCount;
+  char                             **OptionList;
+  CHAR8                            *HashFileName;
+  UINT64                           KeyHash;
+  BOOLEAN                          UseImageHash;
+  BOOLEAN                          ImageUpToDate;
 
   SetUtilityName (UTILITY_NAME);
 
@@ -1164,6 +1342,10 @@ Returns:
   InputFileTime          = 0;
   OutputFileTime         = 0;
   ZeroDebugFlag          = FALSE;
+  HashFileName           = NULL;
+  KeyHash                = 0;
+  UseImageHash           = FALSE;
+  ImageUpToDate          = FALSE;
 
   if (argc == 1) {
     Error (NULL, 0, 1001, "Missing options", "No input options.");
@@ -1173,6 +1355,8 @@ Returns:
 
   argc --;
   argv ++;
+  OptionCount = argc;
+  OptionList  = argv;
 
   if ((stricmp (argv[0], "-h") == 0) || (stricmp (argv[0], "--help") == 0)) {
     Version ();
@@ -1631,6 +1815,30 @@ Returns:
   fclose (fpIn);
   DebugMsg (NULL, 0, 9, "input file info", "the input file size is %u bytes", (unsigned) InputFileLength);
 
+  //
+  // The output of a single input conversion only depends on the input
+  // content and the options, so skip it when the existing output was
+  // generated from the same input with the same options. The image is
+  // then neither converted nor rewritten, and its time stamp is kept.
+  //
+  if (OutImageName != NULL && !ReplaceFlag && InputFileNum == 1 &&
+      mOutImageType != FW_SET_STAMP_IMAGE && mOutImageType != DUMP_TE_HEADER) {
+    HashFileName = (CHAR8 *) malloc (strlen (OutImageName) + sizeof (IMAGE_HASH_FILE_SUFFIX));
+    if (HashFileName != NULL) {
+      strcpy (HashFileName, OutImageName);
+      strcat (HashFileName, IMAGE_HASH_FILE_SUFFIX);
+      UseImageHash = TRUE;
+      KeyHash = GetImageKeyHash (OptionCount, OptionList, InputFileBuffer, InputFileLength);
+      if (OutputFileBuffer != NULL &&
+          IsImageHashCurrent (HashFileName, KeyHash, OutputFileBuffer, OutputFileLength)) {
+        VerboseMsg ("the output file %s is up to date", OutImageName);
+        mImageSize    = OutputFileLength;
+        ImageUpToDate = TRUE;
+        goto Finish;
+      }
+    }
+  }
+
   //
   // Combine multi binary HII package files.
   //
@@ -2687,6 +2895,9 @@ WriteFile:
       fwrite (FileBuffer, 1, FileLength, fpOut);
       VerboseMsg ("the size of output file is %u bytes", (unsigned) FileLength);
     }
+    if (UseImageHash) {
+      WriteImageHash (HashFileName, KeyHash, FileBuffer, FileLength);
+    }
   }
   mImageSize = FileLength;
 
@@ -2736,13 +2947,17 @@ Finish:
     free (OutputFileBuffer);
   }
 
+  if (HashFileName != NULL) {
+    free (HashFileName);
+  }
+
   //
   // Write module size and time stamp to report file.
   //
   if (OutImageName != NULL) {
     FileLen = strlen (OutImageName);
   }
-  if (FileLen >= 4 && strcmp (OutImageName + (FileLen - 4), ".efi") == 0) {
+  if (!ImageUpToDate && FileLen >= 4 && strcmp (OutImageName + (FileLen - 4), ".efi") == 0) {
     ReportFileName = (CHAR8 *) malloc (FileLen + 1);
     if (ReportFileName != NULL) {
       strcpy (ReportFileName, OutImageName);
@@ -44,10 +44,11 @@ static CONVERTER_TYPE mConType = NoConverter;
 
 UINT64 mDictionarySize = 28;
 UINT64 mCompressionMode = 2;
+UINT64 mNumThreads = 0;
 
 #define UTILITY_NAME "LzmaCompress"
 #define UTILITY_MAJOR_VERSION 0
-#define UTILITY_MINOR_VERSION 2
+#define UTILITY_MINOR_VERSION 3
 #define INTEL_COPYRIGHT \
   "Copyright (c) 2009-2018, Intel Corporation. All rights reserved."
 void PrintHelp(char *buffer)
@@ -65,6 +66,9 @@ void PrintHelp(char *buffer)
              "  --debug [0-9]: set debug level\n"
              "  -a: set compression mode 0 = fast, 1 = normal, default: 1 (normal)\n"
              "  d: sets Dictionary size - [0, 27], default: 24 (16MB)\n"
+             "  --threads [1, 2]: number of encoder threads, default: 2. The second thread\n"
+             "      runs the match finder of the normal mode. The output does not\n"
+             "      depend on the number of threads.\n"
              "  --version: display the program version and exit\n"
              "  -h, --help: display this help text\n"
              );
@@ -309,6 +313,18 @@ int main2(int numArgs, const char *args[], char *rs)
       } else {
         return PrintError(rs, kInvalidParamValMessage);
       }
+    } else if (strcmp(args[param], "--threads") == 0) {
+      if (numArgs < (param + 2)) {
+        return PrintUserError(rs);
+      }
+      AsciiStringToUint64(args[param + 1],FALSE,&mNumThreads);
+      if ((mNumThreads == 1)||(mNumThreads == 2)) {
+        props.numThreads = (int)mNumThreads;
+        param++;
+        continue;
+      } else {
+        return PrintError(rs, kInvalidParamValMessage);
+      }
     } else if (
                 strcmp(args[param], "-h") == 0 ||
                 strcmp(args[param], "--help") == 0
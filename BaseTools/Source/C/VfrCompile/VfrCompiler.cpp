@@ -10,6 +10,7 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include "stdio.h"
 #include "stdlib.h"
 #include "string.h"
+#include <new>
 #include "VfrCompiler.h"
 #include "CommonLib.h"
 #include "EfiUtilityMsgs.h"
@@ -169,17 +170,10 @@ CVfrCompiler::OptionInitialization (
     }
   }
 
-  if (Index != Argc - 1) {
+  if (Index >= Argc) {
     DebugError (NULL, 0, 1001, "Missing option", "VFR file name is not specified.");
     goto Fail;
   } else {
-    mOptions.VfrFileName = (CHAR8 *) malloc (strlen (Argv[Index]) + 1);
-    if (mOptions.VfrFileName == NULL) {
-      DebugError (NULL, 0, 4001, "Resource: memory can't be allocated", NULL);
-      goto Fail;
-    }
-    strcpy (mOptions.VfrFileName, Argv[Index]);
-
     if (mOptions.OutputDirectory == NULL) {
       mOptions.OutputDirectory = (CHAR8 *) malloc (1);
       if (mOptions.OutputDirectory == NULL) {
@@ -190,19 +184,15 @@ CVfrCompiler::OptionInitialization (
     }
   }
 
-  if (SetBaseFileName() != 0) {
-    goto Fail;
-  }
-  if (SetPkgOutputFileName () != 0) {
-    goto Fail;
-  }
-  if (SetCOutputFileName() != 0) {
-    goto Fail;
-  }
-  if (SetPreprocessorOutputFileName () != 0) {
-    goto Fail;
-  }
-  if (SetRecordListFileName () != 0) {
+  //
+  // Every remaining argument is a VFR file, compiled one after the other
+  // with the same options.
+  //
+  mVfrFileList  = &Argv[Index];
+  mVfrFileCount = (UINT32) (Argc - Index);
+  mVfrFileIndex = 0;
+
+  if (SetVfrFileName (mVfrFileList[mVfrFileIndex]) != 0) {
     goto Fail;
   }
   return;
@@ -309,6 +299,145 @@ CVfrCompiler::AppendCPreprocessorOptions (
   mOptions.CPreprocessorOptions = Opt;
 }
 
+INT8
+CVfrCompiler::SetVfrFileName (
+  IN CHAR8      *VfrFileName
+  )
+{
+  mOptions.VfrFileName = (CHAR8 *) malloc (strlen (VfrFileName) + 1);
+  if (mOptions.VfrFileName == NULL) {
+    DebugError (NULL, 0, 4001, "Resource: memory can't be allocated", NULL);
+    return -1;
+  }
+  strcpy (mOptions.VfrFileName, VfrFileName);
+
+  if (SetBaseFileName() != 0) {
+    return -1;
+  }
+  if (SetPkgOutputFileName () != 0) {
+    return -1;
+  }
+  if (SetCOutputFileName() != 0) {
+    return -1;
+  }
+  if (SetPreprocessorOutputFileName () != 0) {
+    return -1;
+  }
+  if (SetRecordListFileName () != 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+VOID
+CVfrCompiler::FreeVfrFileNames (
+  VOID
+  )
+{
+  if (mOptions.VfrFileName != NULL) {
+    free (mOptions.VfrFileName);
+    mOptions.VfrFileName = NULL;
+  }
+
+  if (mOptions.VfrBaseFileName != NULL) {
+    free (mOptions.VfrBaseFileName);
+    mOptions.VfrBaseFileName = NULL;
+  }
+
+  if (mOptions.PkgOutputFileName != NULL) {
+    free (mOptions.PkgOutputFileName);
+    mOptions.PkgOutputFileName = NULL;
+  }
+
+  if (mOptions.COutputFileName != NULL) {
+    free (mOptions.COutputFileName);
+    mOptions.COutputFileName = NULL;
+  }
+
+  if (mOptions.PreprocessorOutputFileName != NULL) {
+    free (mOptions.PreprocessorOutputFileName);
+    mOptions.PreprocessorOutputFileName = NULL;
+  }
+
+  if (mOptions.RecordListFile != NULL) {
+    free (mOptions.RecordListFile);
+    mOptions.RecordListFile = NULL;
+  }
+}
+
+//
+// Destroy a global object and construct it again in place, which brings it
+// back to the state it had when the program started.
+//
+template <class T>
+STATIC
+VOID
+ReconstructGlobal (
+  IN OUT T      &Object
+  )
+{
+  Object.~T ();
+  new (&Object) T;
+}
+
+VOID
+CVfrCompiler::ResetCompileState (
+  VOID
+  )
+{
+  ReconstructGlobal (gCVfrErrorHandle);
+  ReconstructGlobal (gCVfrBufferConfig);
+  ReconstructGlobal (gCVfrVarDataTypeDB);
+  ReconstructGlobal (gCVfrDataStorage);
+  ReconstructGlobal (gCVfrDefaultStore);
+  ReconstructGlobal (gCFormPkg);
+  ReconstructGlobal (gCIfrRecordInfoDB);
+
+  gAdjustOpcodeOffset = 0;
+  gNeedAdjustOpcode   = FALSE;
+  gAdjustOpcodeLen    = 0;
+  gCreateOp           = TRUE;
+  gScopeCount         = 0;
+  memset (CIfrFormId::FormIdBitMap, 0, sizeof (CIfrFormId::FormIdBitMap));
+
+  if (mOptions.CreateRecordListFile) {
+    gCIfrRecordInfoDB.TurnOn ();
+  }
+}
+
+/**
+  Move on to the next VFR file given on the command line.
+
+  The compiler databases filled while parsing are reset, so each file is
+  compiled exactly as it would be by a separate VfrCompile process.
+
+  @retval TRUE   The next file is ready to be compiled.
+  @retval FALSE  There is no file left, or the command line was invalid.
+
+**/
+BOOLEAN
+CVfrCompiler::NextVfrFile (
+  VOID
+  )
+{
+  if (IS_RUN_STATUS(STATUS_DEAD) || (mVfrFileIndex + 1 >= mVfrFileCount)) {
+    return FALSE;
+  }
+
+  mVfrFileIndex++;
+  FreeVfrFileNames ();
+  ResetCompileState ();
+
+  if (SetVfrFileName (mVfrFileList[mVfrFileIndex]) != 0) {
+    SET_RUN_STATUS (STATUS_DEAD);
+    return FALSE;
+  }
+
+  SET_RUN_STATUS (STATUS_INITIALIZED);
+  return TRUE;
+}
+
 INT8
 CVfrCompiler::SetBaseFileName (
   VOID
@@ -470,6 +599,9 @@ CVfrCompiler::CVfrCompiler (
 {
   mPreProcessCmd = (CHAR8 *) PREPROCESSOR_COMMAND;
   mPreProcessOpt = (CHAR8 *) PREPROCESSOR_OPTIONS;
+  mVfrFileList   = NULL;
+  mVfrFileCount  = 0;
+  mVfrFileIndex  = 0;
 
   SET_RUN_STATUS (STATUS_STARTED);
 
@@ -486,41 +618,13 @@ CVfrCompiler::~CVfrCompiler (
   VOID
   )
 {
-  if (mOptions.VfrFileName != NULL) {
-    free (mOptions.VfrFileName);
-    mOptions.VfrFileName = NULL;
-  }
-
-  if (mOptions.VfrBaseFileName != NULL) {
-    free (mOptions.VfrBaseFileName);
-    mOptions.VfrBaseFileName = NULL;
-  }
+  FreeVfrFileNames ();
 
   if (mOptions.OutputDirectory != NULL) {
     free (mOptions.OutputDirectory);
     mOptions.OutputDirectory = NULL;
   }
 
-  if (mOptions.PkgOutputFileName != NULL) {
-    free (mOptions.PkgOutputFileName);
-    mOptions.PkgOutputFileName = NULL;
-  }
-
-  if (mOptions.COutputFileName != NULL) {
-    free (mOptions.COutputFileName);
-    mOptions.COutputFileName = NULL;
-  }
-
-  if (mOptions.PreprocessorOutputFileName != NULL) {
-    free (mOptions.PreprocessorOutputFileName);
-    mOptions.PreprocessorOutputFileName = NULL;
-  }
-
-  if (mOptions.RecordListFile != NULL) {
-    free (mOptions.RecordListFile);
-    mOptions.RecordListFile = NULL;
-  }
-
   if (mOptions.IncludePaths != NULL) {
     delete[] mOptions.IncludePaths;
     mOptions.IncludePaths = NULL;
@@ -545,7 +649,9 @@ CVfrCompiler::Usage (
     "VfrCompile version " VFR_COMPILER_VERSION "Build " __BUILD_VERSION,
     "Copyright (c) 2004-2016 Intel Corporation. All rights reserved.",
     " ",
-    "Usage: VfrCompile [options] VfrFile",
+    "Usage: VfrCompile [options] VfrFile [VfrFile ...]",
+    " ",
+    "Each VfrFile is compiled on its own with the same options.",
     " ",
     "Options:",
     "  -h, --help     prints this help",
@@ -911,28 +1017,38 @@ main (
   )
 {
   COMPILER_RUN_STATUS  Status;
+  BOOLEAN              Failed;
 
   SetPrintLevel(WARNING_LOG_LEVEL);
   CVfrCompiler         Compiler(Argc, Argv);
 
-  Compiler.PreProcess();
-  Compiler.Compile();
-  Compiler.AdjustBin();
-  Compiler.GenBinary();
-  Compiler.GenCFile();
-  Compiler.GenRecordListFile ();
+  Failed = FALSE;
+  do {
+    Compiler.PreProcess();
+    Compiler.Compile();
+    Compiler.AdjustBin();
+    Compiler.GenBinary();
+    Compiler.GenCFile();
+    Compiler.GenRecordListFile ();
+
+    Status = Compiler.RunStatus ();
+    if ((Status == STATUS_DEAD) || (Status == STATUS_FAILED)) {
+      Failed = TRUE;
+    }
 
-  Status = Compiler.RunStatus ();
-  if ((Status == STATUS_DEAD) || (Status == STATUS_FAILED)) {
-    return 2;
-  }
+    if (gCBuffer.Buffer != NULL) {
+      delete[] gCBuffer.Buffer;
+      gCBuffer.Buffer = NULL;
+    }
 
-  if (gCBuffer.Buffer != NULL) {
-    delete[] gCBuffer.Buffer;
-  }
+    if (gRBuffer.Buffer != NULL) {
+      delete[] gRBuffer.Buffer;
+      gRBuffer.Buffer = NULL;
+    }
+  } while (Compiler.NextVfrFile ());
 
-  if (gRBuffer.Buffer != NULL) {
-    delete[] gRBuffer.Buffer;
+  if (Failed) {
+    return 2;
   }
 
   return GetUtilityStatus ();
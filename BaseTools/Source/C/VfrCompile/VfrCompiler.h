@@ -71,10 +71,16 @@ private:
   OPTIONS              mOptions;
   CHAR8                *mPreProcessCmd;
   CHAR8                *mPreProcessOpt;
+  CHAR8                **mVfrFileList;     // all VFR files given on the command line
+  UINT32               mVfrFileCount;
+  UINT32               mVfrFileIndex;      // index of the file being compiled
 
   VOID    OptionInitialization (IN INT32 , IN CHAR8 **);
   VOID    AppendIncludePath (IN CHAR8 *);
   VOID    AppendCPreprocessorOptions (IN CHAR8 *);
+  INT8    SetVfrFileName (IN CHAR8 *);
+  VOID    FreeVfrFileNames (VOID);
+  VOID    ResetCompileState (VOID);
   INT8    SetBaseFileName (VOID);
   INT8    SetPkgOutputFileName (VOID);
   INT8    SetCOutputFileName(VOID);
@@ -96,6 +102,7 @@ public:
   VOID                Usage (VOID);
   VOID                Version (VOID);
 
+  BOOLEAN             NextVfrFile (VOID);
   VOID                PreProcess (VOID);
   VOID                Compile (VOID);
   VOID                AdjustBin (VOID);
@@ -502,6 +502,7 @@ CFormPkg::AssignPending (
 
   pNew->mNext       = PendingAssignList;
   PendingAssignList = pNew;
+  mPendingAssignIndex[pNew->mKey].push_back (pNew);
   return VFR_RETURN_SUCCESS;
 }
 
@@ -512,16 +513,20 @@ CFormPkg::DoPendingAssign (
   IN UINT32 ValLen
   )
 {
-  SPendingAssign *pNode;
+  UINT32         Index;
+  std::unordered_map<std::string, std::vector<SPendingAssign *> >::iterator Iter;
 
   if ((Key == NULL) || (ValAddr == NULL)) {
     return;
   }
 
-  for (pNode = PendingAssignList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mKey, Key) == 0) {
-      pNode->AssignValue (ValAddr, ValLen);
-    }
+  Iter = mPendingAssignIndex.find (Key);
+  if (Iter == mPendingAssignIndex.end ()) {
+    return;
+  }
+
+  for (Index = (UINT32) Iter->second.size (); Index > 0; Index--) {
+    Iter->second[Index - 1]->AssignValue (ValAddr, ValLen);
   }
 }
 
@@ -1024,6 +1029,8 @@ CIfrRecordInfoDB::CIfrRecordInfoDB (
   mRecordCount       = EFI_IFR_RECORDINFO_IDX_START;
   mIfrRecordListHead = NULL;
   mIfrRecordListTail = NULL;
+  mIfrRecordIndexValid = TRUE;
+  mRecordLineIndexValid = FALSE;
   mAllDefaultTypeCount = 0;
   for (UINT8 i = 0; i < EFI_HII_MAX_SUPPORT_DEFAULT_TYPE; i++) {
     mAllDefaultIdArray[i] = 0xffff;
@@ -1055,6 +1062,11 @@ CIfrRecordInfoDB::GetRecordInfoFromIdx (
     return NULL;
   }
 
+  if (mIfrRecordIndexValid) {
+    Idx = RecordIdx - (EFI_IFR_RECORDINFO_IDX_START + 1);
+    return (Idx < mIfrRecordIndex.size ()) ? mIfrRecordIndex[Idx] : NULL;
+  }
+
   for (Idx = (EFI_IFR_RECORDINFO_IDX_START + 1), pNode = mIfrRecordListHead;
        (Idx != RecordIdx) && (pNode != NULL);
        Idx++, pNode = pNode->mNext)
@@ -1088,6 +1100,8 @@ CIfrRecordInfoDB::IfrRecordRegister (
     mIfrRecordListTail->mNext = pNew;
     mIfrRecordListTail = pNew;
   }
+  mIfrRecordIndex.push_back (pNew);
+  mRecordLineIndexValid = FALSE;
   mRecordCount++;
 
   return mRecordCount;
@@ -1121,6 +1135,7 @@ CIfrRecordInfoDB::IfrRecordInfoUpdate (
 
   pNode->mLineNo    = LineNo;
   pNode->mOffset    = Offset;
+  mRecordLineIndexValid = FALSE;
   pNode->mBinBufLen = BinBufLen;
   pNode->mIfrBinBuf = BinBuf;
 
@@ -1177,6 +1192,8 @@ CIfrRecordInfoDB::IfrRecordOutput (
   SIfrRecord *pNode;
   UINT8      Index;
   UINT32     TotalSize;
+  UINT32     RecordIndex;
+  std::unordered_map<UINT32, std::vector<SIfrRecord *> >::iterator Iter;
 
   if (mSwitch == FALSE) {
     return;
@@ -1188,10 +1205,27 @@ CIfrRecordInfoDB::IfrRecordOutput (
 
   TotalSize = 0;
 
-  for (pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mLineNo == LineNo || LineNo == 0) {
+  if (LineNo != 0) {
+    //
+    // The record list file asks for every source line in turn, so group the
+    // records by line once instead of walking the whole list per line.
+    //
+    if (!mRecordLineIndexValid) {
+      mRecordLineIndex.clear ();
+      for (pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
+        mRecordLineIndex[pNode->mLineNo].push_back (pNode);
+      }
+      mRecordLineIndexValid = TRUE;
+    }
+
+    Iter = mRecordLineIndex.find (LineNo);
+    if (Iter == mRecordLineIndex.end ()) {
+      return;
+    }
+
+    for (RecordIndex = 0; RecordIndex < Iter->second.size (); RecordIndex++) {
+      pNode = Iter->second[RecordIndex];
       fprintf (File, ">%08X: ", pNode->mOffset);
-      TotalSize += pNode->mBinBufLen;
       if (pNode->mIfrBinBuf != NULL) {
         for (Index = 0; Index < pNode->mBinBufLen; Index++) {
           fprintf (File, "%02X ", (UINT8)(pNode->mIfrBinBuf[Index]));
@@ -1199,11 +1233,21 @@ CIfrRecordInfoDB::IfrRecordOutput (
       }
       fprintf (File, "\n");
     }
+    return;
   }
 
-  if (LineNo == 0) {
-    fprintf (File, "\nTotal Size of all record is 0x%08X\n", TotalSize);
+  for (pNode = mIfrRecordListHead; pNode != NULL; pNode = pNode->mNext) {
+    fprintf (File, ">%08X: ", pNode->mOffset);
+    TotalSize += pNode->mBinBufLen;
+    if (pNode->mIfrBinBuf != NULL) {
+      for (Index = 0; Index < pNode->mBinBufLen; Index++) {
+        fprintf (File, "%02X ", (UINT8)(pNode->mIfrBinBuf[Index]));
+      }
+    }
+    fprintf (File, "\n");
   }
+
+  fprintf (File, "\nTotal Size of all record is 0x%08X\n", TotalSize);
 }
 
 //
@@ -1348,6 +1392,8 @@ CIfrRecordInfoDB::IfrAdjustDynamicOpcodeInRecords (
   //
   // Adjust the node. pPreNode save the Node before mIfrRecordListTail
   //
+  mIfrRecordIndexValid  = FALSE;
+  mRecordLineIndexValid = FALSE;
   pNodeBeforeAdjust->mNext = pNodeBeforeDynamic->mNext;
   if (CreateOpcodeAfterParsingVfr) {
     //
@@ -1529,6 +1575,8 @@ CIfrRecordInfoDB::IfrRecordAdjust (
           uNode = uNode->mNext;
         }
 
+        mIfrRecordIndexValid  = FALSE;
+        mRecordLineIndexValid = FALSE;
         preNode->mNext = tNode->mNext;
         tNode->mNext = uNode->mNext;
         uNode->mNext = pNode;
@@ -1598,6 +1646,8 @@ CIfrRecordInfoDB::IfrRecordAdjust (
         // Insert varstore opcode beform form opcode if form opcode is found
         //
         if (uNode->mNext != NULL) {
+          mIfrRecordIndexValid  = FALSE;
+          mRecordLineIndexValid = FALSE;
           preNode->mNext = tNode->mNext;
           tNode->mNext = uNode->mNext;
           uNode->mNext = pNode;
@@ -119,6 +119,7 @@ private:
 
 private:
   SPendingAssign      *PendingAssignList;
+  std::unordered_map<std::string, std::vector<SPendingAssign *> > mPendingAssignIndex;
 
 public:
   CFormPkg (IN UINT32 BufferSize = 4096);
@@ -167,6 +168,7 @@ extern CFormPkg       gCFormPkg;
 extern CVfrStringDB   gCVfrStringDB;
 extern UINT32         gAdjustOpcodeOffset;
 extern BOOLEAN        gNeedAdjustOpcode;
+extern UINT32         gAdjustOpcodeLen;
 
 struct SIfrRecord {
   UINT32     mLineNo;
@@ -203,6 +205,20 @@ private:
   UINT32     mRecordCount;
   SIfrRecord *mIfrRecordListHead;
   SIfrRecord *mIfrRecordListTail;
+
+  //
+  // Records in registration order. Only usable while the record list has
+  // not been reordered, after that GetRecordInfoFromIdx walks the list.
+  //
+  std::vector<SIfrRecord *> mIfrRecordIndex;
+  BOOLEAN                   mIfrRecordIndexValid;
+
+  //
+  // Records grouped by source line for the record list file, rebuilt on
+  // demand after the record list changes.
+  //
+  std::unordered_map<UINT32, std::vector<SIfrRecord *> > mRecordLineIndex;
+  BOOLEAN                   mRecordLineIndexValid;
   UINT8      mAllDefaultTypeCount;
   UINT16     mAllDefaultIdArray[EFI_HII_MAX_SUPPORT_DEFAULT_TYPE];
 
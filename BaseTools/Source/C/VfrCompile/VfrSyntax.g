@@ -48,6 +48,15 @@ VfrParserStart (
   IN INPUT_INFO_TO_SYNTAX *InputInfo
   )
 {
+  //
+  // A previous file given on the same command line may have stopped in the
+  // middle of a question, so clear the question tracking state first.
+  //
+  gCurrentQuestion   = NULL;
+  gCurrentMinMaxData = NULL;
+  gIsOrderedList     = FALSE;
+  gIsStringOp        = FALSE;
+
   ParserBlackBox<CVfrDLGLexer, EfiVfrParser, ANTLRToken> VfrParser(File);
   VfrParser.parser()->SetOverrideClassGuid (InputInfo->OverrideClassGuid);
   return VfrParser.parser()->vfrProgram();
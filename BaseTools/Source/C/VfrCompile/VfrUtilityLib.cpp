@@ -187,6 +187,7 @@ SConfigItem::SConfigItem (
   }
 
   mInfoStrList = new SConfigInfo(Type, Offset, Width, Value);
+  mInfoOffsetSet.insert (Offset);
 }
 
 SConfigItem::~SConfigItem (
@@ -320,17 +321,16 @@ CVfrBufferConfig::Write (
       }
       mItemListPos = pItem;
     } else {
-      // tranverse the list to find out if there's already the value for the same offset
-      for (pInfo = mItemListPos->mInfoStrList; pInfo != NULL; pInfo = pInfo->mNext) {
-        if (pInfo->mOffset == Offset) {
-          return 0;
-        }
+      // check whether there's already the value for the same offset
+      if (mItemListPos->mInfoOffsetSet.count (Offset) != 0) {
+        return 0;
       }
       if((pInfo = new SConfigInfo (Type, Offset, Width, Value)) == NULL) {
         return 2;
       }
       pInfo->mNext = mItemListPos->mInfoStrList;
       mItemListPos->mInfoStrList = pInfo;
+      mItemListPos->mInfoOffsetSet.insert (Offset);
     }
     break;
 
@@ -570,6 +570,20 @@ CVfrVarDataTypeDB::RegisterNewType (
 {
   New->mNext               = mDataTypeList;
   mDataTypeList            = New;
+  mDataTypeIndex[New->mTypeName] = New;
+}
+
+VOID
+CVfrVarDataTypeDB::IndexTypeField (
+  IN SVfrDataType  *Type,
+  IN SVfrDataField *Field
+  )
+{
+  //
+  // Keep the first member registered with a given name, which is the one a
+  // walk of mMembers would find.
+  //
+  Type->mFieldIndex.insert (std::make_pair (std::string (Field->mFieldName), Field));
 }
 
 EFI_VFR_RETURN_CODE
@@ -717,34 +731,33 @@ CVfrVarDataTypeDB::GetTypeField (
   OUT SVfrDataField *&Field
   )
 {
-  SVfrDataField  *pField = NULL;
+  std::unordered_map<std::string, SVfrDataField *>::iterator Iter;
 
   if ((FName == NULL) || (Type == NULL)) {
     return VFR_RETURN_FATAL_ERROR;
   }
 
-  for (pField = Type->mMembers; pField != NULL; pField = pField->mNext) {
-    //
-    // For type EFI_IFR_TYPE_TIME, because field name is not correctly wrote,
-    // add code to adjust it.
-    //
-    if (Type->mType == EFI_IFR_TYPE_TIME) {
-      if (strcmp (FName, "Hour") == 0) {
-        FName = "Hours";
-      } else if (strcmp (FName, "Minute") == 0) {
-        FName = "Minuts";
-      } else if (strcmp (FName, "Second") == 0) {
-        FName = "Seconds";
-      }
+  //
+  // For type EFI_IFR_TYPE_TIME, because field name is not correctly wrote,
+  // add code to adjust it.
+  //
+  if (Type->mType == EFI_IFR_TYPE_TIME) {
+    if (strcmp (FName, "Hour") == 0) {
+      FName = "Hours";
+    } else if (strcmp (FName, "Minute") == 0) {
+      FName = "Minuts";
+    } else if (strcmp (FName, "Second") == 0) {
+      FName = "Seconds";
     }
+  }
 
-    if (strcmp (pField->mFieldName, FName) == 0) {
-      Field = pField;
-      return VFR_RETURN_SUCCESS;
-    }
+  Iter = Type->mFieldIndex.find (FName);
+  if (Iter == Type->mFieldIndex.end ()) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  Field = Iter->second;
+  return VFR_RETURN_SUCCESS;
 }
 
 EFI_VFR_RETURN_CODE
@@ -820,8 +833,9 @@ CVfrVarDataTypeDB::InternalTypesListInit (
   VOID
   )
 {
-  SVfrDataType *New   = NULL;
-  UINT32       Index;
+  SVfrDataType  *New   = NULL;
+  SVfrDataField *pField;
+  UINT32        Index;
 
   for (Index = 0; gInternalTypesTable[Index].mTypeName != NULL; Index++) {
     New                 = new SVfrDataType;
@@ -924,6 +938,9 @@ CVfrVarDataTypeDB::InternalTypesListInit (
       } else {
         New->mMembers            = NULL;
       }
+      for (pField = New->mMembers; pField != NULL; pField = pField->mNext) {
+        IndexTypeField (New, pField);
+      }
       New->mNext                 = NULL;
       RegisterNewType (New);
       New                        = NULL;
@@ -1046,6 +1063,7 @@ CVfrVarDataTypeDB::DeclareDataTypeBegin (
   pNewType->mHasBitField = FALSE;
 
   mNewDataType           = pNewType;
+  mCurrDataField         = NULL;
 }
 
 EFI_VFR_RETURN_CODE
@@ -1053,8 +1071,6 @@ CVfrVarDataTypeDB::SetNewTypeName (
   IN CHAR8   *TypeName
   )
 {
-  SVfrDataType *pType;
-
   if (mNewDataType == NULL) {
     return VFR_RETURN_ERROR_SKIPED;
   }
@@ -1065,10 +1081,8 @@ CVfrVarDataTypeDB::SetNewTypeName (
     return VFR_RETURN_INVALID_PARAMETER;
   }
 
-  for (pType = mDataTypeList; pType != NULL; pType = pType->mNext) {
-    if (strcmp(pType->mTypeName, TypeName) == 0) {
-      return VFR_RETURN_REDEFINED;
-    }
+  if (mDataTypeIndex.find (TypeName) != mDataTypeIndex.end ()) {
+    return VFR_RETURN_REDEFINED;
   }
 
   strncpy(mNewDataType->mTypeName, TypeName, MAX_NAME_LEN - 1);
@@ -1118,10 +1132,8 @@ CVfrVarDataTypeDB::DataTypeAddBitField (
     return VFR_RETURN_INVALID_PARAMETER;
   }
 
-  for (pTmp = mNewDataType->mMembers; pTmp != NULL; pTmp = pTmp->mNext) {
-    if (FieldName != NULL && strcmp (pTmp->mFieldName, FieldName) == 0) {
-      return VFR_RETURN_REDEFINED;
-    }
+  if (FieldName != NULL && mNewDataType->mFieldIndex.find (FieldName) != mNewDataType->mFieldIndex.end ()) {
+    return VFR_RETURN_REDEFINED;
   }
 
   Align = MIN (mPackAlign, pFieldType->mAlign);
@@ -1135,6 +1147,8 @@ CVfrVarDataTypeDB::DataTypeAddBitField (
   if (FieldName != NULL) {
     strncpy (pNewField->mFieldName, FieldName, MAX_NAME_LEN - 1);
     pNewField->mFieldName[MAX_NAME_LEN - 1] = 0;
+  } else {
+    pNewField->mFieldName[0] = 0;
   }
   pNewField->mFieldType    = pFieldType;
   pNewField->mIsBitField   = TRUE;
@@ -1143,15 +1157,21 @@ CVfrVarDataTypeDB::DataTypeAddBitField (
   pNewField->mBitOffset    = 0;
   pNewField->mOffset       = 0;
 
+  //
+  // mCurrDataField tracks the last member of mNewDataType.
+  //
+  pTmp = mCurrDataField;
   if (mNewDataType->mMembers == NULL) {
     mNewDataType->mMembers = pNewField;
     pNewField->mNext       = NULL;
   } else {
-    for (pTmp = mNewDataType->mMembers; pTmp->mNext != NULL; pTmp = pTmp->mNext)
-      ;
     pTmp->mNext            = pNewField;
     pNewField->mNext       = NULL;
   }
+  mCurrDataField = pNewField;
+  if (FieldName != NULL) {
+    IndexTypeField (mNewDataType, pNewField);
+  }
 
   if (FieldInUnion) {
     pNewField->mOffset = 0;
@@ -1206,7 +1226,6 @@ CVfrVarDataTypeDB::DataTypeAddField (
 {
   SVfrDataField       *pNewField  = NULL;
   SVfrDataType        *pFieldType = NULL;
-  SVfrDataField       *pTmp;
   UINT32              Align;
   UINT32              MaxDataTypeSize;
 
@@ -1217,10 +1236,8 @@ CVfrVarDataTypeDB::DataTypeAddField (
    return VFR_RETURN_INVALID_PARAMETER;
   }
 
-  for (pTmp = mNewDataType->mMembers; pTmp != NULL; pTmp = pTmp->mNext) {
-    if (strcmp (pTmp->mFieldName, FieldName) == 0) {
-      return VFR_RETURN_REDEFINED;
-    }
+  if (mNewDataType->mFieldIndex.find (FieldName) != mNewDataType->mFieldIndex.end ()) {
+    return VFR_RETURN_REDEFINED;
   }
 
   Align = MIN (mPackAlign, pFieldType->mAlign);
@@ -1242,11 +1259,11 @@ CVfrVarDataTypeDB::DataTypeAddField (
     mNewDataType->mMembers = pNewField;
     pNewField->mNext       = NULL;
   } else {
-    for (pTmp = mNewDataType->mMembers; pTmp->mNext != NULL; pTmp = pTmp->mNext)
-      ;
-    pTmp->mNext            = pNewField;
+    mCurrDataField->mNext  = pNewField;
     pNewField->mNext       = NULL;
   }
+  mCurrDataField = pNewField;
+  IndexTypeField (mNewDataType, pNewField);
 
   mNewDataType->mAlign     = MIN (mPackAlign, MAX (pFieldType->mAlign, mNewDataType->mAlign));
 
@@ -1289,7 +1306,7 @@ CVfrVarDataTypeDB::GetDataType (
   OUT SVfrDataType **DataType
   )
 {
-  SVfrDataType *pDataType = NULL;
+  std::unordered_map<std::string, SVfrDataType *>::iterator Iter;
 
   if (TypeName == NULL) {
     return VFR_RETURN_ERROR_SKIPED;
@@ -1301,14 +1318,13 @@ CVfrVarDataTypeDB::GetDataType (
 
   *DataType = NULL;
 
-  for (pDataType = mDataTypeList; pDataType != NULL; pDataType = pDataType->mNext) {
-    if (strcmp (TypeName, pDataType->mTypeName) == 0) {
-      *DataType = pDataType;
-      return VFR_RETURN_SUCCESS;
-    }
+  Iter = mDataTypeIndex.find (TypeName);
+  if (Iter == mDataTypeIndex.end ()) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  *DataType = Iter->second;
+  return VFR_RETURN_SUCCESS;
 }
 
 EFI_VFR_RETURN_CODE
@@ -1357,14 +1373,12 @@ CVfrVarDataTypeDB::GetDataTypeSize (
 
   *Size = 0;
 
-  for (pDataType = mDataTypeList; pDataType != NULL; pDataType = pDataType->mNext) {
-    if (strcmp (TypeName, pDataType->mTypeName) == 0) {
-      *Size = pDataType->mTotalSize;
-      return VFR_RETURN_SUCCESS;
-    }
+  if (GetDataType (TypeName, &pDataType) != VFR_RETURN_SUCCESS) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  *Size = pDataType->mTotalSize;
+  return VFR_RETURN_SUCCESS;
 }
 
 EFI_VFR_RETURN_CODE
@@ -1458,19 +1472,11 @@ CVfrVarDataTypeDB::IsTypeNameDefined (
   IN CHAR8 *TypeName
   )
 {
-  SVfrDataType *pType;
-
   if (TypeName == NULL) {
     return FALSE;
   }
 
-  for (pType = mDataTypeList; pType != NULL; pType = pType->mNext) {
-    if (strcmp (pType->mTypeName, TypeName) == 0) {
-      return TRUE;
-    }
-  }
-
-  return FALSE;
+  return (BOOLEAN) (mDataTypeIndex.find (TypeName) != mDataTypeIndex.end ());
 }
 
 VOID
@@ -1727,6 +1733,68 @@ CVfrDataStorage::MarkVarStoreIdUnused (
   mFreeVarStoreIdBitMap[Index] &= ~(0x80000000 >> Offset);
 }
 
+/**
+  Return the position of the varstore list holding this node in the search
+  order used by the lookups: buffer, EFI, then name varstores.
+**/
+STATIC
+UINT32
+VarStoreListRank (
+  IN SVfrVarStorageNode *pNode
+  )
+{
+  switch (pNode->mVarStoreType) {
+  case EFI_VFR_VARSTORE_EFI:
+    return 1;
+  case EFI_VFR_VARSTORE_NAME:
+    return 2;
+  default:
+    return 0;
+  }
+}
+
+VOID
+CVfrDataStorage::IndexVarStore (
+  IN SVfrVarStorageNode *pNode
+  )
+{
+  std::vector<SVfrVarStorageNode *>           &NameNodes = mVarStoreNameIndex[pNode->mVarStoreName];
+  std::vector<SVfrVarStorageNode *>::iterator Iter;
+
+  mVarStoreIdIndex[pNode->mVarStoreId] = pNode;
+
+  //
+  // New nodes are pushed at the head of their list, so place this one ahead
+  // of every node from the same list or from a list searched after it.
+  //
+  for (Iter = NameNodes.begin (); Iter != NameNodes.end (); Iter++) {
+    if (VarStoreListRank (*Iter) >= VarStoreListRank (pNode)) {
+      break;
+    }
+  }
+  NameNodes.insert (Iter, pNode);
+
+  if (VarStoreListRank (pNode) == 0) {
+    std::vector<SVfrVarStorageNode *> &TypeNodes = mBufferVarStoreTypeIndex[pNode->mStorageInfo.mDataType->mTypeName];
+    TypeNodes.insert (TypeNodes.begin (), pNode);
+  }
+}
+
+SVfrVarStorageNode *
+CVfrDataStorage::FindVarStoreById (
+  IN EFI_VARSTORE_ID VarStoreId
+  )
+{
+  std::unordered_map<EFI_VARSTORE_ID, SVfrVarStorageNode *>::iterator Iter;
+
+  Iter = mVarStoreIdIndex.find (VarStoreId);
+  if (Iter == mVarStoreIdIndex.end ()) {
+    return NULL;
+  }
+
+  return Iter->second;
+}
+
 EFI_VFR_RETURN_CODE
 CVfrDataStorage::DeclareNameVarStoreBegin (
   IN CHAR8           *StoreName,
@@ -1795,6 +1863,7 @@ CVfrDataStorage::DeclareNameVarStoreEnd (
   mNewVarStorageNode->mGuid = *Guid;
   mNewVarStorageNode->mNext = mNameVarStoreList;
   mNameVarStoreList         = mNewVarStorageNode;
+  IndexVarStore (mNewVarStorageNode);
 
   mNewVarStorageNode        = NULL;
 
@@ -1832,6 +1901,7 @@ CVfrDataStorage::DeclareEfiVarStore (
 
   pNode->mNext       = mEfiVarStoreList;
   mEfiVarStoreList   = pNode;
+  IndexVarStore (pNode);
 
   return VFR_RETURN_SUCCESS;
 }
@@ -1876,6 +1946,7 @@ CVfrDataStorage::DeclareBufferVarStore (
 
   pNew->mNext         = mBufferVarStoreList;
   mBufferVarStoreList = pNew;
+  IndexVarStore (pNew);
 
   if (gCVfrBufferConfig.Register(StoreName, Guid) != 0) {
     return VFR_RETURN_FATAL_ERROR;
@@ -1893,12 +1964,17 @@ CVfrDataStorage::GetVarStoreByDataType (
 {
   SVfrVarStorageNode    *pNode;
   SVfrVarStorageNode    *MatchNode;
+  UINT32                Index;
+  std::unordered_map<std::string, std::vector<SVfrVarStorageNode *> >::iterator Iter;
 
   MatchNode = NULL;
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mStorageInfo.mDataType->mTypeName, DataTypeName) != 0) {
-      continue;
-    }
+  Iter = mBufferVarStoreTypeIndex.find (DataTypeName);
+  if (Iter == mBufferVarStoreTypeIndex.end ()) {
+    return VFR_RETURN_UNDEFINED;
+  }
+
+  for (Index = 0; Index < Iter->second.size (); Index++) {
+    pNode = Iter->second[Index];
 
     if ((VarGuid != NULL)) {
       if (memcmp (VarGuid, &pNode->mGuid, sizeof (EFI_GUID)) == 0) {
@@ -1986,29 +2062,19 @@ CVfrDataStorage::GetVarStoreId (
   EFI_VFR_RETURN_CODE   ReturnCode;
   SVfrVarStorageNode    *pNode;
   BOOLEAN               HasFoundOne = FALSE;
+  UINT32                Index;
+  std::unordered_map<std::string, std::vector<SVfrVarStorageNode *> >::iterator Iter;
 
   mCurrVarStorageNode = NULL;
+  pNode               = NULL;
 
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mVarStoreName, StoreName) == 0) {
-      if (CheckGuidField(pNode, StoreGuid, &HasFoundOne, &ReturnCode)) {
-        *VarStoreId = mCurrVarStorageNode->mVarStoreId;
-        return ReturnCode;
-      }
-    }
-  }
-
-  for (pNode = mEfiVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mVarStoreName, StoreName) == 0) {
-      if (CheckGuidField(pNode, StoreGuid, &HasFoundOne, &ReturnCode)) {
-        *VarStoreId = mCurrVarStorageNode->mVarStoreId;
-        return ReturnCode;
-      }
-    }
-  }
-
-  for (pNode = mNameVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mVarStoreName, StoreName) == 0) {
+  //
+  // The index keeps the buffer, EFI, name varstore search order.
+  //
+  Iter = mVarStoreNameIndex.find (StoreName);
+  if (Iter != mVarStoreNameIndex.end ()) {
+    for (Index = 0; Index < Iter->second.size (); Index++) {
+      pNode = Iter->second[Index];
       if (CheckGuidField(pNode, StoreGuid, &HasFoundOne, &ReturnCode)) {
         *VarStoreId = mCurrVarStorageNode->mVarStoreId;
         return ReturnCode;
@@ -2047,14 +2113,13 @@ CVfrDataStorage::GetBufferVarStoreDataTypeName (
     return VFR_RETURN_FATAL_ERROR;
   }
 
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      *DataTypeName = pNode->mStorageInfo.mDataType->mTypeName;
-      return VFR_RETURN_SUCCESS;
-    }
+  pNode = FindVarStoreById (VarStoreId);
+  if ((pNode == NULL) || (VarStoreListRank (pNode) != 0)) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  *DataTypeName = pNode->mStorageInfo.mDataType->mTypeName;
+  return VFR_RETURN_SUCCESS;
 }
 
 EFI_VFR_VARSTORE_TYPE
@@ -2071,25 +2136,9 @@ CVfrDataStorage::GetVarStoreType (
     return VarStoreType;
   }
 
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarStoreType = pNode->mVarStoreType;
-      return VarStoreType;
-    }
-  }
-
-  for (pNode = mEfiVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarStoreType = pNode->mVarStoreType;
-      return VarStoreType;
-    }
-  }
-
-  for (pNode = mNameVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarStoreType = pNode->mVarStoreType;
-      return VarStoreType;
-    }
+  pNode = FindVarStoreById (VarStoreId);
+  if (pNode != NULL) {
+    VarStoreType = pNode->mVarStoreType;
   }
 
   return VarStoreType;
@@ -2109,25 +2158,9 @@ CVfrDataStorage::GetVarStoreGuid (
     return VarGuid;
   }
 
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarGuid = &pNode->mGuid;
-      return VarGuid;
-    }
-  }
-
-  for (pNode = mEfiVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarGuid = &pNode->mGuid;
-      return VarGuid;
-    }
-  }
-
-  for (pNode = mNameVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      VarGuid = &pNode->mGuid;
-      return VarGuid;
-    }
+  pNode = FindVarStoreById (VarStoreId);
+  if (pNode != NULL) {
+    VarGuid = &pNode->mGuid;
   }
 
   return VarGuid;
@@ -2145,25 +2178,10 @@ CVfrDataStorage::GetVarStoreName (
     return VFR_RETURN_FATAL_ERROR;
   }
 
-  for (pNode = mBufferVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      *VarStoreName = pNode->mVarStoreName;
-      return VFR_RETURN_SUCCESS;
-    }
-  }
-
-  for (pNode = mEfiVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      *VarStoreName = pNode->mVarStoreName;
-      return VFR_RETURN_SUCCESS;
-    }
-  }
-
-  for (pNode = mNameVarStoreList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mVarStoreId == VarStoreId) {
-      *VarStoreName = pNode->mVarStoreName;
-      return VFR_RETURN_SUCCESS;
-    }
+  pNode = FindVarStoreById (VarStoreId);
+  if (pNode != NULL) {
+    *VarStoreName = pNode->mVarStoreName;
+    return VFR_RETURN_SUCCESS;
   }
 
   *VarStoreName = NULL;
@@ -2789,6 +2807,45 @@ CVfrQuestionDB::ResetInit(
   // Question ID 0 is reserved.
   mFreeQIdBitMap[0] = 0x80000000;
   mQuestionList     = NULL;
+
+  ClearQuestionIndex ();
+}
+
+/**
+  Add newly linked question nodes to the lookup indexes.
+
+  @param  Nodes  The nodes just pushed at the head of mQuestionList, in list order.
+  @param  Count  The number of nodes.
+
+**/
+VOID
+CVfrQuestionDB::IndexQuestions (
+  IN SVfrQuestionNode **Nodes,
+  IN UINT32           Count
+  )
+{
+  SVfrQuestionNode *pNode;
+
+  //
+  // Nodes[0] is the list head, so it is indexed last to end up as the newest
+  // entry of each vector.
+  //
+  while (Count > 0) {
+    pNode = Nodes[--Count];
+    mQuestionNameIndex[pNode->mName].push_back (pNode);
+    mQuestionVarIdIndex[pNode->mVarIdStr].push_back (pNode);
+    mQuestionIdIndex[pNode->mQuestionId].push_back (pNode);
+  }
+}
+
+VOID
+CVfrQuestionDB::ClearQuestionIndex (
+  VOID
+  )
+{
+  mQuestionNameIndex.clear ();
+  mQuestionVarIdIndex.clear ();
+  mQuestionIdIndex.clear ();
 }
 
 VOID
@@ -2833,6 +2890,7 @@ CVfrQuestionDB::RegisterQuestion (
 
   pNode->mNext       = mQuestionList;
   mQuestionList      = pNode;
+  IndexQuestions (&pNode, 1);
 
   gCFormPkg.DoPendingAssign (VarIdStr, (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
 
@@ -2883,6 +2941,7 @@ CVfrQuestionDB::RegisterOldDateQuestion (
   pNode[1]->mNext       = pNode[2];
   pNode[2]->mNext       = mQuestionList;
   mQuestionList         = pNode[0];
+  IndexQuestions (pNode, 3);
 
   gCFormPkg.DoPendingAssign (YearVarId, (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
   gCFormPkg.DoPendingAssign (MonthVarId, (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
@@ -2990,6 +3049,7 @@ CVfrQuestionDB::RegisterNewDateQuestion (
   pNode[1]->mNext       = pNode[2];
   pNode[2]->mNext       = mQuestionList;
   mQuestionList         = pNode[0];
+  IndexQuestions (pNode, 3);
 
   for (Index = 0; Index < 3; Index++) {
     if (VarIdStr[Index] != NULL) {
@@ -3061,6 +3121,7 @@ CVfrQuestionDB::RegisterOldTimeQuestion (
   pNode[1]->mNext       = pNode[2];
   pNode[2]->mNext       = mQuestionList;
   mQuestionList         = pNode[0];
+  IndexQuestions (pNode, 3);
 
   gCFormPkg.DoPendingAssign (HourVarId, (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
   gCFormPkg.DoPendingAssign (MinuteVarId, (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
@@ -3168,6 +3229,7 @@ CVfrQuestionDB::RegisterNewTimeQuestion (
   pNode[1]->mNext       = pNode[2];
   pNode[2]->mNext       = mQuestionList;
   mQuestionList         = pNode[0];
+  IndexQuestions (pNode, 3);
 
   for (Index = 0; Index < 3; Index++) {
     if (VarIdStr[Index] != NULL) {
@@ -3294,6 +3356,7 @@ CVfrQuestionDB::RegisterRefQuestion (
   pNode[2]->mNext       = pNode[3];
   pNode[3]->mNext       = mQuestionList;
   mQuestionList         = pNode[0];
+  IndexQuestions (pNode, 4);
 
   gCFormPkg.DoPendingAssign (VarIdStr[0], (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
   gCFormPkg.DoPendingAssign (VarIdStr[1], (VOID *)&QuestionId, sizeof(EFI_QUESTION_ID));
@@ -3321,6 +3384,7 @@ CVfrQuestionDB::UpdateQuestionId (
   )
 {
   SVfrQuestionNode *pNode = NULL;
+  std::unordered_map<EFI_QUESTION_ID, std::vector<SVfrQuestionNode *> >::iterator Iter;
 
   if (QId == NewQId) {
     // don't update
@@ -3331,16 +3395,15 @@ CVfrQuestionDB::UpdateQuestionId (
     return VFR_RETURN_REDEFINED;
   }
 
-  for (pNode = mQuestionList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mQuestionId == QId) {
-      break;
-    }
-  }
-
-  if (pNode == NULL) {
+  Iter = mQuestionIdIndex.find (QId);
+  if ((Iter == mQuestionIdIndex.end ()) || Iter->second.empty ()) {
     return VFR_RETURN_UNDEFINED;
   }
 
+  pNode = Iter->second.back ();
+  Iter->second.pop_back ();
+  mQuestionIdIndex[NewQId].push_back (pNode);
+
   MarkQuestionIdUnused (QId);
   pNode->mQuestionId = NewQId;
   MarkQuestionIdUsed (NewQId);
@@ -3359,7 +3422,9 @@ CVfrQuestionDB::GetQuestionId (
   OUT EFI_QUESION_TYPE  *QType
   )
 {
-  SVfrQuestionNode *pNode;
+  SVfrQuestionNode                                                        *pNode;
+  std::unordered_map<std::string, std::vector<SVfrQuestionNode *> >::iterator Iter;
+  UINT32                                                                  Index;
 
   QuestionId = EFI_QUESTION_ID_INVALID;
   BitMask    = 0x00000000;
@@ -3371,15 +3436,27 @@ CVfrQuestionDB::GetQuestionId (
     return ;
   }
 
-  for (pNode = mQuestionList; pNode != NULL; pNode = pNode->mNext) {
-    if (Name != NULL) {
-      if (strcmp (pNode->mName, Name) != 0) {
-        continue;
-      }
+  //
+  // Look up by the variable id when given, as it is the more selective key,
+  // then filter the candidates on the name. Candidates are scanned newest
+  // first, the order of mQuestionList.
+  //
+  if (VarIdStr != NULL) {
+    Iter = mQuestionVarIdIndex.find (VarIdStr);
+    if (Iter == mQuestionVarIdIndex.end ()) {
+      return ;
     }
+  } else {
+    Iter = mQuestionNameIndex.find (Name);
+    if (Iter == mQuestionNameIndex.end ()) {
+      return ;
+    }
+  }
 
-    if (VarIdStr != NULL) {
-      if (strcmp (pNode->mVarIdStr, VarIdStr) != 0) {
+  for (Index = (UINT32) Iter->second.size (); Index > 0; Index--) {
+    pNode = Iter->second[Index - 1];
+    if (Name != NULL) {
+      if (strcmp (pNode->mName, Name) != 0) {
         continue;
       }
     }
@@ -3400,19 +3477,18 @@ CVfrQuestionDB::FindQuestion (
   IN EFI_QUESTION_ID QuestionId
   )
 {
-  SVfrQuestionNode *pNode;
+  std::unordered_map<EFI_QUESTION_ID, std::vector<SVfrQuestionNode *> >::iterator Iter;
 
   if (QuestionId == EFI_QUESTION_ID_INVALID) {
     return VFR_RETURN_INVALID_PARAMETER;
   }
 
-  for (pNode = mQuestionList; pNode != NULL; pNode = pNode->mNext) {
-    if (pNode->mQuestionId == QuestionId) {
-      return VFR_RETURN_SUCCESS;
-    }
+  Iter = mQuestionIdIndex.find (QuestionId);
+  if ((Iter == mQuestionIdIndex.end ()) || Iter->second.empty ()) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  return VFR_RETURN_SUCCESS;
 }
 
 EFI_VFR_RETURN_CODE
@@ -3420,19 +3496,15 @@ CVfrQuestionDB::FindQuestion (
   IN CHAR8 *Name
   )
 {
-  SVfrQuestionNode *pNode;
-
   if (Name == NULL) {
     return VFR_RETURN_FATAL_ERROR;
   }
 
-  for (pNode = mQuestionList; pNode != NULL; pNode = pNode->mNext) {
-    if (strcmp (pNode->mName, Name) == 0) {
-      return VFR_RETURN_SUCCESS;
-    }
+  if (mQuestionNameIndex.find (Name) == mQuestionNameIndex.end ()) {
+    return VFR_RETURN_UNDEFINED;
   }
 
-  return VFR_RETURN_UNDEFINED;
+  return VFR_RETURN_SUCCESS;
 }
 
 CVfrStringDB::CVfrStringDB ()
@@ -11,6 +11,10 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #define _VFRUTILITYLIB_H_
 
 #include "string.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include "Common/UefiBaseTypes.h"
 #include "EfiVfr.h"
 #include "VfrError.h"
@@ -63,6 +67,8 @@ struct SConfigItem {
   SConfigInfo   *mInfoStrList;  // list of Offset/Value in the varstore
   SConfigItem   *mNext;
 
+  std::unordered_set<UINT16>  mInfoOffsetSet;  // offsets already in mInfoStrList
+
 public:
   SConfigItem (IN CHAR8 *, IN EFI_GUID *, IN CHAR8 *);
   SConfigItem (IN CHAR8 *, IN EFI_GUID *, IN CHAR8 *, IN UINT8, IN UINT16, IN UINT16, IN EFI_IFR_TYPE_VALUE);
@@ -125,6 +131,8 @@ struct SVfrDataType {
   BOOLEAN                   mHasBitField;
   SVfrDataField             *mMembers;
   SVfrDataType              *mNext;
+
+  std::unordered_map<std::string, SVfrDataField *> mFieldIndex;  // field name to first member with that name
 };
 
 #define VFR_PACK_ASSIGN     0x01
@@ -184,6 +192,7 @@ public:
 
 private:
   SVfrDataType              *mDataTypeList;
+  std::unordered_map<std::string, SVfrDataType *> mDataTypeIndex;
 
   SVfrDataType              *mNewDataType;
   SVfrDataType              *mCurrDataType;
@@ -191,6 +200,7 @@ private:
 
   VOID InternalTypesListInit (VOID);
   VOID RegisterNewType (IN SVfrDataType *);
+  VOID IndexTypeField (IN SVfrDataType *, IN SVfrDataField *);
 
   EFI_VFR_RETURN_CODE ExtractStructTypeName (IN CHAR8 *&, OUT CHAR8 *);
   EFI_VFR_RETURN_CODE GetTypeField (IN CONST CHAR8 *, IN SVfrDataType *, IN SVfrDataField *&);
@@ -315,6 +325,15 @@ private:
   struct SVfrVarStorageNode *mEfiVarStoreList;
   struct SVfrVarStorageNode *mNameVarStoreList;
 
+  //
+  // Lookup indexes over the three varstore lists. The node vectors keep the
+  // order in which the lists are searched: buffer, EFI, then name varstores,
+  // each newest first.
+  //
+  std::unordered_map<EFI_VARSTORE_ID, SVfrVarStorageNode *>            mVarStoreIdIndex;
+  std::unordered_map<std::string, std::vector<SVfrVarStorageNode *> >  mVarStoreNameIndex;
+  std::unordered_map<std::string, std::vector<SVfrVarStorageNode *> >  mBufferVarStoreTypeIndex;
+
   struct SVfrVarStorageNode *mCurrVarStorageNode;
   struct SVfrVarStorageNode *mNewVarStorageNode;
   BufferVarStoreFieldInfoNode    *mBufferFieldInfoListHead;
@@ -326,6 +345,8 @@ private:
   BOOLEAN         ChekVarStoreIdFree (IN EFI_VARSTORE_ID);
   VOID            MarkVarStoreIdUsed (IN EFI_VARSTORE_ID);
   VOID            MarkVarStoreIdUnused (IN EFI_VARSTORE_ID);
+  VOID            IndexVarStore (IN SVfrVarStorageNode *);
+  SVfrVarStorageNode * FindVarStoreById (IN EFI_VARSTORE_ID);
   EFI_VARSTORE_ID CheckGuidField (IN SVfrVarStorageNode *,
                                   IN EFI_GUID *,
                                   IN BOOLEAN *,
@@ -400,11 +421,21 @@ private:
   SVfrQuestionNode          *mQuestionList;
   UINT32                    mFreeQIdBitMap[EFI_FREE_QUESTION_ID_BITMAP_SIZE];
 
+  //
+  // Lookup indexes over mQuestionList. The node vectors are ordered oldest
+  // first, so the last element is the one a walk of mQuestionList finds first.
+  //
+  std::unordered_map<std::string, std::vector<SVfrQuestionNode *> >     mQuestionNameIndex;
+  std::unordered_map<std::string, std::vector<SVfrQuestionNode *> >     mQuestionVarIdIndex;
+  std::unordered_map<EFI_QUESTION_ID, std::vector<SVfrQuestionNode *> > mQuestionIdIndex;
+
 private:
   EFI_QUESTION_ID GetFreeQuestionId (VOID);
   BOOLEAN         ChekQuestionIdFree (IN EFI_QUESTION_ID);
   VOID            MarkQuestionIdUsed (IN EFI_QUESTION_ID);
   VOID            MarkQuestionIdUnused (IN EFI_QUESTION_ID);
+  VOID            IndexQuestions (IN SVfrQuestionNode **, IN UINT32);
+  VOID            ClearQuestionIndex (VOID);
 
 public:
   CVfrQuestionDB ();
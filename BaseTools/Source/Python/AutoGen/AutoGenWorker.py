@@ -16,13 +16,15 @@ import os
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 from AutoGen.AutoGen import AutoGen
 from Workspace.WorkspaceDatabase import BuildDB
+from Workspace.MetaFileTable import MetaFileTableStore
 try:
-    from queue import Empty
+    from queue import Empty, Queue
 except:
-    from Queue import Empty
+    from Queue import Empty, Queue
 import traceback
 import sys
 from AutoGen.DataPipe import MemoryDataPipe
+from Common.FileHashCache import LoadFileHashStore, GetNewFileHashes, MergeFileHashStore
 import logging
 import time
 
@@ -97,12 +99,15 @@ class LogAgent(threading.Thread):
     def kill(self):
         self.log_q.put(None)
 class AutoGenManager(threading.Thread):
-    def __init__(self,autogen_workers, feedback_q,error_event):
+    def __init__(self,autogen_workers, feedback_q,error_event,report_done=False):
         super(AutoGenManager,self).__init__()
         self.autogen_workers = autogen_workers
         self.feedback_q = feedback_q
         self.Status = True
         self.error_event = error_event
+        # (MetaFilePath, Arch) of the modules whose AutoGen is done
+        self.report_done = report_done
+        self.done_q = Queue()
     def run(self):
         try:
             fin_num = 0
@@ -110,7 +115,10 @@ class AutoGenManager(threading.Thread):
                 badnews = self.feedback_q.get()
                 if badnews is None:
                     break
-                if badnews == "Done":
+                if isinstance(badnews, tuple):
+                    if self.report_done:
+                        self.done_q.put(badnews)
+                elif badnews == "Done":
                     fin_num += 1
                 elif badnews == "QueueEmpty":
                     EdkLogger.debug(EdkLogger.DEBUG_9, "Worker %s: %s" % (os.getpid(), badnews))
@@ -141,6 +149,9 @@ class AutoGenManager(threading.Thread):
                 item = cacheq.get()
                 if item == "CacheDone":
                     cache_num += 1
+                elif isinstance(item, dict):
+                    # The file digests a worker added to the hash store
+                    MergeFileHashStore(item)
                 else:
                     GlobalData.gModuleAllCacheStatus.add(item)
                 if cache_num  == len(self.autogen_workers):
@@ -203,6 +214,7 @@ class AutoGenWorkerInProcess(mp.Process):
             GlobalData.gDisableIncludePathCheck = False
             GlobalData.gFdfParser = self.data_pipe.Get("FdfParser")
             GlobalData.gDatabasePath = self.data_pipe.Get("DatabasePath")
+            MetaFileTableStore.Load(GlobalData.gDatabasePath)
 
             GlobalData.gUseHashCache = self.data_pipe.Get("UseHashCache")
             GlobalData.gBinCacheSource = self.data_pipe.Get("BinCacheSource")
@@ -214,7 +226,11 @@ class AutoGenWorkerInProcess(mp.Process):
             GlobalData.gCMakeHashFile = dict()
             GlobalData.gModuleHashFile = dict()
             GlobalData.gFileHashDict = dict()
+            GlobalData.gFileHashStore = self.data_pipe.Get("FileHashStore")
+            if GlobalData.gUseHashCache and GlobalData.gFileHashStore:
+                LoadFileHashStore(GlobalData.gFileHashStore)
             GlobalData.gEnableGenfdsMultiThread = self.data_pipe.Get("EnableGenfdsMultiThread")
+            GlobalData.gEnableGenfdsCache = self.data_pipe.Get("EnableGenfdsCache")
             GlobalData.file_lock = self.file_lock
             CommandTarget = self.data_pipe.Get("CommandTarget")
             pcd_from_build_option = []
@@ -293,6 +309,8 @@ class AutoGenWorkerInProcess(mp.Process):
                         continue
                     else:
                         self.cache_q.put((Ma.MetaFile.Path, Ma.Arch, "MakeCache", False))
+                # Tell the main process the module can be built
+                self.feedback_q.put((Ma.MetaFile.Path, Ma.Arch))
 
         except Exception as e:
             EdkLogger.debug(EdkLogger.DEBUG_9, "Worker %s: %s" % (os.getpid(), str(e)))
@@ -300,6 +318,8 @@ class AutoGenWorkerInProcess(mp.Process):
         finally:
             EdkLogger.debug(EdkLogger.DEBUG_9, "Worker %s: %s" % (os.getpid(), "Done"))
             self.feedback_q.put("Done")
+            if GlobalData.gUseHashCache and GlobalData.gFileHashStore:
+                self.cache_q.put(GetNewFileHashes())
             self.cache_q.put("CacheDone")
 
     def printStatus(self):
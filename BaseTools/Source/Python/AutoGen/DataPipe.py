@@ -162,8 +162,12 @@ class MemoryDataPipe(DataPipe):
 
         self.DataContainer = {"UseHashCache":GlobalData.gUseHashCache}
 
+        self.DataContainer = {"FileHashStore":GlobalData.gFileHashStore}
+
         self.DataContainer = {"BinCacheSource":GlobalData.gBinCacheSource}
 
         self.DataContainer = {"BinCacheDest":GlobalData.gBinCacheDest}
 
         self.DataContainer = {"EnableGenfdsMultiThread":GlobalData.gEnableGenfdsMultiThread}
+
+        self.DataContainer = {"EnableGenfdsCache":GlobalData.gEnableGenfdsCache}
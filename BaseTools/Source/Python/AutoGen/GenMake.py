@@ -1610,6 +1610,8 @@ class TopLevelMakefile(BuildFile):
             ExtraOption += " -c"
         if not GlobalData.gEnableGenfdsMultiThread:
             ExtraOption += " --no-genfds-multi-thread"
+        if not GlobalData.gEnableGenfdsCache:
+            ExtraOption += " --no-genfds-cache"
         if GlobalData.gIgnoreSource:
             ExtraOption += " --ignore-sources"
 
@@ -25,6 +25,7 @@ from GenPatchPcdTable.GenPatchPcdTable import parsePcdInfoFromMapFile
 from Workspace.MetaFileCommentParser import UsageList
 from .GenPcdDb import CreatePcdDatabaseCode
 from Common.caching import cached_class_function
+from Common.FileHashCache import GetFileHash, HashCachePath, HashCacheRealPath
 from AutoGen.ModuleAutoGenHelper import PlatformInfo,WorkSpaceInfo
 import json
 import tempfile
@@ -1723,7 +1724,7 @@ class ModuleAutoGen(AutoGen):
             Ma = self.BuildDatabase[self.MetaFile, self.Arch, self.BuildTarget, self.ToolChain]
             self.OutputFile = Ma.Binaries
         for File in self.OutputFile:
-            if File.startswith(os.path.abspath(self.FfsOutputDir)+os.sep):
+            if self.FfsOutputDir and File.startswith(os.path.abspath(self.FfsOutputDir)+os.sep):
                 self.CacheCopyFile(CacheFfsDir, self.FfsOutputDir, File)
             else:
                 if  self.Name + ".autogen.hash." in File or \
@@ -1910,13 +1911,12 @@ class ModuleAutoGen(AutoGen):
         FileList = []
         m = hashlib.md5()
         for File in sorted(DependencyFileSet, key=lambda x: str(x)):
-            if not path.exists(LongFilePath(str(File))):
+            Digest = GetFileHash(File)
+            if Digest is None:
                 EdkLogger.quiet("[cache warning]: header file %s is missing for module: %s[%s]" % (File, self.MetaFile.Path, self.Arch))
                 continue
-            with open(LongFilePath(str(File)), 'rb') as f:
-                Content = f.read()
-            m.update(Content)
-            FileList.append((str(File), hashlib.md5(Content).hexdigest()))
+            m.update(Digest.encode('utf-8'))
+            FileList.append((HashCachePath(File), Digest))
 
         HashChainFile = path.join(self.BuildDir, self.Name + ".autogen.hashchain." + m.hexdigest())
         GlobalData.gCMakeHashFile[(self.MetaFile.Path, self.Arch)] = HashChainFile
@@ -1970,13 +1970,12 @@ class ModuleAutoGen(AutoGen):
             # included in .autogen.hash. file
             if BuildDirStr in path.abspath(File).lower():
                 continue
-            if not path.exists(LongFilePath(File)):
+            Digest = GetFileHash(File)
+            if Digest is None:
                 EdkLogger.quiet("[cache warning]: header file %s is missing for module: %s[%s]" % (File, self.MetaFile.Path, self.Arch))
                 continue
-            with open(LongFilePath(File), 'rb') as f:
-                Content = f.read()
-            m.update(Content)
-            FileList.append((File, hashlib.md5(Content).hexdigest()))
+            m.update(Digest.encode('utf-8'))
+            FileList.append((HashCachePath(File), Digest))
 
         HashChainFile = path.join(self.BuildDir, self.Name + ".hashchain." + m.hexdigest())
         GlobalData.gModuleHashFile[(self.MetaFile.Path, self.Arch)] = HashChainFile
@@ -2005,8 +2004,8 @@ class ModuleAutoGen(AutoGen):
         # Add Platform level hash
         HashFile = GlobalData.gPlatformHashFile
         if path.exists(LongFilePath(HashFile)):
-            FileList.append(HashFile)
-            m.update(HashFile.encode('utf-8'))
+            FileList.append(HashCachePath(HashFile))
+            m.update(HashCachePath(HashFile).encode('utf-8'))
         else:
             EdkLogger.quiet("[cache warning]: No Platform HashFile: %s" % HashFile)
 
@@ -2018,8 +2017,8 @@ class ModuleAutoGen(AutoGen):
                     continue
                 HashFile = GlobalData.gPackageHashFile[(Pkg.PackageName, Pkg.Arch)]
                 if path.exists(LongFilePath(HashFile)):
-                    FileList.append(HashFile)
-                    m.update(HashFile.encode('utf-8'))
+                    FileList.append(HashCachePath(HashFile))
+                    m.update(HashCachePath(HashFile).encode('utf-8'))
                 else:
                     EdkLogger.quiet("[cache warning]:No Package HashFile: %s" % HashFile)
 
@@ -2032,8 +2031,8 @@ class ModuleAutoGen(AutoGen):
         else:
             EdkLogger.quiet("[cache error]:No ModuleHashFile for module: %s[%s]" % (self.MetaFile.Path, self.Arch))
         if path.exists(LongFilePath(HashFile)):
-            FileList.append(HashFile)
-            m.update(HashFile.encode('utf-8'))
+            FileList.append(HashCachePath(HashFile))
+            m.update(HashCachePath(HashFile).encode('utf-8'))
         else:
             EdkLogger.quiet("[cache warning]:No Module HashFile: %s" % HashFile)
 
@@ -2046,8 +2045,8 @@ class ModuleAutoGen(AutoGen):
                 else:
                     EdkLogger.quiet("[cache error]:No ModuleHashFile for lib: %s[%s]" % (Lib.MetaFile.Path, Lib.Arch))
                 if path.exists(LongFilePath(HashFile)):
-                    FileList.append(HashFile)
-                    m.update(HashFile.encode('utf-8'))
+                    FileList.append(HashCachePath(HashFile))
+                    m.update(HashCachePath(HashFile).encode('utf-8'))
                 else:
                     EdkLogger.quiet("[cache warning]:No Lib HashFile: %s" % HashFile)
 
@@ -2072,8 +2071,8 @@ class ModuleAutoGen(AutoGen):
         # Add AutoGen hash
         HashFile = GlobalData.gCMakeHashFile[(self.MetaFile.Path, self.Arch)]
         if path.exists(LongFilePath(HashFile)):
-            FileList.append(HashFile)
-            m.update(HashFile.encode('utf-8'))
+            FileList.append(HashCachePath(HashFile))
+            m.update(HashCachePath(HashFile).encode('utf-8'))
         else:
             EdkLogger.quiet("[cache warning]:No AutoGen HashFile: %s" % HashFile)
 
@@ -2083,8 +2082,8 @@ class ModuleAutoGen(AutoGen):
         else:
             EdkLogger.quiet("[cache error]:No ModuleHashFile for module: %s[%s]" % (self.MetaFile.Path, self.Arch))
         if path.exists(LongFilePath(HashFile)):
-            FileList.append(HashFile)
-            m.update(HashFile.encode('utf-8'))
+            FileList.append(HashCachePath(HashFile))
+            m.update(HashCachePath(HashFile).encode('utf-8'))
         else:
             EdkLogger.quiet("[cache warning]:No Module HashFile: %s" % HashFile)
 
@@ -2096,8 +2095,8 @@ class ModuleAutoGen(AutoGen):
                 else:
                     EdkLogger.quiet("[cache error]:No ModuleHashFile for lib: %s[%s]" % (Lib.MetaFile.Path, Lib.Arch))
                 if path.exists(LongFilePath(HashFile)):
-                    FileList.append(HashFile)
-                    m.update(HashFile.encode('utf-8'))
+                    FileList.append(HashCachePath(HashFile))
+                    m.update(HashCachePath(HashFile).encode('utf-8'))
                 else:
                     EdkLogger.quiet("[cache warning]:No Lib HashFile: %s" % HashFile)
 
@@ -2115,7 +2114,7 @@ class ModuleAutoGen(AutoGen):
         # all hashchain files content
         HashStr = HashChainFile.split('.')[-1]
         if len(HashStr) != 32:
-            EdkLogger.quiet("[cache error]: wrong format HashChainFile:%s" % (File))
+            EdkLogger.quiet("[cache error]: wrong format HashChainFile:%s" % (HashChainFile))
             return False
 
         try:
@@ -2128,19 +2127,18 @@ class ModuleAutoGen(AutoGen):
         # Print the different file info
         # print(HashChainFile)
         for idx, (SrcFile, SrcHash) in enumerate (HashChainList):
+            # Workspace relative paths are resolved against the current workspace
+            SrcFile = HashCacheRealPath(SrcFile)
             if SrcFile in GlobalData.gFileHashDict:
                 DestHash = GlobalData.gFileHashDict[SrcFile]
             else:
-                try:
-                    with open(LongFilePath(SrcFile), 'rb') as f:
-                        Content = f.read()
-                        DestHash = hashlib.md5(Content).hexdigest()
-                        GlobalData.gFileHashDict[SrcFile] = DestHash
-                except IOError as X:
+                DestHash = GetFileHash(SrcFile)
+                if DestHash is None:
                     # cache miss if SrcFile is removed in new version code
                     GlobalData.gFileHashDict[SrcFile] = 0
                     EdkLogger.quiet("[cache insight]: first cache miss file in %s is %s" % (HashChainFile, SrcFile))
                     return False
+                GlobalData.gFileHashDict[SrcFile] = DestHash
             if SrcHash != DestHash:
                 EdkLogger.quiet("[cache insight]: first cache miss file in %s is %s" % (HashChainFile, SrcFile))
                 return False
@@ -2216,13 +2214,16 @@ class ModuleAutoGen(AutoGen):
                 elif HashChainStatus == True:
                     continue
                 # Convert to path start with cache source dir
-                RelativePath = os.path.relpath(HashChainFile, self.WorkspaceDir)
+                if os.path.isabs(HashChainFile):
+                    RelativePath = os.path.relpath(HashChainFile, self.WorkspaceDir)
+                else:
+                    RelativePath = HashChainFile
                 NewFilePath = os.path.join(GlobalData.gBinCacheSource, RelativePath)
                 if self.CheckHashChainFile(NewFilePath):
                     GlobalData.gHashChainStatus[HashChainFile] = True
                     # Save the module self HashFile for GenPreMakefileHashList later usage
                     if self.Name + ".hashchain." in HashChainFile:
-                        GlobalData.gModuleHashFile[(self.MetaFile.Path, self.Arch)] = HashChainFile
+                        GlobalData.gModuleHashFile[(self.MetaFile.Path, self.Arch)] = HashCacheRealPath(HashChainFile)
                 else:
                     GlobalData.gHashChainStatus[HashChainFile] = False
                     HashMiss = True
@@ -2317,11 +2318,11 @@ class ModuleAutoGen(AutoGen):
                     break
                 elif HashChainStatus == True:
                     continue
-                if self.CheckHashChainFile(HashChainFile):
+                if self.CheckHashChainFile(HashCacheRealPath(HashChainFile)):
                     GlobalData.gHashChainStatus[HashChainFile] = True
                     # Save the module self HashFile for GenPreMakefileHashList later usage
                     if self.Name + ".hashchain." in HashChainFile:
-                        GlobalData.gModuleHashFile[(self.MetaFile.Path, self.Arch)] = HashChainFile
+                        GlobalData.gModuleHashFile[(self.MetaFile.Path, self.Arch)] = HashCacheRealPath(HashChainFile)
                 else:
                     GlobalData.gHashChainStatus[HashChainFile] = False
                     HashMiss = True
@@ -2376,7 +2377,10 @@ class ModuleAutoGen(AutoGen):
                 elif HashChainStatus == True:
                     continue
                 # Convert to path start with cache source dir
-                RelativePath = os.path.relpath(HashChainFile, self.WorkspaceDir)
+                if os.path.isabs(HashChainFile):
+                    RelativePath = os.path.relpath(HashChainFile, self.WorkspaceDir)
+                else:
+                    RelativePath = HashChainFile
                 NewFilePath = os.path.join(GlobalData.gBinCacheSource, RelativePath)
                 if self.CheckHashChainFile(NewFilePath):
                     GlobalData.gHashChainStatus[HashChainFile] = True
@@ -23,6 +23,7 @@ from Common.StringUtils import NormPath
 from Common.BuildToolError import *
 from Common.DataType import *
 from Common.Misc import *
+from Common.FileHashCache import GetFileHash, HashCachePath
 import json
 
 ## Regular expression for splitting Dependency Expression string into tokens
@@ -574,11 +575,11 @@ class WorkspaceAutoGen(AutoGen):
             for file in AllWorkSpaceMetaFileList:
                 if file.endswith('.dec'):
                     continue
-                f = open(file, 'rb')
-                Content = f.read()
-                f.close()
-                m.update(Content)
-                FileList.append((str(file), hashlib.md5(Content).hexdigest()))
+                Digest = GetFileHash(file)
+                if Digest is None:
+                    continue
+                m.update(Digest.encode('utf-8'))
+                FileList.append((HashCachePath(file), Digest))
 
             HashDir = path.join(self.BuildDir, "Hash_Platform")
             HashFile = path.join(HashDir, 'Platform.hash.' + m.hexdigest())
@@ -621,22 +622,22 @@ class WorkspaceAutoGen(AutoGen):
         FileList = []
         m = hashlib.md5()
         # Get .dec file's hash value
-        f = open(Pkg.MetaFile.Path, 'rb')
-        Content = f.read()
-        f.close()
-        m.update(Content)
-        FileList.append((str(Pkg.MetaFile.Path), hashlib.md5(Content).hexdigest()))
+        Digest = GetFileHash(Pkg.MetaFile.Path)
+        if Digest is None:
+            EdkLogger.error("build", FILE_READ_FAILURE, "Failed to hash the package file", ExtraData=Pkg.MetaFile.Path)
+        m.update(Digest.encode('utf-8'))
+        FileList.append((HashCachePath(Pkg.MetaFile.Path), Digest))
         # Get include files hash value
         if Pkg.Includes:
             for inc in sorted(Pkg.Includes, key=lambda x: str(x)):
                 for Root, Dirs, Files in os.walk(str(inc)):
                     for File in sorted(Files):
                         File_Path = os.path.join(Root, File)
-                        f = open(File_Path, 'rb')
-                        Content = f.read()
-                        f.close()
-                        m.update(Content)
-                        FileList.append((str(File_Path), hashlib.md5(Content).hexdigest()))
+                        Digest = GetFileHash(File_Path)
+                        if Digest is None:
+                            continue
+                        m.update(Digest.encode('utf-8'))
+                        FileList.append((HashCachePath(File_Path), Digest))
         GlobalData.gPackageHash[Pkg.PackageName] = m.hexdigest()
 
         HashDir = PkgDir
@@ -899,6 +900,7 @@ class WorkspaceAutoGen(AutoGen):
             FdsCommandDict["quiet"] = True
 
         FdsCommandDict["GenfdsMultiThread"] = GlobalData.gEnableGenfdsMultiThread
+        FdsCommandDict["GenfdsCache"] = GlobalData.gEnableGenfdsCache
         if GlobalData.gIgnoreSource:
             FdsCommandDict["IgnoreSources"] = True
 
@@ -0,0 +1,146 @@
+## @file
+# Persistent file digest store used by the build hash cache
+#
+# The md5 digest of every file hashed by --hash, --binary-destination and
+# --binary-source is kept in Conf/.cache together with the file size and
+# modification time, so an unchanged file is not read again by later builds.
+#
+# Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+## Import Modules
+#
+from __future__ import absolute_import
+import os
+import json
+import time
+import hashlib
+from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.LongFilePathSupport import LongFilePath
+import Common.GlobalData as GlobalData
+
+## Files modified within this many seconds are hashed but not stored, since
+#  a later write in the same timestamp granularity could go unnoticed.
+gRacyInterval = 2
+
+# FilePath: [Size, MTimeNs, Digest]
+_FileHashStore = {}
+_FileHashStoreFile = None
+_FileHashStoreDirty = False
+# The entries added since the store was loaded
+_FileHashStoreNew = {}
+
+## Load the persistent digest store
+#
+#   @param  StoreFile   The file holding the digests of the previous builds
+#
+def LoadFileHashStore(StoreFile):
+    global _FileHashStore, _FileHashStoreFile, _FileHashStoreDirty, _FileHashStoreNew
+    _FileHashStore = {}
+    _FileHashStoreFile = StoreFile
+    _FileHashStoreDirty = False
+    _FileHashStoreNew = {}
+    try:
+        with open(StoreFile, 'r') as f:
+            Store = json.load(f)
+        if isinstance(Store, dict):
+            _FileHashStore = Store
+    except:
+        pass
+
+## Get the digests added since the store was loaded
+#
+#   AutoGen worker processes do not save the store. They send these entries
+#   to the main process, which merges them with MergeFileHashStore().
+#
+def GetNewFileHashes():
+    return _FileHashStoreNew
+
+## Add the digests computed by another process to the store
+#
+#   @param  Entries     The entries returned by GetNewFileHashes()
+#
+def MergeFileHashStore(Entries):
+    global _FileHashStoreDirty
+    if Entries:
+        _FileHashStore.update(Entries)
+        _FileHashStoreNew.update(Entries)
+        _FileHashStoreDirty = True
+
+## Save the digest store if a new digest was added
+#
+def SaveFileHashStore():
+    global _FileHashStoreDirty
+    if not _FileHashStoreFile or not _FileHashStoreDirty:
+        return
+    try:
+        TempFile = _FileHashStoreFile + '.tmp%d' % os.getpid()
+        with open(TempFile, 'w') as f:
+            json.dump(_FileHashStore, f)
+        if os.path.exists(LongFilePath(_FileHashStoreFile)):
+            os.remove(LongFilePath(_FileHashStoreFile))
+        os.rename(LongFilePath(TempFile), LongFilePath(_FileHashStoreFile))
+        _FileHashStoreDirty = False
+    except:
+        pass
+
+## Get the md5 hex digest of a file
+#
+#   The stored digest is reused while the file size and modification time
+#   are unchanged. The workspace directory is replaced by $(WORKSPACE) before
+#   hashing, so generated files such as makefiles hash to the same digest in
+#   every workspace.
+#
+#   @param  FilePath    The file to hash
+#
+#   @retval str         The hex digest of the file content
+#   @retval None        The file cannot be read
+#
+def GetFileHash(FilePath):
+    global _FileHashStoreDirty
+    FilePath = str(FilePath)
+    try:
+        Stat = os.stat(LongFilePath(FilePath))
+    except OSError:
+        return None
+    Entry = _FileHashStore.get(FilePath)
+    if Entry and Entry[0] == Stat.st_size and Entry[1] == Stat.st_mtime_ns:
+        return Entry[2]
+    try:
+        with open(FilePath, 'rb') as f:
+            Content = f.read()
+    except IOError:
+        return None
+    if GlobalData.gWorkspace and os.path.isabs(GlobalData.gWorkspace):
+        Content = Content.replace(os.path.normpath(GlobalData.gWorkspace).encode('utf-8'), b'$(WORKSPACE)')
+    Digest = hashlib.md5(Content).hexdigest()
+    if time.time() - Stat.st_mtime > gRacyInterval:
+        _FileHashStore[FilePath] = [Stat.st_size, Stat.st_mtime_ns, Digest]
+        _FileHashStoreNew[FilePath] = _FileHashStore[FilePath]
+        _FileHashStoreDirty = True
+    return Digest
+
+## Convert a path to the form stored in the hash cache files
+#
+#   Paths under the workspace are stored relative to it, so one cache
+#   directory can serve builds from several workspaces.
+#
+def HashCachePath(FilePath):
+    FilePath = str(FilePath)
+    if GlobalData.gWorkspace and os.path.isabs(FilePath):
+        try:
+            RelPath = os.path.relpath(FilePath, GlobalData.gWorkspace)
+        except ValueError:
+            return FilePath
+        if not RelPath.startswith(os.pardir):
+            return RelPath.replace('\\', '/')
+    return FilePath
+
+## Convert a path read from a hash cache file back to a file system path
+#
+def HashCacheRealPath(FilePath):
+    if os.path.isabs(FilePath) or not GlobalData.gWorkspace:
+        return FilePath
+    return os.path.normpath(os.path.join(GlobalData.gWorkspace, FilePath))
@@ -114,10 +114,12 @@ gHashChainStatus = None
 gModulePreMakeCacheStatus = None
 gModuleMakeCacheStatus = None
 gFileHashDict = None
+gFileHashStore = None
 gModuleAllCacheStatus = None
 gModuleCacheHit = None
 
 gEnableGenfdsMultiThread = True
+gEnableGenfdsCache = True
 gSikpAutoGenCache = set()
 # Common lock for the file access in multiple process AutoGens
 file_lock = None
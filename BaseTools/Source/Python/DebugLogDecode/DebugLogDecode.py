@@ -0,0 +1,358 @@
+## @file
+#
+# Render a copy of the in-memory debug log produced by DebugLogDxe.
+#
+# The input file holds the DEBUG_LOG_BUFFER header followed by the ring, as
+# found at the address of the gEdkiiDebugLogBufferGuid configuration table.
+# Plain text logs are printed as they are. Logs of records, produced when
+# PcdDebugLogBinaryRecords is TRUE, have their binary records formatted here
+# the way BasePrintLib would have formatted them.
+#
+# Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+# SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+import argparse
+import Common.EdkLogger as EdkLogger
+from Common.BuildToolError import *
+import struct
+import sys
+import os
+
+__description__ = """
+Render a copy of the in-memory debug log produced by DebugLogDxe. Binary
+records are formatted the way BasePrintLib would have formatted them.
+"""
+
+DEBUG_LOG_BUFFER_SIGNATURE = b'DLOG'
+DEBUG_LOG_BUFFER_HEADER = struct.Struct('<4sIIIII')
+DEBUG_LOG_BUFFER_FLAG_RECORDS = 0x2
+
+DEBUG_LOG_RECORD = struct.Struct('<HBBI')
+DEBUG_LOG_RECORD_TYPE_PADDING = 0
+DEBUG_LOG_RECORD_TYPE_TEXT = 1
+DEBUG_LOG_RECORD_TYPE_BINARY = 2
+DEBUG_LOG_RECORD_ARGUMENT_COUNT = 12
+DEBUG_LOG_RECORD_ALIGNMENT = 8
+
+#
+# The strings printed by BasePrintLib for %r
+#
+WarningString = [
+    "Success",
+    "Warning Unknown Glyph",
+    "Warning Delete Failure",
+    "Warning Write Failure",
+    "Warning Buffer Too Small",
+    "Warning Stale Data",
+    ]
+
+ErrorString = [
+    "Load Error",
+    "Invalid Parameter",
+    "Unsupported",
+    "Bad Buffer Size",
+    "Buffer Too Small",
+    "Not Ready",
+    "Device Error",
+    "Write Protected",
+    "Out of Resources",
+    "Volume Corrupt",
+    "Volume Full",
+    "No Media",
+    "Media changed",
+    "Not Found",
+    "Access Denied",
+    "No Response",
+    "No mapping",
+    "Time out",
+    "Not started",
+    "Already started",
+    "Aborted",
+    "ICMP Error",
+    "TFTP Error",
+    "Protocol Error",
+    "Incompatible Version",
+    "Security Violation",
+    "CRC Error",
+    "End of Media",
+    "Reserved (29)",
+    "Reserved (30)",
+    "End of File",
+    "Invalid Language",
+    "Compromised Data",
+    ]
+
+## Read the arguments of a binary record, packed as a BASE_LIST.
+#
+# Each argument takes a multiple of the size of UINTN, as with BASE_ARG().
+#
+class BaseList(object):
+    def __init__(self, Data, WordSize):
+        self.Data = Data
+        self.WordSize = WordSize
+        self.Offset = 0
+
+    ## Return the next argument as an unsigned integer of Size bytes.
+    def Arg(self, Size):
+        Value = int.from_bytes(self.Data[self.Offset:self.Offset + Size], 'little')
+        self.Offset += (Size + self.WordSize - 1) // self.WordSize * self.WordSize
+        return Value
+
+## Format a binary record the way BasePrintLibSPrintMarker() does.
+#
+# @param  Format    The format string of the record.
+# @param  Args      A BaseList instance holding the arguments of the record.
+#
+# @retval The formatted message.
+#
+def FormatMessage(Format, Args):
+    Output = []
+    Index = 0
+    while Index < len(Format):
+        Character = Format[Index]
+        Index += 1
+        if Character != '%':
+            Output.append(Character)
+            continue
+
+        LeftJustify = PrefixSign = PrefixBlank = Comma = Long = False
+        PrefixZero = PadToWidth = HasPrecision = False
+        Width = 0
+        Precision = 1
+        while Index < len(Format):
+            Character = Format[Index]
+            if Character == '.':
+                HasPrecision = True
+            elif Character == '-':
+                LeftJustify = True
+            elif Character == '+':
+                PrefixSign = True
+            elif Character == ' ':
+                PrefixBlank = True
+            elif Character == ',':
+                Comma = True
+            elif Character in 'lL':
+                Long = True
+            elif Character == '*':
+                if not HasPrecision:
+                    PadToWidth = True
+                    Width = Args.Arg(Args.WordSize)
+                else:
+                    Precision = Args.Arg(Args.WordSize)
+            elif Character.isdigit():
+                if Character == '0' and not HasPrecision:
+                    PrefixZero = True
+                Count = 0
+                while Index < len(Format) and Format[Index].isdigit():
+                    Count = Count * 10 + int(Format[Index])
+                    Index += 1
+                Index -= 1
+                if not HasPrecision:
+                    PadToWidth = True
+                    Width = Count
+                else:
+                    Precision = Count
+            else:
+                break
+            Index += 1
+        else:
+            #
+            # Make no output if Format string terminates unexpectedly
+            #
+            break
+        Index += 1
+
+        Prefix = ''
+        Digits = None
+        if Character in 'pXxud':
+            if Character == 'p':
+                PrefixBlank = PrefixSign = PrefixZero = False
+                Long = Args.WordSize > 4
+            if Character in 'pX':
+                PrefixZero = True
+            Hex = Character in 'pXx'
+            Unsigned = Character == 'u'
+            if Unsigned:
+                PrefixSign = False
+            Value = Args.Arg(8 if Long else 4)
+            if not Long and Value >= 0x80000000 and not Unsigned and not Hex:
+                Value -= 0x100000000
+            elif Long and Value >= 0x8000000000000000 and not Unsigned and not Hex:
+                Value -= 0x10000000000000000
+            if PrefixBlank:
+                Prefix = ' '
+            if PrefixSign:
+                Prefix = '+'
+            if Hex:
+                Comma = False
+                Digits = '%X' % Value
+            else:
+                if Comma:
+                    PrefixZero = False
+                    Precision = 1
+                if Value < 0:
+                    Prefix = '-'
+                    Value = -Value
+                Digits = '%d' % Value
+            if Value == 0 and Precision == 0:
+                Digits = ''
+            if Comma and Digits:
+                Digits = '{:,}'.format(int(Digits))
+            if PrefixZero and not LeftJustify and PadToWidth and not HasPrecision:
+                Precision = Width
+            Count = len(Digits) + len(Prefix)
+            if Prefix:
+                Precision += 1
+            Precision = max(Precision, Count)
+            Argument = Prefix + '0' * (Precision - Count) + Digits
+        elif Character == 'c':
+            Argument = chr(Args.Arg(Args.WordSize) & 0xffff)
+        elif Character == 'r':
+            Status = Args.Arg(Args.WordSize)
+            ErrorBit = 1 << (Args.WordSize * 8 - 1)
+            Argument = None
+            if Status & ErrorBit:
+                if 0 < Status & ~ErrorBit <= len(ErrorString):
+                    Argument = ErrorString[(Status & ~ErrorBit) - 1]
+            elif Status < len(WarningString):
+                Argument = WarningString[Status]
+            if Argument is None:
+                Argument = '%08X' % Status
+        elif Character in 'sSagt':
+            #
+            # UefiDebugLibMemoryLog formats these messages itself, so they
+            # only show up in corrupted records.
+            #
+            Args.Arg(Args.WordSize)
+            Argument = '<%%%s>' % Character
+        else:
+            Argument = Character
+
+        if Character not in 'pXxud':
+            if HasPrecision and Character in 'sSagt':
+                Argument = Argument[:Precision]
+            Precision = len(Argument)
+        if PadToWidth and Width > Precision:
+            if LeftJustify:
+                Argument = Argument + ' ' * (Width - Precision)
+            else:
+                Argument = ' ' * (Width - Precision) + Argument
+        Output.append(Argument)
+
+    return ''.join(Output)
+
+## Return the text of a plain text log, in order.
+#
+def DecodeText(Ring, WriteOffset):
+    Size = len(Ring)
+    Position = WriteOffset & (Size - 1)
+    if WriteOffset <= Size:
+        Data = Ring[:WriteOffset]
+    else:
+        Data = Ring[Position:] + Ring[:Position]
+    return Data.decode('ascii', 'replace')
+
+## Return the messages of a log of records, in order.
+#
+# Records never cross the end of the ring, so the records written since the
+# ring last wrapped start at its beginning. The older records left in the ring
+# are not known to start at a record boundary, and are skipped.
+#
+def DecodeRecords(Ring, WriteOffset, WordSize):
+    Size = len(Ring)
+    Start = (WriteOffset - 1) & ~(Size - 1) if WriteOffset != 0 else 0
+
+    Output = []
+    Offset = Start
+    while Offset < WriteOffset:
+        Position = Offset & (Size - 1)
+        DataSize, Type, Reserved, ErrorLevel = DEBUG_LOG_RECORD.unpack_from(Ring, Position)
+        Data = Ring[Position + DEBUG_LOG_RECORD.size:Position + DEBUG_LOG_RECORD.size + DataSize]
+        if Type == DEBUG_LOG_RECORD_TYPE_TEXT:
+            Output.append(Data.decode('ascii', 'replace'))
+        elif Type == DEBUG_LOG_RECORD_TYPE_BINARY:
+            ArgumentSize = DEBUG_LOG_RECORD_ARGUMENT_COUNT * 8
+            Format = Data[ArgumentSize:].split(b'\0', 1)[0].decode('ascii', 'replace')
+            Output.append(FormatMessage(Format, BaseList(Data[:ArgumentSize], WordSize)))
+        Offset += (DEBUG_LOG_RECORD.size + DataSize + DEBUG_LOG_RECORD_ALIGNMENT - 1) & ~(DEBUG_LOG_RECORD_ALIGNMENT - 1)
+    return ''.join(Output)
+
+## Render a copy of the debug log.
+#
+# @param  InputFile     Path to the copy of the debug log.
+# @param  OutputFile    Path to the text file to generate, or None for stdout.
+# @param  WordSize      The size of UINTN in the firmware, 4 or 8.
+#
+def DebugLogDecode(InputFile, OutputFile, WordSize):
+    with open(InputFile, "rb") as fIn:
+        Buffer = fIn.read()
+
+    Signature, Size, WriteOffset, CommitOffset, DrainOffset, Flags = DEBUG_LOG_BUFFER_HEADER.unpack_from(Buffer)
+    if Signature != DEBUG_LOG_BUFFER_SIGNATURE:
+        EdkLogger.error(__file__, FORMAT_INVALID, "Invalid debug log signature", ExtraData=InputFile)
+    if Size == 0 or Size & (Size - 1) != 0 or len(Buffer) < DEBUG_LOG_BUFFER_HEADER.size + Size:
+        EdkLogger.error(__file__, FORMAT_INVALID, "Invalid debug log size", ExtraData=InputFile)
+
+    #
+    # Only the messages that were completely written are decoded.
+    #
+    Ring = Buffer[DEBUG_LOG_BUFFER_HEADER.size:DEBUG_LOG_BUFFER_HEADER.size + Size]
+    if Flags & DEBUG_LOG_BUFFER_FLAG_RECORDS:
+        Text = DecodeRecords(Ring, CommitOffset, WordSize)
+    else:
+        Text = DecodeText(Ring, CommitOffset)
+
+    Text = Text.replace('\r\n', '\n')
+    if OutputFile:
+        with open(OutputFile, "w") as fOut:
+            fOut.write(Text)
+    else:
+        sys.stdout.write(Text)
+
+## Parse the command line arguments.
+#
+# @retval A argparse.NameSpace instance, containing parsed values.
+#
+def ParseArgs():
+    Parser = argparse.ArgumentParser(description=__description__)
+    Parser.add_argument(dest="InputFile",
+                        help="Path to a copy of the debug log.")
+    Parser.add_argument("-o", "--output", dest="OutputFile",
+                        help="Text file to write the messages to. Default is stdout.")
+    Parser.add_argument("--ia32", dest="WordSize", action="store_const", const=4, default=8,
+                        help="The debug log was produced by IA32 firmware.")
+    Args = Parser.parse_args()
+
+    if not os.path.exists(Args.InputFile):
+        EdkLogger.error(__file__, FILE_OPEN_FAILURE, ExtraData=Args.InputFile)
+        return None
+
+    return Args
+
+## Main method
+#
+# @retval 0     Success.
+# @retval 1     Error.
+#
+def Main():
+    EdkLogger.Initialize()
+
+    try:
+        CommandArguments = ParseArgs()
+        if not CommandArguments:
+            return 1
+
+        DebugLogDecode(CommandArguments.InputFile, CommandArguments.OutputFile, CommandArguments.WordSize)
+    except Exception as e:
+        print(e)
+        return 1
+
+    return 0
+
+if __name__ == '__main__':
+    r = Main()
+    # 0-127 is a safe return range, and 1 is a standard default error
+    if r < 0 or r > 127: r = 1
+    sys.exit(r)
@@ -94,6 +94,8 @@ def resetFdsGlobalVariable():
     GenFdsGlobalVariable.CopyList   = []
     GenFdsGlobalVariable.ModuleFile = ''
     GenFdsGlobalVariable.EnableGenfdsMultiThread = True
+    GenFdsGlobalVariable.EnableToolOutputCache = True
+    GenFdsGlobalVariable.ToolDigestDict = {}
 
     GenFdsGlobalVariable.LargeFileInFvFlags = []
     GenFdsGlobalVariable.EFI_FIRMWARE_FILE_SYSTEM3_GUID = '5473C07A-3DCB-4dca-BD6F-1E9689E7349A'
@@ -142,6 +144,7 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = True
             else:
                 GenFdsGlobalVariable.EnableGenfdsMultiThread = False
+            GenFdsGlobalVariable.EnableToolOutputCache = FdsCommandDict.get("GenfdsCache", True)
         os.chdir(GenFdsGlobalVariable.WorkSpaceDir)
 
         # set multiple workspace
@@ -376,6 +379,9 @@ def GenFdsApi(FdsCommandDict, WorkSpaceDataBase=None):
         """Display FV space info."""
         GenFds.DisplayFvSpaceInfo(FdfParserObj)
 
+        """Remove unused tool output from the cache"""
+        GenFdsGlobalVariable.PruneToolOutputCache()
+
     except Warning as X:
         EdkLogger.error(X.ToolName, FORMAT_INVALID, File=X.FileName, Line=X.LineNumber, ExtraData=X.Message, RaiseError=False)
         ReturnCode = FORMAT_INVALID
@@ -407,6 +413,7 @@ def OptionsToCommandDict(Options):
     FdsCommandDict["debug"] = Options.debug
     FdsCommandDict["Workspace"] = Options.Workspace
     FdsCommandDict["GenfdsMultiThread"] = not Options.NoGenfdsMultiThread
+    FdsCommandDict["GenfdsCache"] = not Options.NoGenfdsCache
     FdsCommandDict["fdf_file"] = [PathClass(Options.filename)] if Options.filename else []
     FdsCommandDict["build_target"] = Options.BuildTarget
     FdsCommandDict["toolchain_tag"] = Options.ToolChain
@@ -465,6 +472,7 @@ def myOptionParser():
     Parser.add_option("--pcd", action="append", dest="OptionPcd", help="Set PCD value by command line. Format: \"PcdName=Value\" ")
     Parser.add_option("--genfds-multi-thread", action="store_true", dest="GenfdsMultiThread", default=True, help="Enable GenFds multi thread to generate ffs file.")
     Parser.add_option("--no-genfds-multi-thread", action="store_true", dest="NoGenfdsMultiThread", default=False, help="Disable GenFds multi thread to generate ffs file.")
+    Parser.add_option("--no-genfds-cache", action="store_true", dest="NoGenfdsCache", default=False, help="Disable the cache of compressed sections in Conf/.cache/GenFds.")
 
     Options, _ = Parser.parse_args()
     return Options
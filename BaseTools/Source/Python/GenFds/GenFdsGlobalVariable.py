@@ -14,6 +14,10 @@ from __future__ import absolute_import
 
 import Common.LongFilePathOs as os
 import sys
+import hashlib
+import shutil
+import time
+from os import getpid
 from sys import stdout
 from subprocess import PIPE,Popen
 from struct import Struct
@@ -29,6 +33,7 @@ from AutoGen.BuildEngine import ToolBuildRule
 import Common.DataType as DataType
 from Common.Misc import PathClass,CreateDirectory
 from Common.LongFilePathSupport import OpenLongFilePath as open
+from Common.LongFilePathSupport import CopyLongFilePath
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 import Common.GlobalData as GlobalData
 from Common.BuildToolError import *
@@ -92,6 +97,31 @@ class GenFdsGlobalVariable:
     # FvName, FdName, CapName in FDF, Image file name
     ImageBinDict = {}
 
+    #
+    # Sub directory of Conf/.cache holding the output of compression and
+    # GUIDed tools, named by the digest of the tool, options and input data.
+    # It is removed with the rest of Conf/.cache by "build cleanall", and
+    # files not used for ToolOutputCacheDays are removed after each run.
+    #
+    ToolOutputCacheDir = 'GenFds'
+    ToolOutputCacheDays = 30
+    EnableToolOutputCache = True
+
+    #
+    # GUIDed tools whose output only depends on the input data and options.
+    # The output of other tools, such as the signing tools, also depends on
+    # key files, so it is never taken from the cache.
+    #
+    ToolOutputCacheGuids = (
+        'EE4E5898-3914-4259-9D6E-DC7BD79403CF',    # LZMA
+        'D42AE6BD-1352-4BFB-909A-CA72A6EAE889',    # LZMAF86
+        'A31280AD-481E-41B6-95E8-127F4C984779',    # TIANO
+        '3D532050-5CDA-4FD0-879E-0F7F630D5AFB',    # BROTLI
+        )
+
+    # Tool path, digest of the tool binary
+    ToolDigestDict = {}
+
     ## LoadBuildRule
     #
     @staticmethod
@@ -332,6 +362,7 @@ class GenFdsGlobalVariable:
         GenFdsGlobalVariable.ActivePlatform = GlobalData.gActivePlatform
         GenFdsGlobalVariable.ConfDir  = GlobalData.gConfDirectory
         GenFdsGlobalVariable.EnableGenfdsMultiThread = GlobalData.gEnableGenfdsMultiThread
+        GenFdsGlobalVariable.EnableToolOutputCache = GlobalData.gEnableGenfdsCache
         for Arch in ArchList:
             GenFdsGlobalVariable.OutputDirDict[Arch] = os.path.normpath(
                 os.path.join(GlobalData.gWorkspace,
@@ -516,7 +547,10 @@ class GenFdsGlobalVariable:
                     GenFdsGlobalVariable.SecCmdList.append(' '.join(Cmd).strip())
             elif GenFdsGlobalVariable.NeedsUpdate(Output, list(Input) + [CommandFile]):
                 GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
-                GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
+                if CompressionType:
+                    GenFdsGlobalVariable.CallCachedTool(Cmd, Output, Input, "GenSec", [Type, CompressionType], "Failed to generate section")
+                else:
+                    GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate section")
                 if (os.path.getsize(Output) >= GenFdsGlobalVariable.LARGE_FILE_SIZE and
                     GenFdsGlobalVariable.LargeFileInFvFlags):
                     GenFdsGlobalVariable.LargeFileInFvFlags[-1] = True
@@ -687,7 +721,7 @@ class GenFdsGlobalVariable:
             GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to generate option rom")
 
     @staticmethod
-    def GuidTool(Output, Input, ToolPath, Options='', returnValue=[], IsMakefile=False):
+    def GuidTool(Output, Input, ToolPath, Options='', returnValue=[], IsMakefile=False, Guid=None):
         if not GenFdsGlobalVariable.NeedsUpdate(Output, Input) and not IsMakefile:
             return
         GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "%s needs update because of newer %s" % (Output, Input))
@@ -699,9 +733,136 @@ class GenFdsGlobalVariable:
         if IsMakefile:
             if " ".join(Cmd).strip() not in GenFdsGlobalVariable.SecCmdList:
                 GenFdsGlobalVariable.SecCmdList.append(" ".join(Cmd).strip())
+        elif str(Guid).upper() in GenFdsGlobalVariable.ToolOutputCacheGuids:
+            GenFdsGlobalVariable.CallCachedTool(Cmd, Output, Input, ToolPath, [str(Guid).upper(), Options],
+                                                "Failed to call " + ToolPath, returnValue)
         else:
             GenFdsGlobalVariable.CallExternalTool(Cmd, "Failed to call " + ToolPath, returnValue)
 
+    ## Get the digest of a tool binary
+    #
+    #   The PosixLike BinWrappers are scripts running the binary of the same
+    #   name in BaseTools/Source/C/bin, so the content of both is hashed.
+    #
+    #   @param  ToolPath        Path or name of the tool
+    #
+    #   @retval string          Digest of the tool, or None if the binary is not found
+    #
+    @staticmethod
+    def GetToolDigest(ToolPath):
+        if ToolPath in GenFdsGlobalVariable.ToolDigestDict:
+            return GenFdsGlobalVariable.ToolDigestDict[ToolPath]
+        Digest = None
+        ToolFile = shutil.which(ToolPath)
+        if ToolFile:
+            ToolFiles = [ToolFile]
+            with open(ToolFile, 'rb') as Fd:
+                IsScript = Fd.read(2) == b'#!'
+            if IsScript:
+                ToolName = os.path.basename(ToolFile)
+                for BinDir in (os.path.join(os.environ.get('WORKSPACE', ''), 'Conf', 'BaseToolsCBinaries'),
+                               os.path.join(os.environ.get('EDK_TOOLS_PATH', ''), 'Source', 'C', 'bin'),
+                               os.path.join(os.path.dirname(ToolFile), '..', '..', 'Source', 'C', 'bin')):
+                    if os.path.isfile(os.path.join(BinDir, ToolName)):
+                        ToolFiles.append(os.path.join(BinDir, ToolName))
+                        break
+            if not IsScript or len(ToolFiles) == 2:
+                m = hashlib.md5()
+                for File in ToolFiles:
+                    with open(File, 'rb') as Fd:
+                        m.update(Fd.read())
+                Digest = m.hexdigest()
+        GenFdsGlobalVariable.ToolDigestDict[ToolPath] = Digest
+        return Digest
+
+    ## Get the file in the tool output cache for the given tool and input
+    #
+    #   @param  ToolPath        Path or name of the tool
+    #   @param  Key             List of strings identifying the tool GUID and options
+    #   @param  Input           Path list of input files
+    #
+    #   @retval string          Path of the cache file, or None if the cache is not available
+    #
+    @staticmethod
+    def GetToolOutputCacheFile(ToolPath, Key, Input):
+        if not GenFdsGlobalVariable.EnableToolOutputCache or not GenFdsGlobalVariable.ConfDir:
+            return None
+        #
+        # A rebuilt tool may produce different output, so the digest of its
+        # binary is part of the key.
+        #
+        ToolDigest = GenFdsGlobalVariable.GetToolDigest(ToolPath)
+        if ToolDigest is None:
+            return None
+        m = hashlib.md5()
+        m.update(os.path.basename(ToolPath).encode('utf-8') + b'\0')
+        m.update(ToolDigest.encode('utf-8') + b'\0')
+        for Item in Key:
+            m.update(str(Item).encode('utf-8') + b'\0')
+        for File in Input:
+            if not os.path.isfile(File):
+                return None
+            with open(File, 'rb') as Fd:
+                m.update(Fd.read())
+        Digest = m.hexdigest()
+        return os.path.join(GenFdsGlobalVariable.ConfDir, '.cache', GenFdsGlobalVariable.ToolOutputCacheDir, Digest[:2], Digest)
+
+    ## Call an external tool whose output only depends on its input data
+    #
+    #   The output is taken from the tool output cache if the same input was
+    #   processed with the same tool and options before, otherwise the tool
+    #   is called and its output is added to the cache.
+    #
+    @staticmethod
+    def CallCachedTool(Cmd, Output, Input, ToolPath, Key, errorMess, returnValue=[]):
+        CacheFile = GenFdsGlobalVariable.GetToolOutputCacheFile(ToolPath, Key, Input)
+        if CacheFile and os.path.isfile(CacheFile):
+            GenFdsGlobalVariable.DebugLogger(EdkLogger.DEBUG_5, "Reuse %s for %s" % (CacheFile, Output))
+            CopyLongFilePath(CacheFile, Output)
+            #
+            # The time stamp marks the last use, for PruneToolOutputCache().
+            #
+            os.utime(CacheFile, None)
+            if returnValue != []:
+                returnValue[0] = 0
+            return
+        GenFdsGlobalVariable.CallExternalTool(Cmd, errorMess, returnValue)
+        if CacheFile is None or (returnValue != [] and returnValue[0] != 0) or not os.path.isfile(Output):
+            return
+        TempFile = '%s.%d' % (CacheFile, getpid())
+        try:
+            CreateDirectory(os.path.dirname(CacheFile))
+            CopyLongFilePath(Output, TempFile)
+            os.rename(TempFile, CacheFile)
+        except (IOError, OSError):
+            #
+            # Another build may have added the same file in the meantime.
+            #
+            if os.path.exists(TempFile):
+                os.remove(TempFile)
+
+    ## Remove the files of the tool output cache that were not used recently
+    #
+    @staticmethod
+    def PruneToolOutputCache():
+        if not GenFdsGlobalVariable.EnableToolOutputCache or not GenFdsGlobalVariable.ConfDir:
+            return
+        CacheDir = os.path.join(GenFdsGlobalVariable.ConfDir, '.cache', GenFdsGlobalVariable.ToolOutputCacheDir)
+        if not os.path.isdir(CacheDir):
+            return
+        OldTime = time.time() - GenFdsGlobalVariable.ToolOutputCacheDays * 24 * 60 * 60
+        for Root, Dirs, Files in os.walk(CacheDir):
+            for File in Files:
+                File = os.path.join(Root, File)
+                try:
+                    if os.path.getmtime(File) < OldTime:
+                        os.remove(File)
+                except OSError:
+                    #
+                    # Another build may have removed or used it in the meantime.
+                    #
+                    pass
+
     @staticmethod
     def CallExternalTool (cmd, errorMess, returnValue=[]):
 
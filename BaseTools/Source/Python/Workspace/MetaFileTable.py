@@ -9,19 +9,153 @@
 # Import Modules
 #
 from __future__ import absolute_import
+import os
+import time
 import uuid
+import pickle
+from hashlib import md5
 
 import Common.EdkLogger as EdkLogger
+import Common.GlobalData as GlobalData
 from Common.BuildToolError import FORMAT_INVALID
 
 from CommonDataClass.DataClass import MODEL_FILE_DSC, MODEL_FILE_DEC, MODEL_FILE_INF, \
                                       MODEL_FILE_OTHERS
 from Common.DataType import *
 
+## Raw tables of INF and DEC files kept across build invocations
+#
+#   The raw table of an INF or DEC file depends on nothing but the file content,
+# so it is saved in the build database file after parsing and loaded again by
+# the next build as long as the file is unchanged. A file is unchanged if its
+# size and modification time match, or else if the md5 digest of its content
+# matches. DSC files are always parsed, since their content depends on the
+# macros, PCDs and !include files of the build.
+#
+class MetaFileTableStore(object):
+    # Bump when the layout of the stored tables changes
+    _VERSION_ = 1
+
+    # Files modified within this many seconds are not stored
+    _RACY_INTERVAL_ = 2
+
+    # FilePath: [Size, MTimeNs, Md5, BaseId, Content]
+    _Store = {}
+    _StoreFile = None
+    _Dirty = False
+
+    ## Key identifying the parser which produced the stored tables
+    @staticmethod
+    def _ParserKey():
+        Parser = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'MetaFileParser.py')
+        try:
+            Stat = os.stat(Parser)
+            return (MetaFileTableStore._VERSION_, Stat.st_size, Stat.st_mtime_ns)
+        except:
+            return (MetaFileTableStore._VERSION_,)
+
+    ## Load the tables saved by the previous build
+    #
+    #   @param  StoreFile   The build database file
+    #
+    @staticmethod
+    def Load(StoreFile):
+        MetaFileTableStore._Store = {}
+        MetaFileTableStore._StoreFile = StoreFile
+        MetaFileTableStore._Dirty = False
+        try:
+            with open(StoreFile, 'rb') as File:
+                Key, Store = pickle.load(File)
+            if Key == MetaFileTableStore._ParserKey():
+                MetaFileTableStore._Store = Store
+        except:
+            pass
+
+    ## Save the tables if any of them was added or refreshed
+    @staticmethod
+    def Save():
+        if not MetaFileTableStore._StoreFile or not MetaFileTableStore._Dirty:
+            return
+        try:
+            TempFile = MetaFileTableStore._StoreFile + '.tmp%d' % os.getpid()
+            with open(TempFile, 'wb') as File:
+                pickle.dump((MetaFileTableStore._ParserKey(), MetaFileTableStore._Store), File, pickle.HIGHEST_PROTOCOL)
+            if os.path.exists(MetaFileTableStore._StoreFile):
+                os.remove(MetaFileTableStore._StoreFile)
+            os.rename(TempFile, MetaFileTableStore._StoreFile)
+            MetaFileTableStore._Dirty = False
+        except:
+            EdkLogger.debug(EdkLogger.DEBUG_5, "Failed to save %s" % MetaFileTableStore._StoreFile)
+
+    ## Fill the table with the stored content of its file
+    #
+    #   @retval True    The stored content was restored
+    #   @retval False   The file must be parsed
+    #
+    @staticmethod
+    def Restore(Table):
+        Path = Table.MetaFile.Path
+        Entry = MetaFileTableStore._Store.get(Path)
+        if not Entry:
+            return False
+        try:
+            Stat = os.stat(Path)
+        except:
+            return False
+        Size, MTime, Digest, BaseId, Content = Entry
+        if Size != Stat.st_size:
+            return False
+        if MTime != Stat.st_mtime_ns:
+            try:
+                with open(Path, 'rb') as File:
+                    if md5(File.read()).hexdigest() != Digest:
+                        return False
+            except:
+                return False
+            if time.time() - Stat.st_mtime > MetaFileTableStore._RACY_INTERVAL_:
+                Entry[1] = Stat.st_mtime_ns
+                MetaFileTableStore._Dirty = True
+
+        #
+        # Record IDs are derived from the file ID, which differs between builds
+        #
+        Delta = Table.FileId * 10**8 - BaseId
+        Index = Table._BELONGS_TO_
+        Table.CurrentContent = []
+        for Row in Content:
+            Row = list(Row)
+            if Row[0] >= BaseId:
+                Row[0] += Delta
+            if Row[Index] >= BaseId:
+                Row[Index] += Delta
+            Table.CurrentContent.append(Row)
+        Table.CurrentContent.append(list(Table._DUMMY_))
+        return True
+
+    ## Remember the content of a table that was just parsed
+    @staticmethod
+    def Update(Table):
+        Path = Table.MetaFile.Path
+        try:
+            Stat = os.stat(Path)
+            if time.time() - Stat.st_mtime <= MetaFileTableStore._RACY_INTERVAL_:
+                return
+            with open(Path, 'rb') as File:
+                Digest = md5(File.read()).hexdigest()
+        except:
+            return
+        Content = [tuple(Row) for Row in Table.CurrentContent if Row[0] >= 0]
+        MetaFileTableStore._Store[Path] = [Stat.st_size, Stat.st_mtime_ns, Digest, Table.FileId * 10**8, Content]
+        MetaFileTableStore._Dirty = True
+
 class MetaFileTable():
     # TRICK: use file ID as the part before '.'
     _ID_STEP_ = 1
     _ID_MAX_ = 99999999
+    # Whether the parsed content can be kept in MetaFileTableStore
+    _PERSISTENT_ = False
+    # Column of BelongsToItem
+    _BELONGS_TO_ = 7
 
     ## Constructor
     def __init__(self, DB, MetaFile, FileType, Temporary, FromItem=None):
@@ -40,6 +174,7 @@ class MetaFileTable():
                         FromItem])
         self.FileId = len(DB.TblFile)
         self.ID = self.FileId * 10**8
+        self._Persistent = self._PERSISTENT_ and not Temporary
         if Temporary:
             self.TableName = "_%s_%s_%s" % (FileType, len(DB.TblFile), uuid.uuid4().hex)
         else:
@@ -49,6 +184,9 @@ class MetaFileTable():
         Result = False
         try:
             TimeStamp = self.MetaFile.TimeStamp
+            if not self.CurrentContent and self._Persistent and \
+               not (GlobalData.gOptions and GlobalData.gOptions.CheckUsage):
+                MetaFileTableStore.Restore(self)
             if not self.CurrentContent:
                 Result = False
             else:
@@ -60,12 +198,15 @@ class MetaFileTable():
 
     def SetEndFlag(self):
         self.CurrentContent.append(self._DUMMY_)
+        if self._Persistent:
+            MetaFileTableStore.Update(self)
 
     def GetAll(self):
         return [item for item in self.CurrentContent if item[0] >= 0 and item[-1]>=0]
 
 ## Python class representation of table storing module data
 class ModuleTable(MetaFileTable):
+    _PERSISTENT_ = True
     _COLUMN_ = '''
         ID REAL PRIMARY KEY,
         Model INTEGER NOT NULL,
@@ -159,6 +300,7 @@ class ModuleTable(MetaFileTable):
 
 ## Python class representation of table storing package data
 class PackageTable(MetaFileTable):
+    _PERSISTENT_ = True
     _COLUMN_ = '''
         ID REAL PRIMARY KEY,
         Model INTEGER NOT NULL,
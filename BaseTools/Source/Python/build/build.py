@@ -25,6 +25,10 @@ import traceback
 import multiprocessing
 from threading import Thread,Event,BoundedSemaphore
 import threading
+try:
+    from queue import Empty
+except:
+    from Queue import Empty
 from linecache import getlines
 from subprocess import Popen,PIPE, STDOUT
 from collections import OrderedDict, defaultdict
@@ -45,9 +49,11 @@ from Common.StringUtils import NormPath
 from Common.MultipleWorkspace import MultipleWorkspace as mws
 from Common.BuildToolError import *
 from Common.DataType import *
+from Common.FileHashCache import LoadFileHashStore, SaveFileHashStore
 import Common.EdkLogger as EdkLogger
 
 from Workspace.WorkspaceDatabase import BuildDB
+from Workspace.MetaFileTable import MetaFileTableStore
 
 from BuildReport import BuildReport
 from GenPatchPcdTable.GenPatchPcdTable import PeImageClass,parsePcdInfoFromMapFile
@@ -671,6 +677,74 @@ class BuildTask:
         self.BuildTread.daemon = False
         self.BuildTread.start()
 
+## The class queuing module builds while AutoGen is still running
+#
+# A library is queued as soon as its AutoGen is done, and a driver as soon as
+# its own AutoGen and the AutoGen of all its libraries are done. The order
+# between a driver and its libraries is left to BuildTask.
+#
+class ModuleMakeScheduler:
+    ## The constructor
+    #
+    #   @param  Drivers         The ModuleAutoGen objects of the drivers to build
+    #   @param  BuildCommand    The make command of the platform
+    #   @param  Target          The build target name, one of gSupportedTarget
+    #   @param  ThreadNumber    The maximum number of build threads
+    #   @param  ExitFlag        Flag used to end the build task scheduler
+    #
+    def __init__(self, Drivers, BuildCommand, Target, ThreadNumber, ExitFlag):
+        self.Drivers = [Ma for Ma in Drivers if not Ma.IsBinaryModule]
+        self.BuildCommand = BuildCommand
+        self.Target = Target
+        self.ThreadNumber = ThreadNumber
+        self.ExitFlag = ExitFlag
+        self.Done = set()
+        self.Libraries = None
+        self.Missing = {}
+        self.Waiting = defaultdict(list)
+
+    ## Resolve the libraries of all drivers
+    #
+    #   This is deferred to the first finished module, so that it runs while
+    # the AutoGen workers are busy.
+    #
+    def _Resolve(self):
+        self.Libraries = {}
+        for Ma in self.Drivers:
+            Keys = set([(Ma.MetaFile.Path, Ma.Arch)])
+            for La in Ma.LibraryAutoGenList:
+                Key = (La.MetaFile.Path, La.Arch)
+                self.Libraries[Key] = La
+                Keys.add(Key)
+            self.Missing[Ma] = Keys
+            for Key in Keys:
+                self.Waiting[Key].append(Ma)
+
+    def _Queue(self, Ma):
+        BuildTask.New(ModuleMakeUnit(Ma, self.BuildCommand, self.Target))
+        if not BuildTask.IsOnGoing():
+            BuildTask.StartScheduler(self.ThreadNumber, self.ExitFlag)
+
+    ## Called when the AutoGen of a module is done
+    #
+    #   @param  Path        The path of the module meta file
+    #   @param  Arch        The arch of the module
+    #
+    def ModuleDone(self, Path, Arch):
+        self.Done.add((Path, Arch))
+        if self.Libraries is None:
+            self._Resolve()
+            KeyList = list(self.Done)
+        else:
+            KeyList = [(Path, Arch)]
+        for Key in KeyList:
+            if Key in self.Libraries:
+                self._Queue(self.Libraries.pop(Key))
+            for Ma in self.Waiting.pop(Key, []):
+                self.Missing[Ma].discard(Key)
+                if not self.Missing[Ma]:
+                    self._Queue(Ma)
+
 ## The class contains the information related to EFI image
 #
 class PeImageInfo():
@@ -751,6 +825,7 @@ class Build():
         GlobalData.gBinCacheDest   = BuildOptions.BinCacheDest
         GlobalData.gBinCacheSource = BuildOptions.BinCacheSource
         GlobalData.gEnableGenfdsMultiThread = not BuildOptions.NoGenfdsMultiThread
+        GlobalData.gEnableGenfdsCache = not BuildOptions.NoGenfdsCache
         GlobalData.gDisableIncludePathCheck = BuildOptions.DisableIncludePathCheck
 
         if GlobalData.gBinCacheDest and not GlobalData.gUseHashCache:
@@ -783,6 +858,10 @@ class Build():
         GlobalData.gDatabasePath = os.path.normpath(os.path.join(GlobalData.gConfDirectory, GlobalData.gDatabasePath))
         if not os.path.exists(os.path.join(GlobalData.gConfDirectory, '.cache')):
             os.makedirs(os.path.join(GlobalData.gConfDirectory, '.cache'))
+        MetaFileTableStore.Load(GlobalData.gDatabasePath)
+        GlobalData.gFileHashStore = os.path.join(GlobalData.gConfDirectory, '.cache', '.FileHash')
+        if GlobalData.gUseHashCache:
+            LoadFileHashStore(GlobalData.gFileHashStore)
         self.Db = BuildDB
         self.BuildDatabase = self.Db.BuildObject
         self.Platform = None
@@ -847,7 +926,7 @@ class Build():
         GlobalData.gModuleAllCacheStatus = set()
         GlobalData.gModuleCacheHit = set()
 
-    def StartAutoGen(self,mqueue, DataPipe,SkipAutoGen,PcdMaList,cqueue):
+    def StartAutoGen(self,mqueue, DataPipe,SkipAutoGen,PcdMaList,cqueue,Scheduler=None):
         try:
             if SkipAutoGen:
                 return True,0
@@ -858,7 +937,7 @@ class Build():
                 FfsCmd = {}
             GlobalData.FfsCmd = FfsCmd
             auto_workers = [AutoGenWorkerInProcess(mqueue,DataPipe.dump_file,feedback_q,GlobalData.file_lock,cqueue,self.log_q,error_event) for _ in range(self.ThreadNumber)]
-            self.AutoGenMgr = AutoGenManager(auto_workers,feedback_q,error_event)
+            self.AutoGenMgr = AutoGenManager(auto_workers,feedback_q,error_event,Scheduler is not None)
             self.AutoGenMgr.start()
             for w in auto_workers:
                 w.start()
@@ -878,7 +957,17 @@ class Build():
                     # Force cache miss for PCD driver
                     if GlobalData.gBinCacheSource and self.Target in [None, "", "all"]:
                         cqueue.put((PcdMa.MetaFile.Path, PcdMa.Arch, "MakeCache", False))
-
+                    if Scheduler is not None:
+                        Scheduler.ModuleDone(PcdMa.MetaFile.Path, PcdMa.Arch)
+
+            if Scheduler is not None:
+                # Start the make of finished modules while waiting for the rest
+                while self.AutoGenMgr.is_alive() or not self.AutoGenMgr.done_q.empty():
+                    try:
+                        Path, Arch = self.AutoGenMgr.done_q.get(timeout=0.1)
+                    except Empty:
+                        continue
+                    Scheduler.ModuleDone(Path, Arch)
             self.AutoGenMgr.join()
             rt = self.AutoGenMgr.Status
             err = 0
@@ -2129,7 +2218,7 @@ class Build():
 
     ## Build a platform in multi-thread mode
     #
-    def PerformAutoGen(self,BuildTarget,ToolChain):
+    def PerformAutoGen(self,BuildTarget,ToolChain,ExitFlag=None):
         WorkspaceAutoGenTime = time.time()
         Wa = WorkspaceAutoGen(
                 self.WorkspaceDir,
@@ -2162,6 +2251,7 @@ class Build():
         BuildModules = []
         for Arch in Wa.ArchList:
             PcdMaList    = []
+            DriverList   = []
             AutoGenStart = time.time()
             GlobalData.gGlobalDefines['ARCH'] = Arch
             Pa = PlatformAutoGen(Wa, self.PlatformFile, BuildTarget, ToolChain, Arch)
@@ -2205,6 +2295,7 @@ class Build():
                     Ma.PlatformInfo = Pa
                     Ma.Workspace = Wa
                     PcdMaList.append(Ma)
+                DriverList.append(Ma)
                 self.AllDrivers.add(Ma)
                 self.AllModules.add(Ma)
 
@@ -2221,7 +2312,13 @@ class Build():
             Pa.DataPipe.dump(data_pipe_file)
 
             mqueue.put((None,None,None,None,None,None,None))
-            autogen_rt, errorcode = self.StartAutoGen(mqueue, Pa.DataPipe, self.SkipAutoGen, PcdMaList, cqueue)
+            #
+            # Overlap the make phase with AutoGen when every driver is going to be built
+            #
+            Scheduler = None
+            if ExitFlag is not None and not GlobalData.gUseHashCache and self.Target in [None, "", "all"]:
+                Scheduler = ModuleMakeScheduler(DriverList, Pa.BuildCommand, self.Target, self.ThreadNumber, ExitFlag)
+            autogen_rt, errorcode = self.StartAutoGen(mqueue, Pa.DataPipe, self.SkipAutoGen, PcdMaList, cqueue, Scheduler)
 
             if not autogen_rt:
                 self.AutoGenMgr.TerminateWorkers()
@@ -2277,12 +2374,12 @@ class Build():
                     Wa = self.VerifyAutoGenFiles()
                     if Wa is None:
                         self.SkipAutoGen = False
-                        Wa, self.BuildModules = self.PerformAutoGen(BuildTarget,ToolChain)
+                        Wa, self.BuildModules = self.PerformAutoGen(BuildTarget,ToolChain,ExitFlag)
                     else:
                         GlobalData.gAutoGenPhase = True
                         self.BuildModules = self.SetupMakeSetting(Wa)
                 else:
-                    Wa, self.BuildModules = self.PerformAutoGen(BuildTarget,ToolChain)
+                    Wa, self.BuildModules = self.PerformAutoGen(BuildTarget,ToolChain,ExitFlag)
                 Pa = Wa.AutoGenObjectList[0]
                 GlobalData.gAutoGenPhase = False
 
@@ -2495,6 +2592,10 @@ class Build():
             self.SpawnMode = False
             self._BuildModule()
 
+        MetaFileTableStore.Save()
+        if GlobalData.gUseHashCache:
+            SaveFileHashStore()
+
         if self.Target == 'cleanall':
             RemoveDirectory(os.path.dirname(GlobalData.gDatabasePath), True)
 
@@ -13,9 +13,13 @@ import os
 import sys
 import unittest
 
+import LzmaCompress
 import TianoCompress
+import VfrCompile
 modules = (
+    LzmaCompress,
     TianoCompress,
+    VfrCompile,
     )
 
 
@@ -0,0 +1,152 @@
+## @file
+# Unit tests for the DebugLogDecode utility
+#
+#  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+import os
+import struct
+import unittest
+
+import TestTools
+
+from DebugLogDecode.DebugLogDecode import DebugLogDecode
+
+DEBUG_LOG_BUFFER_HEADER = struct.Struct('<4sIIIII')
+DEBUG_LOG_BUFFER_FLAG_RECORDS = 0x2
+DEBUG_LOG_RECORD = struct.Struct('<HBBI')
+DEBUG_LOG_RECORD_TYPE_PADDING = 0
+DEBUG_LOG_RECORD_TYPE_TEXT = 1
+DEBUG_LOG_RECORD_TYPE_BINARY = 2
+DEBUG_LOG_RECORD_ARGUMENT_COUNT = 12
+
+DEBUG_INFO = 0x00000040
+DEBUG_ERROR = 0x80000000
+
+## A copy of the debug log, filled the way UefiDebugLibMemoryLog does.
+#
+class DebugLog(object):
+    def __init__(self, Size, Records):
+        self.Size = Size
+        self.Records = Records
+        self.Ring = bytearray(Size)
+        self.WriteOffset = 0
+
+    ## Copy data to the end of the ring, like DebugLogAppend().
+    def Append(self, Data):
+        Position = self.WriteOffset % self.Size
+        if self.Records and Position + len(Data) > self.Size:
+            Skip = self.Size - Position
+            DEBUG_LOG_RECORD.pack_into(self.Ring, Position, Skip - DEBUG_LOG_RECORD.size, DEBUG_LOG_RECORD_TYPE_PADDING, 0, 0)
+            self.WriteOffset += Skip
+            Position = 0
+        for Byte in Data:
+            self.Ring[Position] = Byte
+            Position = (Position + 1) % self.Size
+        self.WriteOffset += len(Data)
+
+    def AppendRecord(self, Type, ErrorLevel, Data):
+        Record = DEBUG_LOG_RECORD.pack(len(Data), Type, 0, ErrorLevel) + Data
+        self.Append(Record.ljust((len(Record) + 7) // 8 * 8, b'\0'))
+
+    def AppendText(self, Text, ErrorLevel = DEBUG_INFO):
+        self.AppendRecord(DEBUG_LOG_RECORD_TYPE_TEXT, ErrorLevel, Text)
+
+    ## Append a binary record. Each argument is a (size, value) pair, packed
+    #  in a multiple of WordSize bytes like BASE_ARG() does.
+    def AppendBinary(self, Format, Arguments, WordSize = 8, ErrorLevel = DEBUG_INFO):
+        Data = b''
+        for Size, Value in Arguments:
+            Data += (Value & ((1 << (Size * 8)) - 1)).to_bytes(Size, 'little')
+            Data = Data.ljust((len(Data) + WordSize - 1) // WordSize * WordSize, b'\0')
+        Data = Data.ljust(DEBUG_LOG_RECORD_ARGUMENT_COUNT * 8, b'\0') + Format + b'\0'
+        self.AppendRecord(DEBUG_LOG_RECORD_TYPE_BINARY, ErrorLevel, Data)
+
+    def Pack(self):
+        Flags = DEBUG_LOG_BUFFER_FLAG_RECORDS if self.Records else 0
+        WriteOffset = self.WriteOffset & 0xFFFFFFFF
+        return DEBUG_LOG_BUFFER_HEADER.pack(b'DLOG', self.Size, WriteOffset, WriteOffset, WriteOffset, Flags) + bytes(self.Ring)
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+
+    def Decode(self, Log, WordSize = 8):
+        self.WriteTmpFile('DebugLog.bin', Log.Pack())
+        DebugLogDecode(self.GetTmpFilePath('DebugLog.bin'), self.GetTmpFilePath('DebugLog.txt'), WordSize)
+        return self.ReadTmpFile('DebugLog.txt')
+
+    def testTextLog(self):
+        Log = DebugLog(64, False)
+        Log.Append(b'Hello\r\n')
+        Log.Append(b'World\r\n')
+        self.assertEqual(self.Decode(Log), 'Hello\nWorld\n')
+
+    def testWrappedTextLog(self):
+        Log = DebugLog(64, False)
+        for Index in range(10):
+            Log.Append(b'Message %d\n' % Index)
+        self.assertEqual(Log.WriteOffset, 100)
+        Expected = ''.join('Message %d\n' % Index for Index in range(10))
+        self.assertEqual(self.Decode(Log), Expected[-64:])
+
+    def testBinaryRecords(self):
+        Log = DebugLog(1024, True)
+        Log.AppendText(b'Loading driver\n')
+        Log.AppendBinary(b'Value %d 0x%x %08X\n', [(4, -5), (4, 255), (4, 0xABC)])
+        Log.AppendBinary(b'%a: %r, %,d|%-5d|%5d|%lx %c\n',
+                         [(8, 0), (8, 0x800000000000000E), (4, 1234567), (4, 42), (4, 7), (8, 0x123456789), (8, ord('Z'))],
+                         ErrorLevel = DEBUG_ERROR)
+        Log.AppendBinary(b'Base %p\n', [(8, 0xFFFE0000)])
+        self.assertEqual(
+            self.Decode(Log),
+            'Loading driver\n'
+            'Value -5 0xFF 00000ABC\n'
+            '<%a>: Not Found, 1,234,567|42   |    7|123456789 Z\n'
+            'Base FFFE0000\n'
+            )
+
+    def testIa32Records(self):
+        Log = DebugLog(1024, True)
+        Log.AppendBinary(b'%d %lx %p %r\n', [(4, -1), (8, 0x100000000), (4, 0x7FE00000), (4, 0x80000002)], WordSize = 4)
+        self.assertEqual(self.Decode(Log, WordSize = 4), '-1 100000000 7FE00000 Invalid Parameter\n')
+
+    ## The records written since the ring last wrapped are decoded. The record
+    #  that did not fit at the end of the ring was moved to its start, after a
+    #  padding record, and the records older than it are skipped.
+    def testWrappedRecords(self):
+        Log = DebugLog(256, True)
+        Log.AppendText(b'Boot started\n')
+        Log.AppendBinary(b'Value %d 0x%x\n', [(4, 1), (4, 2)])
+        Log.AppendBinary(b'Status %r\n', [(8, 0x800000000000000E)])
+        Log.AppendText(b'Done\n')
+
+        #
+        # 24 bytes of text and 120 bytes of binary record, 112 bytes of
+        # padding, then 120 bytes of binary record and 16 bytes of text.
+        #
+        self.assertEqual(Log.WriteOffset, 24 + 120 + 112 + 120 + 16)
+        DataSize, Type, Reserved, ErrorLevel = DEBUG_LOG_RECORD.unpack_from(Log.Ring, 24 + 120)
+        self.assertEqual(Type, DEBUG_LOG_RECORD_TYPE_PADDING)
+        self.assertEqual(DataSize, 112 - DEBUG_LOG_RECORD.size)
+
+        self.assertEqual(self.Decode(Log), 'Status Not Found\nDone\n')
+
+    def testPaddingRecord(self):
+        Log = DebugLog(256, True)
+        Log.AppendText(b'Before\n')
+        Log.AppendRecord(DEBUG_LOG_RECORD_TYPE_PADDING, 0, b'Skipped\n')
+        Log.AppendText(b'After\n')
+        self.assertEqual(self.Decode(Log), 'Before\nAfter\n')
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
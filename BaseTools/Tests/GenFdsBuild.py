@@ -0,0 +1,186 @@
+## @file
+# Unit tests for GenFds utility
+#
+#  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import print_function
+import os
+import sys
+import unittest
+
+import TestTools
+
+TargetTxt = '''\
+ACTIVE_PLATFORM       = Test.dsc
+TARGET                = DEBUG
+TARGET_ARCH           = X64
+TOOL_CHAIN_CONF       = Conf/tools_def.txt
+TOOL_CHAIN_TAG        = GCC5
+BUILD_RULE_CONF       = Conf/build_rule.txt
+'''
+
+ToolsDefTxt = '''\
+IDENTIFIER = GenFds unit test
+DEBUG_GCC5_X64_CC_PATH = gcc
+*_*_*_LZMA_PATH = LzmaCompress
+*_*_*_LZMA_GUID = EE4E5898-3914-4259-9D6E-DC7BD79403CF
+'''
+
+Dsc = '''\
+[Defines]
+  PLATFORM_NAME           = Test
+  PLATFORM_GUID           = 5B4C1E0A-9A6F-4C3B-8E2D-7F1A6C3B9D04
+  PLATFORM_VERSION        = 0.1
+  DSC_SPECIFICATION       = 0x00010005
+  OUTPUT_DIRECTORY        = Build/Test
+  SUPPORTED_ARCHITECTURES = X64
+  BUILD_TARGETS           = DEBUG
+  SKUID_IDENTIFIER        = DEFAULT
+  FLASH_DEFINITION        = Test.fdf
+'''
+
+#
+# Two compressed FV images nested inside the FV of the FD, each holding
+# several raw files.
+#
+Fdf = '''\
+[FD.TEST]
+BaseAddress   = 0xFF000000
+Size          = 0x00100000
+ErasePolarity = 1
+BlockSize     = 0x1000
+NumBlocks     = 0x100
+
+0x00000000|0x00100000
+FV = FVMAIN
+
+[FV.FVMAIN]
+BlockSize          = 0x1000
+FvAlignment        = 16
+ERASE_POLARITY     = 1
+MEMORY_MAPPED      = TRUE
+STICKY_WRITE       = TRUE
+LOCK_CAP           = TRUE
+LOCK_STATUS        = TRUE
+WRITE_DISABLED_CAP = TRUE
+WRITE_ENABLED_CAP  = TRUE
+WRITE_STATUS       = TRUE
+WRITE_LOCK_CAP     = TRUE
+WRITE_LOCK_STATUS  = TRUE
+READ_DISABLED_CAP  = TRUE
+READ_ENABLED_CAP   = TRUE
+READ_STATUS        = TRUE
+READ_LOCK_CAP      = TRUE
+READ_LOCK_STATUS   = TRUE
+
+FILE FV_IMAGE = 0B6F2B42-6A7C-4C1E-9D45-1E3A2F0C8B51 {
+  SECTION GUIDED EE4E5898-3914-4259-9D6E-DC7BD79403CF PROCESSING_REQUIRED = TRUE {
+    SECTION FV_IMAGE = FVINNER1
+  }
+}
+
+FILE FV_IMAGE = 0B6F2B42-6A7C-4C1E-9D45-1E3A2F0C8B52 {
+  SECTION GUIDED EE4E5898-3914-4259-9D6E-DC7BD79403CF PROCESSING_REQUIRED = TRUE {
+    SECTION FV_IMAGE = FVINNER2
+  }
+}
+'''
+
+InnerFv = '''
+[FV.%s]
+FvAlignment        = 16
+ERASE_POLARITY     = 1
+MEMORY_MAPPED      = TRUE
+STICKY_WRITE       = TRUE
+LOCK_CAP           = TRUE
+LOCK_STATUS        = TRUE
+WRITE_DISABLED_CAP = TRUE
+WRITE_ENABLED_CAP  = TRUE
+WRITE_STATUS       = TRUE
+WRITE_LOCK_CAP     = TRUE
+WRITE_LOCK_STATUS  = TRUE
+READ_DISABLED_CAP  = TRUE
+READ_ENABLED_CAP   = TRUE
+READ_STATUS        = TRUE
+READ_LOCK_CAP      = TRUE
+READ_LOCK_STATUS   = TRUE
+'''
+
+RawFile = '''
+FILE RAW = 7D2E5A10-3C4B-4F6E-8A9D-%012X {
+  SECTION RAW = %s
+}
+'''
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        self.toolName = 'GenFds'
+        self.savedEnviron = os.environ.copy()
+        os.environ['WORKSPACE'] = self.testDir
+        os.environ.setdefault('PYTHON_COMMAND', sys.executable)
+
+    def tearDown(self):
+        TestTools.BaseToolsTest.tearDown(self)
+        os.environ.clear()
+        os.environ.update(self.savedEnviron)
+
+    def genWorkspace(self):
+        os.mkdir(self.GetTmpFilePath('Conf'))
+        self.WriteTmpFile(os.path.join('Conf', 'target.txt'), TargetTxt)
+        self.WriteTmpFile(os.path.join('Conf', 'tools_def.txt'), ToolsDefTxt)
+        self.WriteTmpFile(os.path.join('Conf', 'build_rule.txt'), '')
+        self.WriteTmpFile('Test.dsc', Dsc)
+        fdf = [Fdf]
+        for fv in range(2):
+            fdf.append(InnerFv % ('FVINNER%d' % (fv + 1)))
+            for index in range(4):
+                name = 'Raw%d%d.bin' % (fv, index)
+                self.WriteTmpFile(name, self.GetRandomString(0x800, 0x2000).encode('latin-1') * 4)
+                fdf.append(RawFile % (fv * 0x100 + index, name))
+        self.WriteTmpFile('Test.fdf', ''.join(fdf))
+
+    def genFd(self, *options):
+        self.RemoveFileOrDir(self.GetTmpFilePath('Build'))
+        os.makedirs(self.GetTmpFilePath(os.path.join('Build', 'Test', 'DEBUG_GCC5')))
+        result = self.RunTool(
+            '-f', self.GetTmpFilePath('Test.fdf'),
+            '-p', self.GetTmpFilePath('Test.dsc'),
+            '-w', self.testDir,
+            '-a', 'X64',
+            '-b', 'DEBUG',
+            '-t', 'GCC5',
+            *options,
+            logFile='log'
+            )
+        if result != 0:
+            self.DisplayFile('log')
+        self.assertTrue(result == 0)
+        with open(self.GetTmpFilePath(os.path.join('Build', 'Test', 'DEBUG_GCC5', 'FV', 'TEST.fd')), 'rb') as f:
+            return f.read()
+
+    def testSameFdfGivesSameFd(self):
+        #
+        # The second build takes the compressed sections from the tool
+        # output cache of the first one, the third one does not use it.
+        #
+        self.genWorkspace()
+        first = self.genFd()
+        self.assertTrue(os.path.isdir(self.GetTmpFilePath(os.path.join('Conf', '.cache', 'GenFds'))))
+        second = self.genFd()
+        self.assertTrue(first == second)
+        third = self.genFd('--no-genfds-cache')
+        self.assertTrue(first == third)
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -0,0 +1,68 @@
+## @file
+# Unit tests for LzmaCompress utility
+#
+#  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import print_function
+import os
+import random
+import sys
+import unittest
+
+import TestTools
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        self.toolName = 'LzmaCompress'
+
+    def testHelp(self):
+        result = self.RunTool('--help', logFile='help')
+        self.assertTrue(result == 0)
+
+    def compressionTestCycle(self, data, *options):
+        self.WriteTmpFile('input', data)
+        result = self.RunTool(
+            '-e', '-q',
+            '-o', self.GetTmpFilePath('output1'),
+            *(options + (self.GetTmpFilePath('input'),))
+            )
+        self.assertTrue(result == 0)
+        result = self.RunTool(
+            '-d', '-q',
+            '-o', self.GetTmpFilePath('output2'),
+            self.GetTmpFilePath('output1')
+            )
+        self.assertTrue(result == 0)
+        self.assertTrue(self.ReadTmpFile('input') == self.ReadTmpFile('output2'))
+        with open(self.GetTmpFilePath('output1'), 'rb') as f:
+            return f.read()
+
+    def testRandomDataCycles(self):
+        for i in range(8):
+            data = self.GetRandomString(1024, 2048)
+            self.compressionTestCycle(data)
+            self.CleanUpTmpDir()
+
+    def testThreadsGiveSameOutput(self):
+        #
+        # The match finder thread must not change the compressed data.
+        #
+        data = ''.join(self.GetRandomString(16, 64) * random.randint(1, 8) for i in range(0x4000))
+        single = self.compressionTestCycle(data, '--threads', '1')
+        double = self.compressionTestCycle(data, '--threads', '2')
+        self.assertTrue(single == double)
+        self.assertTrue(single == self.compressionTestCycle(data))
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -20,6 +20,10 @@ def TheTestSuite():
     suites.append(CheckPythonSyntax.TheTestSuite())
     import CheckUnicodeSourceFiles
     suites.append(CheckUnicodeSourceFiles.TheTestSuite())
+    import GenFdsBuild
+    suites.append(GenFdsBuild.TheTestSuite())
+    import DebugLogDecoding
+    suites.append(DebugLogDecoding.TheTestSuite())
     return unittest.TestSuite(suites)
 
 if __name__ == '__main__':
@@ -0,0 +1,91 @@
+## @file
+# Unit tests for VfrCompile utility
+#
+#  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+#
+#  SPDX-License-Identifier: BSD-2-Clause-Patent
+#
+
+##
+# Import Modules
+#
+from __future__ import print_function
+import os
+import sys
+import time
+import unittest
+
+import TestTools
+
+FormSetGuid = '{ 0x1d6a5b8e, 0x3c7f, 0x4a9e, { 0x8b, 0x2d, 0x51, 0x0c, 0x6e, 0x94, 0xa7, 0x3f } }'
+
+class Tests(TestTools.BaseToolsTest):
+
+    def setUp(self):
+        TestTools.BaseToolsTest.setUp(self)
+        self.toolName = 'VfrCompile'
+
+    def genLargeFormSet(self, count):
+        #
+        # The VFR is written in its preprocessed form, so no package
+        # include paths or string definitions are needed to compile it.
+        #
+        lines = ['typedef struct {']
+        lines += ['  UINT8 Field%d;' % i for i in range(count)]
+        lines.append('} BENCH_DATA;')
+        lines.append('formset guid = %s, title = STRING_TOKEN(0x0002), help = STRING_TOKEN(0x0003),' % FormSetGuid)
+        lines.append('  varstore BENCH_DATA, varid = 0x1000, name = Bench, guid = %s;' % FormSetGuid)
+        lines.append('  form formid = 1, title = STRING_TOKEN(0x0002);')
+        for i in range(count):
+            lines.append(
+                '    numeric name = Q%d, varid = Bench.Field%d, prompt = STRING_TOKEN(0x0004), '
+                'help = STRING_TOKEN(0x0004), minimum = 0, maximum = 255, endnumeric;' % (i, i)
+                )
+        lines.append('  endform;')
+        lines.append('endformset;')
+        return '\n'.join(lines) + '\n'
+
+    def testLargeFormSet(self):
+        #
+        # A form set with thousands of questions used to take quadratic time
+        # in the question, varstore, data type and record list lookups.
+        #
+        count = 5000
+        self.WriteTmpFile('Large.i', self.genLargeFormSet(count))
+        start = time.time()
+        result = self.RunTool(
+            '-l',
+            '-o', self.testDir,
+            self.GetTmpFilePath('Large.i')
+            )
+        elapsed = time.time() - start
+        self.assertTrue(result == 0)
+        self.assertTrue(os.path.exists(self.GetTmpFilePath('Large.c')))
+        listing = self.ReadTmpFile('Large.lst')
+        self.assertTrue(listing.count('\n>') >= 2 * count)
+        print()
+        print('VfrCompile: %d questions compiled in %.2f seconds' % (count, elapsed))
+
+    def testMultipleFiles(self):
+        #
+        # Each file named on the command line is compiled on its own, so the
+        # same form id, varstore and question names may appear in all of them.
+        #
+        names = ['First', 'Second', 'Third']
+        for name in names:
+            self.WriteTmpFile(name + '.i', self.genLargeFormSet(10))
+        result = self.RunTool(
+            '-l',
+            '-o', self.testDir,
+            *[self.GetTmpFilePath(name + '.i') for name in names]
+            )
+        self.assertTrue(result == 0)
+        for name in names:
+            self.assertTrue(os.path.exists(self.GetTmpFilePath(name + '.c')))
+        self.assertEqual(self.ReadTmpFile('First.lst'), self.ReadTmpFile('Third.lst').replace('Third', 'First'))
+
+TheTestSuite = TestTools.MakeTheTestSuite(locals())
+
+if __name__ == '__main__':
+    allTests = TheTestSuite()
+    unittest.TextTestRunner().run(allTests)
@@ -641,6 +641,62 @@ EnablePageTableProtection (
   AsmWriteCr0 (AsmReadCr0() | CR0_WP);
 }
 
+/**
+  Return the highest address that the HOB list describes.
+
+  Resource descriptors, memory allocations and firmware volumes are taken into
+  account, as well as the stack and GHCB ranges handed to the DXE core. The
+  returned address is never below 4GB so that the legacy MMIO hole is always
+  covered by the identity mapping.
+
+  @param[in] StackBase  Stack base address.
+  @param[in] StackSize  Stack size.
+  @param[in] GhcbBase   GHCB base address.
+  @param[in] GhcbSize   GHCB size.
+
+  @return The exclusive top of the address space described by the HOB list.
+
+**/
+UINT64
+GetHighestDescribedAddress (
+  IN EFI_PHYSICAL_ADDRESS   StackBase,
+  IN UINTN                  StackSize,
+  IN EFI_PHYSICAL_ADDRESS   GhcbBase,
+  IN UINTN                  GhcbSize
+  )
+{
+  EFI_PEI_HOB_POINTERS      Hob;
+  UINT64                    Top;
+
+  Top = MAX (SIZE_4GB, StackBase + StackSize);
+  Top = MAX (Top, GhcbBase + GhcbSize);
+
+  for (Hob.Raw = GetHobList (); !END_OF_HOB_LIST (Hob); Hob.Raw = GET_NEXT_HOB (Hob)) {
+    switch (GET_HOB_TYPE (Hob)) {
+    case EFI_HOB_TYPE_RESOURCE_DESCRIPTOR:
+      Top = MAX (
+              Top,
+              Hob.ResourceDescriptor->PhysicalStart + Hob.ResourceDescriptor->ResourceLength
+              );
+      break;
+    case EFI_HOB_TYPE_MEMORY_ALLOCATION:
+      Top = MAX (
+              Top,
+              Hob.MemoryAllocation->AllocDescriptor.MemoryBaseAddress +
+              Hob.MemoryAllocation->AllocDescriptor.MemoryLength
+              );
+      break;
+    case EFI_HOB_TYPE_FV:
+      Top = MAX (Top, Hob.FirmwareVolume->BaseAddress + Hob.FirmwareVolume->Length);
+      break;
+    default:
+      break;
+    }
+  }
+
+  return Top;
+}
+
 /**
   Allocates and fills in the Page Directory and Page Table Entries to
   establish a 1:1 Virtual to Physical mapping.
@@ -686,6 +742,7 @@ CreateIdentityMappingPageTables (
   PAGE_TABLE_1G_ENTRY                           *PageDirectory1GEntry;
   UINT64                                        AddressEncMask;
   IA32_CR4                                      Cr4;
+  UINT64                                        DescribedTop;
 
   //
   // Set PageMapLevel5Entry to suppress incorrect compiler/analyzer warnings
@@ -747,6 +804,19 @@ CreateIdentityMappingPageTables (
     PhysicalAddressBits = 48;
   }
 
+  //
+  // Only map the address space the HOB list describes when requested by the
+  // platform. A 52-bit identity map needs tens of MB of page tables, most of
+  // which cover addresses that can never be accessed.
+  //
+  if (PcdGetBool (PcdDxeIplLimitIdentityMapToHobs)) {
+    DescribedTop = GetHighestDescribedAddress (StackBase, StackSize, GhcbBase, GhcbSize);
+    if (HighBitSet64 (DescribedTop - 1) + 1 < PhysicalAddressBits) {
+      PhysicalAddressBits = (UINT8) (HighBitSet64 (DescribedTop - 1) + 1);
+      DEBUG ((DEBUG_INFO, "Identity map limited to %u address bits\n", PhysicalAddressBits));
+    }
+  }
+
   //
   // Calculate the table entries needed.
   //
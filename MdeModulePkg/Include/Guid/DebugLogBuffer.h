@@ -0,0 +1,125 @@
+/** @file
+  GUID and structure of the in-memory debug message log.
+
+  The log is produced by DebugLogDxe and installed in the EFI System Table
+  configuration table. DEBUG() messages of modules linked with
+  UefiDebugLibMemoryLog are appended to it without waiting for the serial
+  port, and DebugLogDxe sends them to the serial port from a timer event.
+  The buffer is allocated from EfiRuntimeServicesData, so the messages can
+  still be read by the OS after boot.
+
+  When DEBUG_LOG_BUFFER_FLAG_RECORDS is set, the ring holds DEBUG_LOG_RECORD
+  entries instead of plain text. A DEBUG() message is then stored as its
+  format string and its arguments packed as a BASE_LIST, and is only
+  formatted by DebugLogDxe when it is drained, or by the DebugLogDecode tool
+  from a copy of the buffer.
+
+Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __DEBUG_LOG_BUFFER_H__
+#define __DEBUG_LOG_BUFFER_H__
+
+#define EDKII_DEBUG_LOG_BUFFER_GUID \
+  { \
+    0x904f00ca, 0xee8c, 0x4e5e, { 0x8c, 0x13, 0xac, 0x83, 0x53, 0xae, 0xe8, 0xbb } \
+  }
+
+#define DEBUG_LOG_BUFFER_SIGNATURE  SIGNATURE_32 ('D', 'L', 'O', 'G')
+
+///
+/// Once set, nobody drains the log any more, so writers also send their
+/// messages to the serial port directly.
+///
+#define DEBUG_LOG_BUFFER_FLAG_SYNCHRONOUS  BIT0
+
+///
+/// The ring holds DEBUG_LOG_RECORD entries. Set by DebugLogDxe before the log
+/// is installed, and never changed afterwards.
+///
+#define DEBUG_LOG_BUFFER_FLAG_RECORDS      BIT1
+
+///
+/// Header of the debug message log. It is followed by Size bytes of message
+/// text used as a ring.
+///
+/// All offsets count bytes since the log was created and wrap at 4GB. The
+/// position of an offset in the ring is (Offset & (Size - 1)).
+///
+typedef struct {
+  ///
+  /// DEBUG_LOG_BUFFER_SIGNATURE.
+  ///
+  UINT32           Signature;
+  ///
+  /// Size of the ring in bytes. Always a power of two.
+  ///
+  UINT32           Size;
+  ///
+  /// End of the space reserved by writers.
+  ///
+  volatile UINT32  WriteOffset;
+  ///
+  /// Number of bytes writers have finished copying. Equal to WriteOffset when
+  /// no message is being written.
+  ///
+  volatile UINT32  CommitOffset;
+  ///
+  /// End of the text already sent to the serial port.
+  ///
+  volatile UINT32  DrainOffset;
+  ///
+  /// DEBUG_LOG_BUFFER_FLAG_* bits.
+  ///
+  volatile UINT32  Flags;
+} DEBUG_LOG_BUFFER;
+
+///
+/// Skipped. Fills the end of the ring when the next record does not fit
+/// before the ring wraps, so that a record is never split.
+///
+#define DEBUG_LOG_RECORD_TYPE_PADDING  0
+///
+/// The data is the message text, not Null-terminated.
+///
+#define DEBUG_LOG_RECORD_TYPE_TEXT     1
+///
+/// The data is DEBUG_LOG_RECORD_ARGUMENT_COUNT UINT64 holding the message
+/// arguments as a BASE_LIST, followed by the Null-terminated format string.
+///
+#define DEBUG_LOG_RECORD_TYPE_BINARY   2
+
+#define DEBUG_LOG_RECORD_ARGUMENT_COUNT  12
+
+///
+/// Records start at offsets aligned on this value, so the BASE_LIST of a
+/// binary record can be used in place.
+///
+#define DEBUG_LOG_RECORD_ALIGNMENT       8
+
+///
+/// Header of a record in the ring. The record takes
+/// ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + DataSize, DEBUG_LOG_RECORD_ALIGNMENT)
+/// bytes.
+///
+typedef struct {
+  ///
+  /// Size in bytes of the data following the header.
+  ///
+  UINT16  DataSize;
+  ///
+  /// DEBUG_LOG_RECORD_TYPE_*.
+  ///
+  UINT8   Type;
+  UINT8   Reserved;
+  ///
+  /// The error level passed to DEBUG().
+  ///
+  UINT32  ErrorLevel;
+} DEBUG_LOG_RECORD;
+
+extern EFI_GUID gEdkiiDebugLogBufferGuid;
+
+#endif
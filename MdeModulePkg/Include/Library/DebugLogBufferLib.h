@@ -0,0 +1,117 @@
+/** @file
+  Provides services to append messages to the in-memory debug log and to
+  send them to an output device.
+
+  They are shared by UefiDebugLibMemoryLog, which appends the messages, and
+  DebugLogDxe, which drains the log from a timer event. UefiDebugLibMemoryLog
+  also drains the log itself before an ASSERT() or DEBUG_ERROR message, so
+  these services do not print DEBUG() messages.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __DEBUG_LOG_BUFFER_LIB_H__
+#define __DEBUG_LOG_BUFFER_LIB_H__
+
+#include <Guid/DebugLogBuffer.h>
+
+/**
+  Write data to an output device, such as SerialPortWrite().
+
+  @param  Buffer         The data to write.
+  @param  NumberOfBytes  The number of bytes to write.
+
+  @return The number of bytes written.
+
+**/
+typedef
+UINTN
+(EFIAPI *DEBUG_LOG_OUTPUT)(
+  IN UINT8  *Buffer,
+  IN UINTN  NumberOfBytes
+  );
+
+/**
+  Copy data to the end of the debug log.
+
+  Space is reserved with a compare exchange on WriteOffset, so data written
+  from a higher TPL while other data is being copied gets its own space.
+  CommitOffset only reaches WriteOffset once every reservation has been
+  copied.
+
+  When the log holds records, a record that would cross the end of the ring
+  is moved to its start, and the skipped space is marked as a padding record.
+
+  @param  DebugLog    The debug log.
+  @param  Buffer      The data to copy. When the log holds records, it is a
+                      whole DEBUG_LOG_RECORD.
+  @param  Length      The length of the data in bytes. It is not larger than
+                      the ring.
+
+**/
+VOID
+EFIAPI
+DebugLogAppend (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN CONST VOID        *Buffer,
+  IN UINT32            Length
+  );
+
+/**
+  Send some of the messages appended since the last drain to an output
+  device.
+
+  It stops once MaxLength bytes have been sent, and the messages left are
+  sent by the next drain. Text is split anywhere, but records are sent whole:
+  the first record is sent even if it is longer than MaxLength, and no other
+  record is sent past MaxLength.
+
+  Messages that were overwritten before they could be sent are skipped. When
+  the log holds records, the start of the first record left is only known at
+  the start of the ring, where DebugLogAppend() puts the first record of each
+  lap. So a line saying that messages were lost is sent, then the records of
+  the current lap. Binary records are formatted before they are sent.
+
+  DrainOffset is only moved once the messages are sent, and only if nobody
+  else moved it meanwhile. A drain that interrupts another one may send some
+  messages twice, but no message is lost.
+
+  @param  DebugLog    The debug log.
+  @param  Output      The function the messages are sent to.
+  @param  MaxLength   The number of bytes to send at most.
+
+  @retval TRUE        All the messages in the log have been sent.
+  @retval FALSE       Some messages are left in the log, or a message is
+                      still being copied into the log, so nothing was sent.
+
+**/
+BOOLEAN
+EFIAPI
+DebugLogDrainPartial (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN DEBUG_LOG_OUTPUT  Output,
+  IN UINTN             MaxLength
+  );
+
+/**
+  Send all the messages appended since the last drain to an output device,
+  as DebugLogDrainPartial() does without a length limit.
+
+  @param  DebugLog    The debug log.
+  @param  Output      The function the messages are sent to.
+
+  @retval TRUE        All the messages in the log have been sent.
+  @retval FALSE       A message is still being copied into the log, so
+                      nothing was sent.
+
+**/
+BOOLEAN
+EFIAPI
+DebugLogDrain (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN DEBUG_LOG_OUTPUT  Output
+  );
+
+#endif
@@ -0,0 +1,85 @@
+/** @file
+  Provides services to fill large buffers using all the enabled processors.
+
+  These services are intended for fills that are large enough to be bound by
+  memory bandwidth, such as clearing system memory on a Memory Overwrite
+  Request. The buffer is split into chunks that are filled by the APs through
+  the MP services protocol. Small buffers, or platforms without MP services,
+  are filled on the calling processor.
+
+  These services must be called from the BSP.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef __PARALLEL_MEMORY_LIB_H__
+#define __PARALLEL_MEMORY_LIB_H__
+
+/**
+  Fills a target buffer with a byte value, using all the enabled processors.
+
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The memory to set.
+  @param[in]  Length  The number of bytes to set.
+  @param[in]  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelSetMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length,
+  IN  UINT8  Value
+  );
+
+/**
+  Fills a target buffer with zeros, using all the enabled processors.
+
+  If Buffer is NULL and Length > 0, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The pointer to the target buffer to fill with zeros.
+  @param[in]  Length  The number of bytes in Buffer to fill with zeros.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelZeroMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length
+  );
+
+/**
+  Fills all the free system memory with zeros, using all the enabled
+  processors.
+
+  Each free memory range of the UEFI memory map is allocated while it is
+  cleared, so that it can not be handed out to another agent during the
+  clear, and is freed again afterwards. A range that has been partly
+  consumed since the memory map was taken is split, and its free parts are
+  cleared. The first page of memory is never cleared so that NULL pointer
+  detection keeps working, and ranges above MAX_ADDRESS are skipped.
+
+  @param[out] ClearedSize  Optional. Return the number of bytes cleared.
+
+  @retval EFI_SUCCESS           All the free memory has been cleared.
+  @retval EFI_ABORTED           Some free memory could not be claimed, and
+                                has not been cleared.
+  @retval EFI_OUT_OF_RESOURCES  No memory to hold the memory map.
+  @retval Others                Failed to get the memory map.
+
+**/
+EFI_STATUS
+EFIAPI
+ParallelClearFreeMemory (
+  OUT UINT64  *ClearedSize  OPTIONAL
+  );
+
+#endif
@@ -0,0 +1,261 @@
+/** @file
+  Append messages to the in-memory debug log and send them to an output
+  device.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi/UefiBaseType.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLogBufferLib.h>
+#include <Library/PrintLib.h>
+#include <Library/SynchronizationLib.h>
+
+//
+// Size of the buffer binary records are formatted in, the same as the
+// maximum message length of UefiDebugLibMemoryLog
+//
+#define DEBUG_LOG_MESSAGE_LENGTH  0x100
+
+/**
+  Copy data to the end of the debug log.
+
+  Space is reserved with a compare exchange on WriteOffset, so data written
+  from a higher TPL while other data is being copied gets its own space.
+  CommitOffset only reaches WriteOffset once every reservation has been
+  copied.
+
+  When the log holds records, a record that would cross the end of the ring
+  is moved to its start, and the skipped space is marked as a padding record.
+
+  @param  DebugLog    The debug log.
+  @param  Buffer      The data to copy. When the log holds records, it is a
+                      whole DEBUG_LOG_RECORD.
+  @param  Length      The length of the data in bytes. It is not larger than
+                      the ring.
+
+**/
+VOID
+EFIAPI
+DebugLogAppend (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN CONST VOID        *Buffer,
+  IN UINT32            Length
+  )
+{
+  UINT8             *Data;
+  DEBUG_LOG_RECORD  *Padding;
+  UINT32            Offset;
+  UINT32            Position;
+  UINT32            Skip;
+  UINT32            Count;
+
+  Data = (UINT8 *) (DebugLog + 1);
+
+  do {
+    Offset   = DebugLog->WriteOffset;
+    Position = Offset & (DebugLog->Size - 1);
+    Skip     = 0;
+    if (((DebugLog->Flags & DEBUG_LOG_BUFFER_FLAG_RECORDS) != 0) &&
+        (Position + Length > DebugLog->Size)) {
+      Skip = DebugLog->Size - Position;
+    }
+  } while (InterlockedCompareExchange32 (&DebugLog->WriteOffset, Offset, Offset + Skip + Length) != Offset);
+
+  if (Skip != 0) {
+    Padding             = (DEBUG_LOG_RECORD *) (Data + Position);
+    Padding->DataSize   = (UINT16) (Skip - sizeof (DEBUG_LOG_RECORD));
+    Padding->Type       = DEBUG_LOG_RECORD_TYPE_PADDING;
+    Padding->Reserved   = 0;
+    Padding->ErrorLevel = 0;
+    Position            = 0;
+  }
+
+  Count = MIN (Length, DebugLog->Size - Position);
+  CopyMem (Data + Position, Buffer, Count);
+  CopyMem (Data, (UINT8 *) Buffer + Count, Length - Count);
+
+  do {
+    Offset = DebugLog->CommitOffset;
+  } while (InterlockedCompareExchange32 (&DebugLog->CommitOffset, Offset, Offset + Skip + Length) != Offset);
+}
+
+/**
+  Send the records between DrainOffset and WriteOffset to an output device,
+  formatting the binary ones.
+
+  Records are sent whole. The first record is sent even if it is longer than
+  MaxLength, so that a long message can not stop the drain.
+
+  @param  DebugLog     The debug log. It holds records.
+  @param  DrainOffset  On input, the offset of the first record. On output,
+                       the offset of the first record not sent.
+  @param  WriteOffset  The end of the last record.
+  @param  Output       The function the messages are sent to.
+  @param  MaxLength    The number of bytes after which no other record is
+                       sent.
+
+**/
+STATIC
+VOID
+DebugLogDrainRecords (
+  IN     DEBUG_LOG_BUFFER  *DebugLog,
+  IN OUT UINT32            *DrainOffset,
+  IN     UINT32            WriteOffset,
+  IN     DEBUG_LOG_OUTPUT  Output,
+  IN     UINTN             MaxLength
+  )
+{
+  DEBUG_LOG_RECORD  *Record;
+  CHAR8             Buffer[DEBUG_LOG_MESSAGE_LENGTH];
+  CHAR8             *Message;
+  UINTN             Length;
+  UINTN             Sent;
+
+  Sent = 0;
+  while ((INT32) (WriteOffset - *DrainOffset) > 0) {
+    Record = (DEBUG_LOG_RECORD *) ((UINT8 *) (DebugLog + 1) + (*DrainOffset & (DebugLog->Size - 1)));
+    switch (Record->Type) {
+    case DEBUG_LOG_RECORD_TYPE_TEXT:
+      Message = (CHAR8 *) (Record + 1);
+      Length  = Record->DataSize;
+      break;
+
+    case DEBUG_LOG_RECORD_TYPE_BINARY:
+      Message = Buffer;
+      Length  = AsciiBSPrint (
+                  Buffer,
+                  sizeof (Buffer),
+                  (CHAR8 *) ((UINT64 *) (Record + 1) + DEBUG_LOG_RECORD_ARGUMENT_COUNT),
+                  (BASE_LIST) (Record + 1)
+                  );
+      break;
+
+    default:
+      Message = NULL;
+      Length  = 0;
+      break;
+    }
+
+    if (Length != 0) {
+      if ((Sent != 0) && ((Sent >= MaxLength) || (Length > MaxLength - Sent))) {
+        break;
+      }
+
+      Output ((UINT8 *) Message, Length);
+      Sent += Length;
+    }
+    *DrainOffset += (UINT32) ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + Record->DataSize, DEBUG_LOG_RECORD_ALIGNMENT);
+  }
+}
+
+/**
+  Send some of the messages appended since the last drain to an output
+  device.
+
+  It stops once MaxLength bytes have been sent, and the messages left are
+  sent by the next drain. Text is split anywhere, but records are sent whole:
+  the first record is sent even if it is longer than MaxLength, and no other
+  record is sent past MaxLength.
+
+  Messages that were overwritten before they could be sent are skipped. When
+  the log holds records, the start of the first record left is only known at
+  the start of the ring, where DebugLogAppend() puts the first record of each
+  lap. So a line saying that messages were lost is sent, then the records of
+  the current lap. Binary records are formatted before they are sent.
+
+  DrainOffset is only moved once the messages are sent, and only if nobody
+  else moved it meanwhile. A drain that interrupts another one may send some
+  messages twice, but no message is lost.
+
+  @param  DebugLog    The debug log.
+  @param  Output      The function the messages are sent to.
+  @param  MaxLength   The number of bytes to send at most.
+
+  @retval TRUE        All the messages in the log have been sent.
+  @retval FALSE       Some messages are left in the log, or a message is
+                      still being copied into the log, so nothing was sent.
+
+**/
+BOOLEAN
+EFIAPI
+DebugLogDrainPartial (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN DEBUG_LOG_OUTPUT  Output,
+  IN UINTN             MaxLength
+  )
+{
+  CONST CHAR8  *Lost;
+  UINT8        *Data;
+  UINT32       WriteOffset;
+  UINT32       StartOffset;
+  UINT32       DrainOffset;
+  UINT32       Position;
+  UINTN        Count;
+  UINTN        Sent;
+
+  WriteOffset = DebugLog->WriteOffset;
+  if (DebugLog->CommitOffset != WriteOffset) {
+    return FALSE;
+  }
+
+  StartOffset = DebugLog->DrainOffset;
+  DrainOffset = StartOffset;
+  if ((DebugLog->Flags & DEBUG_LOG_BUFFER_FLAG_RECORDS) != 0) {
+    if (WriteOffset - DrainOffset > DebugLog->Size) {
+      Lost = "\n[DebugLogDxe: debug messages lost]\n";
+      Output ((UINT8 *) Lost, AsciiStrLen (Lost));
+      //
+      // The current lap starts with a record, and has not been overwritten.
+      //
+      DrainOffset = (WriteOffset - 1) & ~(DebugLog->Size - 1);
+    }
+    DebugLogDrainRecords (DebugLog, &DrainOffset, WriteOffset, Output, MaxLength);
+  } else {
+    if (WriteOffset - DrainOffset > DebugLog->Size) {
+      DrainOffset = WriteOffset - DebugLog->Size;
+    }
+
+    Data = (UINT8 *) (DebugLog + 1);
+    Sent = 0;
+    while ((DrainOffset != WriteOffset) && (Sent < MaxLength)) {
+      Position = DrainOffset & (DebugLog->Size - 1);
+      Count    = MIN (WriteOffset - DrainOffset, DebugLog->Size - Position);
+      Count    = MIN (Count, MaxLength - Sent);
+      Output (Data + Position, Count);
+      DrainOffset += (UINT32) Count;
+      Sent        += Count;
+    }
+  }
+
+  //
+  // A drain that interrupted this one has already moved DrainOffset further.
+  //
+  InterlockedCompareExchange32 (&DebugLog->DrainOffset, StartOffset, DrainOffset);
+  return (BOOLEAN) (DrainOffset == WriteOffset);
+}
+
+/**
+  Send all the messages appended since the last drain to an output device,
+  as DebugLogDrainPartial() does without a length limit.
+
+  @param  DebugLog    The debug log.
+  @param  Output      The function the messages are sent to.
+
+  @retval TRUE        All the messages in the log have been sent.
+  @retval FALSE       A message is still being copied into the log, so
+                      nothing was sent.
+
+**/
+BOOLEAN
+EFIAPI
+DebugLogDrain (
+  IN DEBUG_LOG_BUFFER  *DebugLog,
+  IN DEBUG_LOG_OUTPUT  Output
+  )
+{
+  return DebugLogDrainPartial (DebugLog, Output, MAX_UINTN);
+}
@@ -0,0 +1,687 @@
+/** @file
+  Unit tests of the BaseDebugLogBufferLib
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include <Uefi.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+
+#include <Library/UnitTestLib.h>
+#include <Library/DebugLogBufferLib.h>
+
+#define UNIT_TEST_APP_NAME        "BaseDebugLogBufferLib Unit Tests"
+#define UNIT_TEST_APP_VERSION     "1.0"
+
+#define TEST_RING_SIZE            64
+#define TEST_RING_SIZE_MAX        256
+#define TEST_OUTPUT_SIZE          512
+
+//
+// The debug log used by the tests, followed by its ring
+//
+UINT64            mDebugLogBuffer[(sizeof (DEBUG_LOG_BUFFER) + TEST_RING_SIZE_MAX) / sizeof (UINT64)];
+DEBUG_LOG_BUFFER  *mDebugLog = (DEBUG_LOG_BUFFER *) mDebugLogBuffer;
+
+//
+// What DebugLogDrain() sent to TestOutput()
+//
+CHAR8  mOutput[TEST_OUTPUT_SIZE];
+UINTN  mOutputLength;
+
+/**
+  Output function of DebugLogDrain() that saves what it is given in mOutput.
+
+  @param  Buffer         The data to write.
+  @param  NumberOfBytes  The number of bytes to write.
+
+  @return The number of bytes written.
+
+**/
+UINTN
+EFIAPI
+TestOutput (
+  IN UINT8  *Buffer,
+  IN UINTN  NumberOfBytes
+  )
+{
+  NumberOfBytes = MIN (NumberOfBytes, sizeof (mOutput) - mOutputLength);
+  CopyMem (mOutput + mOutputLength, Buffer, NumberOfBytes);
+  mOutputLength += NumberOfBytes;
+  return NumberOfBytes;
+}
+
+/**
+  Reset the debug log and the saved output.
+
+  @param  Size     The size of the ring.
+  @param  Offset   The initial WriteOffset, CommitOffset and DrainOffset.
+  @param  Records  TRUE if the ring holds records.
+
+**/
+VOID
+InitDebugLog (
+  IN UINT32   Size,
+  IN UINT32   Offset,
+  IN BOOLEAN  Records
+  )
+{
+  SetMem (mDebugLogBuffer, sizeof (mDebugLogBuffer), 0xAF);
+  mDebugLog->Signature    = DEBUG_LOG_BUFFER_SIGNATURE;
+  mDebugLog->Size         = Size;
+  mDebugLog->WriteOffset  = Offset;
+  mDebugLog->CommitOffset = Offset;
+  mDebugLog->DrainOffset  = Offset;
+  mDebugLog->Flags        = Records ? DEBUG_LOG_BUFFER_FLAG_RECORDS : 0;
+
+  ZeroMem (mOutput, sizeof (mOutput));
+  mOutputLength = 0;
+}
+
+/**
+  Append a text record holding a message to the debug log.
+
+  @param  Message  The Null-terminated message.
+
+  @return The number of bytes the record takes in the ring.
+
+**/
+UINT32
+AppendTextRecord (
+  IN CONST CHAR8  *Message
+  )
+{
+  UINT64            RecordBuffer[TEST_RING_SIZE / sizeof (UINT64)];
+  DEBUG_LOG_RECORD  *Record;
+  UINT32            Length;
+
+  Record             = (DEBUG_LOG_RECORD *) RecordBuffer;
+  Record->DataSize   = (UINT16) AsciiStrLen (Message);
+  Record->Type       = DEBUG_LOG_RECORD_TYPE_TEXT;
+  Record->Reserved   = 0;
+  Record->ErrorLevel = DEBUG_INFO;
+  CopyMem (Record + 1, Message, Record->DataSize);
+
+  Length = (UINT32) ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + Record->DataSize, DEBUG_LOG_RECORD_ALIGNMENT);
+  DebugLogAppend (mDebugLog, Record, Length);
+  return Length;
+}
+
+/**
+  Text appended to the log is sent by the next drain, and only once.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TextShouldBeDrainedOnce (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  InitDebugLog (TEST_RING_SIZE, 0, FALSE);
+
+  DebugLogAppend (mDebugLog, "Hello", 5);
+  DebugLogAppend (mDebugLog, " World", 6);
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 11);
+  UT_ASSERT_EQUAL (mDebugLog->CommitOffset, 11);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 0);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 11);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Hello World", 11);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 11);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 11);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Text crossing the end of the ring is split in two and drained in order.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TextShouldWrap (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8  *Data;
+
+  InitDebugLog (TEST_RING_SIZE, 0xFFFFFFFC, FALSE);
+  Data = (UINT8 *) (mDebugLog + 1);
+
+  DebugLogAppend (mDebugLog, "0123456789", 10);
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 6);
+  UT_ASSERT_EQUAL (mDebugLog->CommitOffset, 6);
+  UT_ASSERT_MEM_EQUAL (Data + TEST_RING_SIZE - 4, "0123", 4);
+  UT_ASSERT_MEM_EQUAL (Data, "456789", 6);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 10);
+  UT_ASSERT_MEM_EQUAL (mOutput, "0123456789", 10);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 6);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Only the last ring size bytes of text are drained when the ring overflowed.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TextOverflowShouldKeepLastBytes (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CONST CHAR8  *Text;
+
+  Text = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMN0123456789abcdefghijklmnopqrstuvwxyzABCD";
+  InitDebugLog (TEST_RING_SIZE, 0, FALSE);
+
+  DebugLogAppend (mDebugLog, Text, 40);
+  DebugLogAppend (mDebugLog, Text + 40, 40);
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 80);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, TEST_RING_SIZE);
+  UT_ASSERT_MEM_EQUAL (mOutput, Text + 80 - TEST_RING_SIZE, TEST_RING_SIZE);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 80);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A record that does not fit before the end of the ring is moved to its
+  start, after a padding record that the drain skips.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RecordShouldNotBeSplit (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT8             *Data;
+  DEBUG_LOG_RECORD  *Record;
+  UINT32            Length;
+
+  InitDebugLog (TEST_RING_SIZE, 48, TRUE);
+  Data = (UINT8 *) (mDebugLog + 1);
+
+  //
+  // 8 bytes of header and 14 bytes of text take 24 bytes, only 16 are left
+  // before the end of the ring.
+  //
+  Length = AppendTextRecord ("Hello, World!\n");
+  UT_ASSERT_EQUAL (Length, 24);
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 48 + 16 + 24);
+  UT_ASSERT_EQUAL (mDebugLog->CommitOffset, 48 + 16 + 24);
+
+  Record = (DEBUG_LOG_RECORD *) (Data + 48);
+  UT_ASSERT_EQUAL (Record->Type, DEBUG_LOG_RECORD_TYPE_PADDING);
+  UT_ASSERT_EQUAL (Record->DataSize, 16 - sizeof (DEBUG_LOG_RECORD));
+
+  Record = (DEBUG_LOG_RECORD *) Data;
+  UT_ASSERT_EQUAL (Record->Type, DEBUG_LOG_RECORD_TYPE_TEXT);
+  UT_ASSERT_EQUAL (Record->DataSize, 14);
+  UT_ASSERT_EQUAL (Record->ErrorLevel, DEBUG_INFO);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 14);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Hello, World!\n", 14);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 48 + 16 + 24);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A binary record is formatted when it is drained.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+BinaryRecordShouldBeFormatted (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  UINT64            RecordBuffer[TEST_RING_SIZE_MAX / sizeof (UINT64)];
+  DEBUG_LOG_RECORD  *Record;
+  BASE_LIST         BaseListMarker;
+  CONST CHAR8       *Format;
+  UINTN             FormatSize;
+
+  InitDebugLog (TEST_RING_SIZE_MAX, 0, TRUE);
+
+  Format     = "Value %d 0x%x\n";
+  FormatSize = AsciiStrSize (Format);
+
+  Record         = (DEBUG_LOG_RECORD *) RecordBuffer;
+  BaseListMarker = (BASE_LIST) (Record + 1);
+  BASE_ARG (BaseListMarker, int) = 42;
+  BASE_ARG (BaseListMarker, int) = 0x1F;
+  CopyMem ((UINT64 *) (Record + 1) + DEBUG_LOG_RECORD_ARGUMENT_COUNT, Format, FormatSize);
+  Record->DataSize   = (UINT16) (DEBUG_LOG_RECORD_ARGUMENT_COUNT * sizeof (UINT64) + FormatSize);
+  Record->Type       = DEBUG_LOG_RECORD_TYPE_BINARY;
+  Record->Reserved   = 0;
+  Record->ErrorLevel = DEBUG_INFO;
+  DebugLogAppend (
+    mDebugLog,
+    Record,
+    (UINT32) ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + Record->DataSize, DEBUG_LOG_RECORD_ALIGNMENT)
+    );
+
+  //
+  // The Print Library turns "\n" into "\r\n".
+  //
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 15);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Value 42 0x1F\r\n", 15);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Nothing is drained while a message is still being copied into the log.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+PendingCommitShouldDelayDrain (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  InitDebugLog (TEST_RING_SIZE, 0, FALSE);
+
+  //
+  // Reserve space like an interrupted writer would, then append after it.
+  //
+  mDebugLog->WriteOffset = 8;
+  DebugLogAppend (mDebugLog, "Hello", 5);
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 13);
+  UT_ASSERT_EQUAL (mDebugLog->CommitOffset, 5);
+
+  UT_ASSERT_FALSE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 0);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 0);
+
+  //
+  // The interrupted writer finishes its copy.
+  //
+  CopyMem (mDebugLog + 1, "Pending ", 8);
+  mDebugLog->CommitOffset += 8;
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, 13);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Pending Hello", 13);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 13);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A partial drain of text sends at most the given number of bytes, and the
+  next drain resumes where it stopped, also across the end of the ring.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+TextPartialDrainShouldResume (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  InitDebugLog (TEST_RING_SIZE, 0xFFFFFFFC, FALSE);
+
+  DebugLogAppend (mDebugLog, "Hello World", 11);
+
+  UT_ASSERT_FALSE (DebugLogDrainPartial (mDebugLog, TestOutput, 6));
+  UT_ASSERT_EQUAL (mOutputLength, 6);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Hello ", 6);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 2);
+
+  UT_ASSERT_TRUE (DebugLogDrainPartial (mDebugLog, TestOutput, 6));
+  UT_ASSERT_EQUAL (mOutputLength, 11);
+  UT_ASSERT_MEM_EQUAL (mOutput, "Hello World", 11);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 7);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  A partial drain of records sends whole records only. The first record is
+  sent even if it is longer than the given number of bytes.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RecordPartialDrainShouldNotSplitRecords (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  InitDebugLog (TEST_RING_SIZE_MAX, 0, TRUE);
+
+  AppendTextRecord ("First\n");
+  AppendTextRecord ("Second\n");
+  AppendTextRecord ("Third\n");
+
+  //
+  // "First\n" fits, but "Second\n" would go past the 10 bytes.
+  //
+  UT_ASSERT_FALSE (DebugLogDrainPartial (mDebugLog, TestOutput, 10));
+  UT_ASSERT_EQUAL (mOutputLength, 6);
+  UT_ASSERT_MEM_EQUAL (mOutput, "First\n", 6);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 16);
+
+  UT_ASSERT_FALSE (DebugLogDrainPartial (mDebugLog, TestOutput, 4));
+  UT_ASSERT_EQUAL (mOutputLength, 6 + 7);
+  UT_ASSERT_MEM_EQUAL (mOutput + 6, "Second\n", 7);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 32);
+
+  UT_ASSERT_TRUE (DebugLogDrainPartial (mDebugLog, TestOutput, 10));
+  UT_ASSERT_EQUAL (mOutputLength, 6 + 7 + 6);
+  UT_ASSERT_MEM_EQUAL (mOutput + 6 + 7, "Third\n", 6);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 48);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  When a ring of records overflowed, a line saying that messages were lost is
+  sent, followed by the records of the current lap.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RecordOverflowShouldKeepCurrentLap (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CONST CHAR8  *Lost;
+  UINTN        LostLength;
+
+  Lost = "\n[DebugLogDxe: debug messages lost]\n";
+  InitDebugLog (TEST_RING_SIZE, 0, TRUE);
+
+  AppendTextRecord ("First message\n");
+  AppendTextRecord ("Second message\n");
+  AppendTextRecord ("Third message\n");
+
+  //
+  // Each record takes 24 bytes, and the third one is moved after 16 bytes of
+  // padding.
+  //
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 3 * 24 + 16);
+
+  //
+  // The first two records were overwritten by the third one, which starts
+  // the second lap.
+  //
+  LostLength = AsciiStrLen (Lost);
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, LostLength + 14);
+  UT_ASSERT_MEM_EQUAL (mOutput, Lost, LostLength);
+  UT_ASSERT_MEM_EQUAL (mOutput + LostLength, "Third message\n", 14);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 3 * 24 + 16);
+
+  AppendTextRecord ("Fourth message\n");
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, LostLength + 14 + 15);
+  UT_ASSERT_MEM_EQUAL (mOutput + LostLength + 14, "Fourth message\n", 15);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  When a ring of records overflowed and the last record ends a lap, the
+  whole ring is sent after the line saying that messages were lost, also
+  when the offsets wrap around.
+
+  @param[in]  Context    [Optional] An optional parameter that enables:
+                         1) test-case reuse with varied parameters and
+                         2) test-case re-entry for Target tests that need a
+                         reboot.  This parameter is a VOID* and it is the
+                         responsibility of the test author to ensure that the
+                         contents are well understood by all test cases that may
+                         consume it.
+
+  @retval  UNIT_TEST_PASSED             The Unit test has completed and the test
+                                        case was successful.
+  @retval  UNIT_TEST_ERROR_TEST_FAILED  A test case assertion has failed.
+**/
+UNIT_TEST_STATUS
+EFIAPI
+RecordOverflowShouldKeepFullLap (
+  IN UNIT_TEST_CONTEXT  Context
+  )
+{
+  CONST CHAR8  *Lost;
+  UINTN        LostLength;
+  CHAR8        Message[sizeof ("Msg 0\n")];
+  UINTN        Index;
+
+  Lost       = "\n[DebugLogDxe: debug messages lost]\n";
+  LostLength = AsciiStrLen (Lost);
+  InitDebugLog (TEST_RING_SIZE, 0xFFFFFFC0, TRUE);
+  CopyMem (Message, "Msg 0\n", sizeof (Message));
+
+  //
+  // Each record takes 16 bytes, so the eight records fill two laps exactly.
+  //
+  for (Index = 0; Index < 8; Index++) {
+    Message[4] = (CHAR8) ('0' + Index);
+    AppendTextRecord (Message);
+  }
+  UT_ASSERT_EQUAL (mDebugLog->WriteOffset, 0x40);
+
+  UT_ASSERT_TRUE (DebugLogDrain (mDebugLog, TestOutput));
+  UT_ASSERT_EQUAL (mOutputLength, LostLength + 4 * 6);
+  UT_ASSERT_MEM_EQUAL (mOutput, Lost, LostLength);
+  UT_ASSERT_MEM_EQUAL (mOutput + LostLength, "Msg 4\nMsg 5\nMsg 6\nMsg 7\n", 4 * 6);
+  UT_ASSERT_EQUAL (mDebugLog->DrainOffset, 0x40);
+
+  return UNIT_TEST_PASSED;
+}
+
+/**
+  Initialze the unit test framework, suite, and unit tests for the
+  BaseDebugLogBufferLib and run the BaseDebugLogBufferLib unit test.
+
+  @retval  EFI_SUCCESS           All test cases were dispatched.
+  @retval  EFI_OUT_OF_RESOURCES  There are not enough resources available to
+                                 initialize the unit tests.
+**/
+STATIC
+EFI_STATUS
+EFIAPI
+UnitTestingEntry (
+  VOID
+  )
+{
+  EFI_STATUS                  Status;
+  UNIT_TEST_FRAMEWORK_HANDLE  Framework;
+  UNIT_TEST_SUITE_HANDLE      RingTests;
+
+  Framework = NULL;
+
+  DEBUG(( DEBUG_INFO, "%a v%a\n", UNIT_TEST_APP_NAME, UNIT_TEST_APP_VERSION ));
+
+  //
+  // Start setting up the test framework for running the tests.
+  //
+  Status = InitUnitTestFramework (&Framework, UNIT_TEST_APP_NAME, gEfiCallerBaseName, UNIT_TEST_APP_VERSION);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in InitUnitTestFramework. Status = %r\n", Status));
+    goto EXIT;
+  }
+
+  //
+  // Populate the BaseDebugLogBufferLib Unit Test Suite.
+  //
+  Status = CreateUnitTestSuite (&RingTests, Framework, "BaseDebugLogBufferLib Ring Tests", "BaseDebugLogBufferLib.Ring", NULL, NULL);
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_ERROR, "Failed in CreateUnitTestSuite for BaseDebugLogBufferLib Ring Tests\n"));
+    Status = EFI_OUT_OF_RESOURCES;
+    goto EXIT;
+  }
+
+  //
+  // --------------Suite---------Description--------------------------Name--------------Function--------------------------------Pre---Post---Context-----------
+  //
+  AddTestCase (RingTests, "Drain text once",                "TextDrain",        TextShouldBeDrainedOnce,                NULL, NULL, NULL);
+  AddTestCase (RingTests, "Wrap text",                      "TextWrap",         TextShouldWrap,                         NULL, NULL, NULL);
+  AddTestCase (RingTests, "Keep the last text on overflow", "TextOverflow",     TextOverflowShouldKeepLastBytes,        NULL, NULL, NULL);
+  AddTestCase (RingTests, "Pad instead of splitting",       "RecordWrap",       RecordShouldNotBeSplit,                 NULL, NULL, NULL);
+  AddTestCase (RingTests, "Format binary records",          "RecordBinary",     BinaryRecordShouldBeFormatted,          NULL, NULL, NULL);
+  AddTestCase (RingTests, "Wait for pending commits",       "PendingCommit",    PendingCommitShouldDelayDrain,          NULL, NULL, NULL);
+  AddTestCase (RingTests, "Resume a partial text drain",    "TextPartial",      TextPartialDrainShouldResume,           NULL, NULL, NULL);
+  AddTestCase (RingTests, "Drain whole records partially",  "RecordPartial",    RecordPartialDrainShouldNotSplitRecords, NULL, NULL, NULL);
+  AddTestCase (RingTests, "Keep the current lap of records", "RecordOverflow",  RecordOverflowShouldKeepCurrentLap,     NULL, NULL, NULL);
+  AddTestCase (RingTests, "Keep a full lap of records",     "RecordOverflowLap", RecordOverflowShouldKeepFullLap,       NULL, NULL, NULL);
+
+  //
+  // Execute the tests.
+  //
+  Status = RunAllTestSuites (Framework);
+
+EXIT:
+  if (Framework) {
+    FreeUnitTestFramework (Framework);
+  }
+
+  return Status;
+}
+
+///
+/// Avoid ECC error for function name that starts with lower case letter
+///
+#define BaseDebugLogBufferLibUnitTestMain main
+
+/**
+  Standard POSIX C entry point for host based unit test execution.
+
+  @param[in] Argc  Number of arguments
+  @param[in] Argv  Array of pointers to arguments
+
+  @retval 0      Success
+  @retval other  Error
+**/
+INT32
+BaseDebugLogBufferLibUnitTestMain (
+  IN INT32  Argc,
+  IN CHAR8  *Argv[]
+  )
+{
+  UnitTestingEntry ();
+  return 0;
+}
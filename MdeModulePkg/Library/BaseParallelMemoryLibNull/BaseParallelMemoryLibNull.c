@@ -0,0 +1,84 @@
+/** @file
+  Null instance of ParallelMemoryLib. Buffers are filled on the calling
+  processor, and the free system memory is not cleared.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi/UefiBaseType.h>
+
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/ParallelMemoryLib.h>
+
+/**
+  Fills a target buffer with a byte value, using all the enabled processors.
+
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The memory to set.
+  @param[in]  Length  The number of bytes to set.
+  @param[in]  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelSetMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length,
+  IN  UINT8  Value
+  )
+{
+  return SetMem (Buffer, Length, Value);
+}
+
+/**
+  Fills a target buffer with zeros, using all the enabled processors.
+
+  If Buffer is NULL and Length > 0, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The pointer to the target buffer to fill with zeros.
+  @param[in]  Length  The number of bytes in Buffer to fill with zeros.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelZeroMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length
+  )
+{
+  ASSERT (!(Buffer == NULL && Length > 0));
+  return ZeroMem (Buffer, Length);
+}
+
+/**
+  Fills all the free system memory with zeros, using all the enabled
+  processors.
+
+  This instance does not clear the free system memory.
+
+  @param[out] ClearedSize  Optional. Return the number of bytes cleared.
+
+  @retval EFI_UNSUPPORTED  The free system memory is not cleared.
+
+**/
+EFI_STATUS
+EFIAPI
+ParallelClearFreeMemory (
+  OUT UINT64  *ClearedSize  OPTIONAL
+  )
+{
+  if (ClearedSize != NULL) {
+    *ClearedSize = 0;
+  }
+
+  return EFI_UNSUPPORTED;
+}
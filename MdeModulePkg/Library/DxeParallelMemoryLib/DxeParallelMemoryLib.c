@@ -0,0 +1,331 @@
+/** @file
+  Fill large buffers using all the enabled processors.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <PiDxe.h>
+
+#include <Protocol/MpService.h>
+
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/ParallelMemoryLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+//
+// Size of the chunks handed out to the processors. It is large enough for
+// the fill to be bandwidth bound, and small enough to balance the load.
+//
+#define PARALLEL_FILL_CHUNK_SIZE      SIZE_4MB
+
+//
+// Buffers smaller than this are filled on the calling processor, since
+// waking up the APs would cost more than the fill itself.
+//
+#define PARALLEL_FILL_MIN_SIZE        SIZE_64MB
+
+typedef struct {
+  UINT8              *Buffer;
+  UINTN              Length;
+  UINT8              Value;
+  UINTN              NumberOfChunks;
+  volatile UINT32    NextChunk;
+} PARALLEL_FILL_CONTEXT;
+
+/**
+  Fill the chunks of the buffer until none is left.
+
+  This function runs on the APs and on the BSP. Every processor claims the
+  next unfilled chunk through the shared counter.
+
+  @param[in, out] Buffer  Pointer to PARALLEL_FILL_CONTEXT.
+
+**/
+VOID
+EFIAPI
+ParallelFillProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  PARALLEL_FILL_CONTEXT  *Context;
+  UINTN                  Index;
+  UINTN                  Offset;
+
+  Context = (PARALLEL_FILL_CONTEXT *)Buffer;
+
+  while (TRUE) {
+    Index = InterlockedIncrement (&Context->NextChunk) - 1;
+    if (Index >= Context->NumberOfChunks) {
+      break;
+    }
+
+    Offset = Index * PARALLEL_FILL_CHUNK_SIZE;
+    SetMem (
+      Context->Buffer + Offset,
+      MIN (PARALLEL_FILL_CHUNK_SIZE, Context->Length - Offset),
+      Context->Value
+      );
+  }
+}
+
+/**
+  Fills a target buffer with a byte value, using all the enabled processors.
+
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The memory to set.
+  @param[in]  Length  The number of bytes to set.
+  @param[in]  Value   The value with which to fill Length bytes of Buffer.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelSetMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length,
+  IN  UINT8  Value
+  )
+{
+  EFI_STATUS                Status;
+  EFI_MP_SERVICES_PROTOCOL  *Mp;
+  PARALLEL_FILL_CONTEXT     Context;
+  EFI_EVENT                 WaitEvent;
+
+  if (Length < PARALLEL_FILL_MIN_SIZE) {
+    return SetMem (Buffer, Length, Value);
+  }
+
+  ASSERT ((Length - 1) <= (MAX_ADDRESS - (UINTN)Buffer));
+
+  Context.Buffer         = (UINT8 *)Buffer;
+  Context.Length         = Length;
+  Context.Value          = Value;
+  Context.NumberOfChunks = (Length + PARALLEL_FILL_CHUNK_SIZE - 1) / PARALLEL_FILL_CHUNK_SIZE;
+  Context.NextChunk      = 0;
+
+  WaitEvent = NULL;
+  Status    = gBS->LocateProtocol (&gEfiMpServiceProtocolGuid, NULL, (VOID **)&Mp);
+  if (!EFI_ERROR (Status)) {
+    Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &WaitEvent);
+  }
+  if (!EFI_ERROR (Status)) {
+    //
+    // Start the APs in non-blocking mode, so that the BSP fills chunks too.
+    // EFI_NOT_STARTED is returned on a single processor system, and
+    // EFI_NOT_READY if the APs are busy. The BSP fills the buffer then.
+    //
+    Status = Mp->StartupAllAPs (
+                   Mp,
+                   ParallelFillProcedure,
+                   FALSE,
+                   WaitEvent,
+                   0,
+                   &Context,
+                   NULL
+                   );
+    if (EFI_ERROR (Status)) {
+      if (Status != EFI_NOT_STARTED) {
+        DEBUG ((DEBUG_WARN, "%a: StartupAllAPs - %r\n", __FUNCTION__, Status));
+      }
+      gBS->CloseEvent (WaitEvent);
+      WaitEvent = NULL;
+    }
+  }
+
+  //
+  // Fill chunks along with the APs (all of them if the APs were not started).
+  //
+  ParallelFillProcedure (&Context);
+
+  //
+  // The context is on the stack, so wait for the APs to be done with it.
+  // WaitForEvent() only works at TPL_APPLICATION, and this may be called
+  // from an event notification function, so poll the event instead.
+  //
+  if (WaitEvent != NULL) {
+    while (gBS->CheckEvent (WaitEvent) == EFI_NOT_READY) {
+      CpuPause ();
+    }
+    gBS->CloseEvent (WaitEvent);
+  }
+
+  return Buffer;
+}
+
+/**
+  Fills a target buffer with zeros, using all the enabled processors.
+
+  If Buffer is NULL and Length > 0, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param[out] Buffer  The pointer to the target buffer to fill with zeros.
+  @param[in]  Length  The number of bytes in Buffer to fill with zeros.
+
+  @return Buffer.
+
+**/
+VOID *
+EFIAPI
+ParallelZeroMem (
+  OUT VOID   *Buffer,
+  IN  UINTN  Length
+  )
+{
+  ASSERT (!(Buffer == NULL && Length > 0));
+  return ParallelSetMem (Buffer, Length, 0);
+}
+
+/**
+  Clear a free memory range, owning it while it is cleared.
+
+  The range may have been partly consumed since the memory map was taken.
+  If it can not be allocated as a whole, it is split in halves and each half
+  is cleared on its own, down to single pages.
+
+  @param[in]      Start          The first address of the range.
+  @param[in]      NumberOfPages  The number of pages in the range.
+  @param[in, out] Cleared        Incremented by the number of bytes cleared.
+
+  @return The number of pages of the range that could not be cleared.
+
+**/
+STATIC
+UINT64
+ClearFreeRange (
+  IN     EFI_PHYSICAL_ADDRESS  Start,
+  IN     UINT64                NumberOfPages,
+  IN OUT UINT64                *Cleared
+  )
+{
+  EFI_STATUS            Status;
+  EFI_PHYSICAL_ADDRESS  Address;
+  UINT64                Half;
+
+  Address = Start;
+  Status  = gBS->AllocatePages (AllocateAddress, EfiBootServicesData, (UINTN)NumberOfPages, &Address);
+  if (!EFI_ERROR (Status)) {
+    ParallelZeroMem ((VOID *)(UINTN)Start, (UINTN)EFI_PAGES_TO_SIZE (NumberOfPages));
+    *Cleared += EFI_PAGES_TO_SIZE (NumberOfPages);
+    gBS->FreePages (Start, (UINTN)NumberOfPages);
+    return 0;
+  }
+
+  if (NumberOfPages == 1) {
+    DEBUG ((DEBUG_WARN, "%a: can not claim the page at 0x%lx - %r\n", __FUNCTION__, Start, Status));
+    return 1;
+  }
+
+  Half = NumberOfPages / 2;
+  return ClearFreeRange (Start, Half, Cleared) +
+         ClearFreeRange (Start + EFI_PAGES_TO_SIZE (Half), NumberOfPages - Half, Cleared);
+}
+
+/**
+  Fills all the free system memory with zeros, using all the enabled
+  processors.
+
+  Each free memory range of the UEFI memory map is allocated while it is
+  cleared, so that it can not be handed out to another agent during the
+  clear, and is freed again afterwards. A range that has been partly
+  consumed since the memory map was taken is split, and its free parts are
+  cleared. The first page of memory is never cleared so that NULL pointer
+  detection keeps working, and ranges above MAX_ADDRESS are skipped.
+
+  @param[out] ClearedSize  Optional. Return the number of bytes cleared.
+
+  @retval EFI_SUCCESS           All the free memory has been cleared.
+  @retval EFI_ABORTED           Some free memory could not be claimed, and
+                                has not been cleared.
+  @retval EFI_OUT_OF_RESOURCES  No memory to hold the memory map.
+  @retval Others                Failed to get the memory map.
+
+**/
+EFI_STATUS
+EFIAPI
+ParallelClearFreeMemory (
+  OUT UINT64  *ClearedSize  OPTIONAL
+  )
+{
+  EFI_STATUS             Status;
+  EFI_MEMORY_DESCRIPTOR  *MemoryMap;
+  EFI_MEMORY_DESCRIPTOR  *Entry;
+  UINTN                  MemoryMapSize;
+  UINTN                  MapKey;
+  UINTN                  DescriptorSize;
+  UINT32                 DescriptorVersion;
+  EFI_PHYSICAL_ADDRESS   Start;
+  UINT64                 NumberOfPages;
+  UINT64                 Cleared;
+  UINT64                 Skipped;
+
+  Cleared       = 0;
+  Skipped       = 0;
+  MemoryMap     = NULL;
+  MemoryMapSize = 0;
+  do {
+    Status = gBS->GetMemoryMap (&MemoryMapSize, MemoryMap, &MapKey, &DescriptorSize, &DescriptorVersion);
+    if (Status == EFI_BUFFER_TOO_SMALL) {
+      if (MemoryMap != NULL) {
+        FreePool (MemoryMap);
+      }
+      //
+      // Allocating the buffer may split a descriptor, leave room for it.
+      //
+      MemoryMapSize += 2 * DescriptorSize;
+      MemoryMap = AllocatePool (MemoryMapSize);
+      if (MemoryMap == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      Status = EFI_BUFFER_TOO_SMALL;
+    }
+  } while (Status == EFI_BUFFER_TOO_SMALL);
+
+  if (EFI_ERROR (Status)) {
+    if (MemoryMap != NULL) {
+      FreePool (MemoryMap);
+    }
+    return Status;
+  }
+
+  for (Entry = MemoryMap;
+       (UINTN)Entry < (UINTN)MemoryMap + MemoryMapSize;
+       Entry = (EFI_MEMORY_DESCRIPTOR *)((UINT8 *)Entry + DescriptorSize)) {
+    if (Entry->Type != EfiConventionalMemory) {
+      continue;
+    }
+
+    Start         = Entry->PhysicalStart;
+    NumberOfPages = Entry->NumberOfPages;
+    if (Start == 0) {
+      Start += EFI_PAGE_SIZE;
+      NumberOfPages--;
+    }
+    if ((NumberOfPages == 0) ||
+        (Start + EFI_PAGES_TO_SIZE (NumberOfPages) - 1 > MAX_ADDRESS)) {
+      continue;
+    }
+
+    Skipped += ClearFreeRange (Start, NumberOfPages, &Cleared);
+  }
+
+  FreePool (MemoryMap);
+
+  if (ClearedSize != NULL) {
+    *ClearedSize = Cleared;
+  }
+
+  if (Skipped != 0) {
+    DEBUG ((DEBUG_ERROR, "%a: 0x%lx pages of free memory not cleared\n", __FUNCTION__, Skipped));
+    return EFI_ABORTED;
+  }
+
+  return EFI_SUCCESS;
+}
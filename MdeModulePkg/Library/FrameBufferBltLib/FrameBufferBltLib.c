@@ -12,6 +12,7 @@
 #include <Library/BaseLib.h>
 #include <Library/BaseMemoryLib.h>
 #include <Library/DebugLib.h>
+#include <Library/PcdLib.h>
 #include <Library/FrameBufferBltLib.h>
 
 struct FRAME_BUFFER_CONFIGURE {
@@ -24,6 +25,7 @@ struct FRAME_BUFFER_CONFIGURE {
   EFI_PIXEL_BITMASK               PixelMasks;
   INT8                            PixelShl[4]; // R-G-B-Rsvd
   INT8                            PixelShr[4]; // R-G-B-Rsvd
+  UINT8                           *ShadowBuffer; // system memory copy of FrameBuffer, or NULL
   UINT8                           LineBuffer[0];
 };
 
@@ -111,6 +113,8 @@ FrameBufferBltConfigure (
   UINT32                                       BytesPerPixel;
   INT8                                         PixelShl[4];
   INT8                                         PixelShr[4];
+  UINTN                                        LineBufferSize;
+  UINTN                                        ShadowBufferSize;
 
   if (ConfigureSize == NULL) {
     return RETURN_INVALID_PARAMETER;
@@ -144,10 +148,22 @@ FrameBufferBltConfigure (
 
   FrameBufferBltLibConfigurePixelFormat (BitMask, &BytesPerPixel, PixelShl, PixelShr);
 
+  //
+  // The shadow buffer follows the line buffer and has the same layout as
+  // the frame buffer.
+  //
+  LineBufferSize   = FrameBufferInfo->HorizontalResolution * BytesPerPixel;
+  ShadowBufferSize = 0;
+  if (FeaturePcdGet (PcdFrameBufferBltLibShadowBuffer)) {
+    LineBufferSize   = ALIGN_VALUE (LineBufferSize, sizeof (UINT64));
+    ShadowBufferSize = (UINTN) FrameBufferInfo->PixelsPerScanLine
+                     * FrameBufferInfo->VerticalResolution * BytesPerPixel;
+  }
+
   if (*ConfigureSize < sizeof (FRAME_BUFFER_CONFIGURE)
-                     + FrameBufferInfo->HorizontalResolution * BytesPerPixel) {
+                     + LineBufferSize + ShadowBufferSize) {
     *ConfigureSize = sizeof (FRAME_BUFFER_CONFIGURE)
-                   + FrameBufferInfo->HorizontalResolution * BytesPerPixel;
+                   + LineBufferSize + ShadowBufferSize;
     return RETURN_BUFFER_TOO_SMALL;
   }
 
@@ -164,10 +180,61 @@ FrameBufferBltConfigure (
   Configure->Width             = FrameBufferInfo->HorizontalResolution;
   Configure->Height            = FrameBufferInfo->VerticalResolution;
   Configure->PixelsPerScanLine = FrameBufferInfo->PixelsPerScanLine;
+  Configure->ShadowBuffer      = NULL;
+
+  if (ShadowBufferSize != 0) {
+    //
+    // This is the only time the frame buffer is read.
+    //
+    Configure->ShadowBuffer = Configure->LineBuffer + LineBufferSize;
+    CopyMem (Configure->ShadowBuffer, FrameBuffer, ShadowBufferSize);
+  }
 
   return RETURN_SUCCESS;
 }
 
+/**
+  Copy a rectangle from the shadow buffer to the frame buffer.
+
+  @param[in]  Configure     Pointer to a configuration which was successfully
+                            created by FrameBufferBltConfigure ().
+  @param[in]  X             X location of the rectangle.
+  @param[in]  Y             Y location of the rectangle.
+  @param[in]  Width         Width (in pixels) of the rectangle.
+  @param[in]  Height        Height of the rectangle.
+**/
+VOID
+FrameBufferBltLibFlushShadowBuffer (
+  IN  FRAME_BUFFER_CONFIGURE        *Configure,
+  IN  UINTN                         X,
+  IN  UINTN                         Y,
+  IN  UINTN                         Width,
+  IN  UINTN                         Height
+  )
+{
+  UINTN                             Offset;
+  UINTN                             WidthInBytes;
+  UINTN                             LineStride;
+
+  if (Configure->ShadowBuffer == NULL) {
+    return;
+  }
+
+  Offset       = ((Y * Configure->PixelsPerScanLine) + X) * Configure->BytesPerPixel;
+  WidthInBytes = Width * Configure->BytesPerPixel;
+  LineStride   = Configure->PixelsPerScanLine * Configure->BytesPerPixel;
+
+  if (WidthInBytes == LineStride) {
+    CopyMem (Configure->FrameBuffer + Offset, Configure->ShadowBuffer + Offset, WidthInBytes * Height);
+    return;
+  }
+
+  while (Height-- > 0) {
+    CopyMem (Configure->FrameBuffer + Offset, Configure->ShadowBuffer + Offset, WidthInBytes);
+    Offset += LineStride;
+  }
+}
+
 /**
   Performs a UEFI Graphics Output Protocol Blt Video Fill.
 
@@ -204,6 +271,7 @@ FrameBufferBltLibVideoFill (
   UINTN                             Offset;
   UINTN                             WidthInBytes;
   UINTN                             SizeInBytes;
+  UINT8                             *FrameBuffer;
 
   //
   // BltBuffer to Video: Source is BltBuffer, destination is Video
@@ -224,6 +292,7 @@ FrameBufferBltLibVideoFill (
   }
 
   WidthInBytes = Width * Configure->BytesPerPixel;
+  FrameBuffer  = (Configure->ShadowBuffer != NULL) ? Configure->ShadowBuffer : Configure->FrameBuffer;
 
   Uint32 = *(UINT32*) Color;
   WideFill =
@@ -270,7 +339,7 @@ FrameBufferBltLibVideoFill (
     DEBUG ((EFI_D_VERBOSE, "VideoFill (wide, one-shot)\n"));
     Offset = DestinationY * Configure->PixelsPerScanLine;
     Offset = Configure->BytesPerPixel * Offset;
-    Destination = Configure->FrameBuffer + Offset;
+    Destination = FrameBuffer + Offset;
     SizeInBytes = WidthInBytes * Height;
     if (SizeInBytes >= 8) {
       SetMem32 (Destination, SizeInBytes & ~3, (UINT32) WideFill);
@@ -285,7 +354,7 @@ FrameBufferBltLibVideoFill (
     for (IndexY = DestinationY; IndexY < (Height + DestinationY); IndexY++) {
       Offset = (IndexY * Configure->PixelsPerScanLine) + DestinationX;
       Offset = Configure->BytesPerPixel * Offset;
-      Destination = Configure->FrameBuffer + Offset;
+      Destination = FrameBuffer + Offset;
 
       if (UseWideFill && (((UINTN) Destination & 7) == 0)) {
         DEBUG ((EFI_D_VERBOSE, "VideoFill (wide)\n"));
@@ -317,6 +386,8 @@ FrameBufferBltLibVideoFill (
     }
   }
 
+  FrameBufferBltLibFlushShadowBuffer (Configure, DestinationX, DestinationY, Width, Height);
+
   return RETURN_SUCCESS;
 }
 
@@ -360,6 +431,7 @@ FrameBufferBltLibVideoToBltBuffer (
   UINT32                                 Uint32;
   UINTN                                  Offset;
   UINTN                                  WidthInBytes;
+  UINT8                                  *FrameBuffer;
 
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
@@ -387,6 +459,11 @@ FrameBufferBltLibVideoToBltBuffer (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  //
+  // Read from the shadow buffer when there is one, video memory is slow to read.
+  //
+  FrameBuffer = (Configure->ShadowBuffer != NULL) ? Configure->ShadowBuffer : Configure->FrameBuffer;
+
   //
   // Video to BltBuffer: Source is Video, destination is BltBuffer
   //
@@ -396,7 +473,7 @@ FrameBufferBltLibVideoToBltBuffer (
 
     Offset = (SrcY * Configure->PixelsPerScanLine) + SourceX;
     Offset = Configure->BytesPerPixel * Offset;
-    Source = Configure->FrameBuffer + Offset;
+    Source = FrameBuffer + Offset;
 
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       Destination = (UINT8 *) BltBuffer + (DstY * Delta) + (DestinationX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
@@ -468,6 +545,7 @@ FrameBufferBltLibBufferToVideo (
   UINT32                                   Uint32;
   UINTN                                    Offset;
   UINTN                                    WidthInBytes;
+  UINT8                                    *FrameBuffer;
 
   //
   // BltBuffer to Video: Source is BltBuffer, destination is Video
@@ -494,6 +572,7 @@ FrameBufferBltLibBufferToVideo (
   }
 
   WidthInBytes = Width * Configure->BytesPerPixel;
+  FrameBuffer  = (Configure->ShadowBuffer != NULL) ? Configure->ShadowBuffer : Configure->FrameBuffer;
 
   for (SrcY = SourceY, DstY = DestinationY;
        SrcY < (Height + SourceY);
@@ -501,7 +580,7 @@ FrameBufferBltLibBufferToVideo (
 
     Offset = (DstY * Configure->PixelsPerScanLine) + DestinationX;
     Offset = Configure->BytesPerPixel * Offset;
-    Destination = Configure->FrameBuffer + Offset;
+    Destination = FrameBuffer + Offset;
 
     if (Configure->PixelFormat == PixelBlueGreenRedReserved8BitPerColor) {
       Source = (UINT8 *) BltBuffer + (SrcY * Delta) + SourceX * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL);
@@ -530,6 +609,8 @@ FrameBufferBltLibBufferToVideo (
     CopyMem (Destination, Source, WidthInBytes);
   }
 
+  FrameBufferBltLibFlushShadowBuffer (Configure, DestinationX, DestinationY, Width, Height);
+
   return RETURN_SUCCESS;
 }
 
@@ -564,6 +645,8 @@ FrameBufferBltLibVideoToVideo (
   UINTN                                     Offset;
   UINTN                                     WidthInBytes;
   INTN                                      LineStride;
+  UINT8                                     *FrameBuffer;
+  UINTN                                     Lines;
 
   //
   // Video to Video: Source is Video, destination is Video
@@ -590,31 +673,39 @@ FrameBufferBltLibVideoToVideo (
 
   WidthInBytes = Width * Configure->BytesPerPixel;
 
+  //
+  // With a shadow buffer the copy is done in system memory and the frame
+  // buffer is only written.
+  //
+  FrameBuffer = (Configure->ShadowBuffer != NULL) ? Configure->ShadowBuffer : Configure->FrameBuffer;
+
   Offset = (SourceY * Configure->PixelsPerScanLine) + SourceX;
   Offset = Configure->BytesPerPixel * Offset;
-  Source = Configure->FrameBuffer + Offset;
+  Source = FrameBuffer + Offset;
 
   Offset = (DestinationY * Configure->PixelsPerScanLine) + DestinationX;
   Offset = Configure->BytesPerPixel * Offset;
-  Destination = Configure->FrameBuffer + Offset;
+  Destination = FrameBuffer + Offset;
 
   LineStride = Configure->BytesPerPixel * Configure->PixelsPerScanLine;
   if (Destination > Source) {
     //
     // Copy from last line to avoid source is corrupted by copying
     //
-    Source += Height * LineStride;
-    Destination += Height * LineStride;
+    Source += (Height - 1) * LineStride;
+    Destination += (Height - 1) * LineStride;
     LineStride = -LineStride;
   }
 
-  while (Height-- > 0) {
+  for (Lines = Height; Lines > 0; Lines--) {
     CopyMem (Destination, Source, WidthInBytes);
 
     Source += LineStride;
     Destination += LineStride;
   }
 
+  FrameBufferBltLibFlushShadowBuffer (Configure, DestinationX, DestinationY, Width, Height);
+
   return RETURN_SUCCESS;
 }
 
@@ -0,0 +1,680 @@
+/** @file
+  Debug library instance that appends DEBUG() messages to the in-memory debug
+  log installed by DebugLogDxe, instead of waiting for the serial port.
+
+  DebugLogDxe sends the log to the serial port from a timer event. Until the
+  log is found in the EFI System Table configuration table, and after
+  ExitBootServices(), messages are written to the serial port directly.
+
+  An ASSERT() may be followed by a dead loop, and a DEBUG_ERROR message is
+  often the last one before a hang, so the timer may never run again. The log
+  is drained right away before an ASSERT() message and after a DEBUG_ERROR
+  message. ASSERT() messages are always written to the serial port directly.
+
+  When DebugLogDxe sets DEBUG_LOG_BUFFER_FLAG_RECORDS, a DEBUG() message whose
+  arguments are all values is not formatted here: its format string and
+  arguments are stored in a binary record and DebugLogDxe formats them when it
+  drains the log. Messages with string, GUID or time arguments are still
+  formatted right away, since the data they point to may be gone by then.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Guid/DebugLogBuffer.h>
+#include <Library/DebugLib.h>
+#include <Library/BaseLib.h>
+#include <Library/PrintLib.h>
+#include <Library/PcdLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLogBufferLib.h>
+#include <Library/SerialPortLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/DebugPrintErrorLevelLib.h>
+
+//
+// Define the maximum debug and assert message length that this library supports
+//
+#define MAX_DEBUG_MESSAGE_LENGTH  0x100
+
+//
+// VA_LIST can not initialize to NULL for all compiler, so we use this to
+// indicate a null VA_LIST
+//
+VA_LIST     mVaListNull;
+
+//
+// Pointer to SystemTable
+// This library instance may have a cycle consume with UefiBootServicesTableLib
+// because of the constructors.
+//
+EFI_SYSTEM_TABLE  *mDebugST;
+
+//
+// The debug log, once it has been found in the configuration table
+//
+DEBUG_LOG_BUFFER  *mDebugLog;
+
+/**
+  The constructor saves the system table pointer and initializes the Serial
+  Port Library.
+
+  @param  ImageHandle     The firmware allocated handle for the EFI image.
+  @param  SystemTable     A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS     The constructor always returns EFI_SUCCESS.
+
+**/
+EFI_STATUS
+EFIAPI
+UefiDebugLibMemoryLogConstructor (
+  IN EFI_HANDLE                 ImageHandle,
+  IN EFI_SYSTEM_TABLE           *SystemTable
+  )
+{
+  mDebugST = SystemTable;
+  SerialPortInitialize ();
+  return EFI_SUCCESS;
+}
+
+/**
+  Find the debug log in the EFI System Table configuration table.
+
+  @return The debug log, or NULL if DebugLogDxe has not installed it yet.
+
+**/
+DEBUG_LOG_BUFFER *
+GetDebugLogBuffer (
+  VOID
+  )
+{
+  UINTN             Index;
+  DEBUG_LOG_BUFFER  *DebugLog;
+
+  if ((mDebugLog != NULL) || (mDebugST == NULL)) {
+    return mDebugLog;
+  }
+
+  for (Index = 0; Index < mDebugST->NumberOfTableEntries; Index++) {
+    if (CompareGuid (&gEdkiiDebugLogBufferGuid, &mDebugST->ConfigurationTable[Index].VendorGuid)) {
+      DebugLog = (DEBUG_LOG_BUFFER *) mDebugST->ConfigurationTable[Index].VendorTable;
+      if (DebugLog->Signature == DEBUG_LOG_BUFFER_SIGNATURE) {
+        mDebugLog = DebugLog;
+      }
+      break;
+    }
+  }
+
+  return mDebugLog;
+}
+
+/**
+  Append a message to the debug log, or write it to the serial port if there
+  is no debug log yet.
+
+  The log is drained right after a DEBUG_ERROR message. If this interrupted
+  another writer, the log can't be drained, and the message is written to the
+  serial port directly. It is sent again by the next drain.
+
+  @param  ErrorLevel  The error level of the message.
+  @param  Buffer      The message text.
+  @param  Length      The length of the message in bytes.
+
+**/
+VOID
+DebugLogWrite (
+  IN UINTN        ErrorLevel,
+  IN CONST CHAR8  *Buffer,
+  IN UINTN        Length
+  )
+{
+  DEBUG_LOG_BUFFER  *DebugLog;
+  DEBUG_LOG_RECORD  *Record;
+  UINT64            RecordBuffer[(sizeof (DEBUG_LOG_RECORD) + MAX_DEBUG_MESSAGE_LENGTH) / sizeof (UINT64) + 1];
+
+  DebugLog = GetDebugLogBuffer ();
+  if (DebugLog == NULL) {
+    SerialPortWrite ((UINT8 *) Buffer, Length);
+    return;
+  }
+
+  if ((DebugLog->Flags & DEBUG_LOG_BUFFER_FLAG_RECORDS) != 0) {
+    ASSERT (Length <= MAX_DEBUG_MESSAGE_LENGTH);
+    Record             = (DEBUG_LOG_RECORD *) RecordBuffer;
+    Record->DataSize   = (UINT16) Length;
+    Record->Type       = DEBUG_LOG_RECORD_TYPE_TEXT;
+    Record->Reserved   = 0;
+    Record->ErrorLevel = (UINT32) ErrorLevel;
+    CopyMem (Record + 1, Buffer, Length);
+    DebugLogAppend (
+      DebugLog,
+      Record,
+      (UINT32) ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + Length, DEBUG_LOG_RECORD_ALIGNMENT)
+      );
+  } else if (Length > DebugLog->Size) {
+    DebugLogAppend (DebugLog, Buffer + Length - DebugLog->Size, DebugLog->Size);
+  } else {
+    DebugLogAppend (DebugLog, Buffer, (UINT32) Length);
+  }
+
+  if ((DebugLog->Flags & DEBUG_LOG_BUFFER_FLAG_SYNCHRONOUS) != 0) {
+    SerialPortWrite ((UINT8 *) Buffer, Length);
+  } else if ((ErrorLevel & DEBUG_ERROR) != 0) {
+    if (!DebugLogDrain (DebugLog, SerialPortWrite)) {
+      SerialPortWrite ((UINT8 *) Buffer, Length);
+    }
+  }
+}
+
+/**
+  Append a message to the debug log as a binary record, without formatting
+  it.
+
+  The format string is copied into the record, and the arguments are packed
+  after the record header as a BASE_LIST, the same way they are packed in an
+  EFI_DEBUG_INFO status code record.
+
+  @param  DebugLog        The debug log. It holds records and is drained by
+                          DebugLogDxe.
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message.
+  @param  VaListMarker    VA_LIST marker for the variable argument list.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+  @retval TRUE            The message is in the debug log.
+  @retval FALSE           The message has a string, GUID or time argument, or
+                          too many arguments, and must be formatted by the
+                          caller.
+
+**/
+BOOLEAN
+DebugLogWriteBinary (
+  IN  DEBUG_LOG_BUFFER  *DebugLog,
+  IN  UINTN             ErrorLevel,
+  IN  CONST CHAR8       *Format,
+  IN  VA_LIST           VaListMarker,
+  IN  BASE_LIST         BaseListMarker
+  )
+{
+  UINT64            RecordBuffer[(sizeof (DEBUG_LOG_RECORD) + DEBUG_LOG_RECORD_ARGUMENT_COUNT * sizeof (UINT64) + MAX_DEBUG_MESSAGE_LENGTH) / sizeof (UINT64)];
+  DEBUG_LOG_RECORD  *Record;
+  BASE_LIST         BaseListMarkerPointer;
+  CHAR8             *FormatString;
+  UINTN             FormatSize;
+  BOOLEAN           Long;
+
+  //
+  // The record is laid out as follows. The header is 8 bytes, so the
+  // arguments are 64-bit aligned like the record itself.
+  //
+  //                 Record->|------------------------|
+  //                         |    DEBUG_LOG_RECORD    | sizeof (DEBUG_LOG_RECORD)
+  //  BaseListMarkerPointer->|------------------------|
+  //                         |   variable arguments   | 12 * sizeof (UINT64)
+  //           FormatString->|------------------------|
+  //                         |      Format String     | FormatSize
+  //                         |------------------------|
+  //
+  Record                = (DEBUG_LOG_RECORD *) RecordBuffer;
+  BaseListMarkerPointer = (BASE_LIST) (Record + 1);
+  FormatString          = (CHAR8 *) ((UINT64 *) (Record + 1) + DEBUG_LOG_RECORD_ARGUMENT_COUNT);
+
+  //
+  // Copy the Format string into the record. It will be truncated if it's too long.
+  //
+  AsciiStrnCpyS (FormatString, MAX_DEBUG_MESSAGE_LENGTH, Format, MAX_DEBUG_MESSAGE_LENGTH - 1);
+  FormatSize = AsciiStrSize (FormatString);
+
+  //
+  // Pack the variable arguments in the storage area following the header.
+  //
+  for (Format = FormatString; *Format != '\0'; Format++) {
+    //
+    // Only format with prefix % is processed.
+    //
+    if (*Format != '%') {
+      continue;
+    }
+    Long = FALSE;
+    //
+    // Parse Flags and Width
+    //
+    for (Format++; TRUE; Format++) {
+      if (*Format == '.' || *Format == '-' || *Format == '+' || *Format == ' ' || *Format == ',') {
+        continue;
+      }
+      if (*Format >= '0' && *Format <= '9') {
+        continue;
+      }
+      if (*Format == 'L' || *Format == 'l') {
+        Long = TRUE;
+        continue;
+      }
+      if (*Format == '*') {
+        if (BaseListMarker == NULL) {
+          BASE_ARG (BaseListMarkerPointer, UINTN) = VA_ARG (VaListMarker, UINTN);
+        } else {
+          BASE_ARG (BaseListMarkerPointer, UINTN) = BASE_ARG (BaseListMarker, UINTN);
+        }
+        continue;
+      }
+      if (*Format == '\0') {
+        Format--;
+      }
+      break;
+    }
+
+    if ((*Format == 'p') && (sizeof (VOID *) > 4)) {
+      Long = TRUE;
+    }
+    if (*Format == 'p' || *Format == 'X' || *Format == 'x' || *Format == 'd' || *Format == 'u') {
+      if (Long) {
+        if (BaseListMarker == NULL) {
+          BASE_ARG (BaseListMarkerPointer, INT64) = VA_ARG (VaListMarker, INT64);
+        } else {
+          BASE_ARG (BaseListMarkerPointer, INT64) = BASE_ARG (BaseListMarker, INT64);
+        }
+      } else {
+        if (BaseListMarker == NULL) {
+          BASE_ARG (BaseListMarkerPointer, int) = VA_ARG (VaListMarker, int);
+        } else {
+          BASE_ARG (BaseListMarkerPointer, int) = BASE_ARG (BaseListMarker, int);
+        }
+      }
+    } else if (*Format == 's' || *Format == 'S' || *Format == 'a' || *Format == 'g' || *Format == 't') {
+      //
+      // The data behind the pointer may be freed, or its image unloaded, by
+      // the time the record is formatted.
+      //
+      return FALSE;
+    } else if (*Format == 'c') {
+      if (BaseListMarker == NULL) {
+        BASE_ARG (BaseListMarkerPointer, UINTN) = VA_ARG (VaListMarker, UINTN);
+      } else {
+        BASE_ARG (BaseListMarkerPointer, UINTN) = BASE_ARG (BaseListMarker, UINTN);
+      }
+    } else if (*Format == 'r') {
+      if (BaseListMarker == NULL) {
+        BASE_ARG (BaseListMarkerPointer, RETURN_STATUS) = VA_ARG (VaListMarker, RETURN_STATUS);
+      } else {
+        BASE_ARG (BaseListMarkerPointer, RETURN_STATUS) = BASE_ARG (BaseListMarker, RETURN_STATUS);
+      }
+    }
+
+    //
+    // The arguments must fit in the DEBUG_LOG_RECORD_ARGUMENT_COUNT UINT64
+    // reserved for them.
+    //
+    if ((CHAR8 *) BaseListMarkerPointer > FormatString) {
+      return FALSE;
+    }
+  }
+
+  Record->DataSize   = (UINT16) (DEBUG_LOG_RECORD_ARGUMENT_COUNT * sizeof (UINT64) + FormatSize);
+  Record->Type       = DEBUG_LOG_RECORD_TYPE_BINARY;
+  Record->Reserved   = 0;
+  Record->ErrorLevel = (UINT32) ErrorLevel;
+  DebugLogAppend (
+    DebugLog,
+    Record,
+    (UINT32) ALIGN_VALUE (sizeof (DEBUG_LOG_RECORD) + Record->DataSize, DEBUG_LOG_RECORD_ALIGNMENT)
+    );
+
+  return TRUE;
+}
+
+/**
+  Prints a debug message to the debug output device if the specified error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and the
+  associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel  The error level of the debug message.
+  @param  Format      Format string for the debug message to print.
+  @param  ...         Variable argument list whose contents are accessed
+                      based on the format string specified by Format.
+
+**/
+VOID
+EFIAPI
+DebugPrint (
+  IN  UINTN        ErrorLevel,
+  IN  CONST CHAR8  *Format,
+  ...
+  )
+{
+  VA_LIST  Marker;
+
+  VA_START (Marker, Format);
+  DebugVPrint (ErrorLevel, Format, Marker);
+  VA_END (Marker);
+}
+
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled base on Null-terminated format string and a
+  VA_LIST argument list or a BASE_LIST argument list.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  VaListMarker    VA_LIST marker for the variable argument list.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+DebugPrintMarker (
+  IN  UINTN         ErrorLevel,
+  IN  CONST CHAR8   *Format,
+  IN  VA_LIST       VaListMarker,
+  IN  BASE_LIST     BaseListMarker
+  )
+{
+  CHAR8             Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+  DEBUG_LOG_BUFFER  *DebugLog;
+  VA_LIST           Marker;
+  BOOLEAN           Written;
+
+  //
+  // If Format is NULL, then ASSERT().
+  //
+  ASSERT (Format != NULL);
+
+  //
+  // Check driver debug mask value and global mask
+  //
+  if ((ErrorLevel & GetDebugPrintErrorLevel ()) == 0) {
+    return;
+  }
+
+  //
+  // Leave the formatting to DebugLogDxe if it drains a log of records. The
+  // arguments are packed from a copy of VaListMarker, which is still needed
+  // if the message has to be formatted here after all. DEBUG_ERROR messages
+  // are formatted here, in case they have to be written to the serial port.
+  //
+  DebugLog = GetDebugLogBuffer ();
+  if ((DebugLog != NULL) && ((ErrorLevel & DEBUG_ERROR) == 0) &&
+      ((DebugLog->Flags & (DEBUG_LOG_BUFFER_FLAG_RECORDS | DEBUG_LOG_BUFFER_FLAG_SYNCHRONOUS)) == DEBUG_LOG_BUFFER_FLAG_RECORDS)) {
+    VA_COPY (Marker, VaListMarker);
+    Written = DebugLogWriteBinary (DebugLog, ErrorLevel, Format, Marker, BaseListMarker);
+    VA_END (Marker);
+    if (Written) {
+      return;
+    }
+  }
+
+  //
+  // Convert the DEBUG() message to an ASCII String
+  //
+  if (BaseListMarker == NULL) {
+    AsciiVSPrint (Buffer, sizeof (Buffer), Format, VaListMarker);
+  } else {
+    AsciiBSPrint (Buffer, sizeof (Buffer), Format, BaseListMarker);
+  }
+
+  //
+  // Append the print string to the debug log
+  //
+  DebugLogWrite (ErrorLevel, Buffer, AsciiStrLen (Buffer));
+}
+
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel    The error level of the debug message.
+  @param  Format        Format string for the debug message to print.
+  @param  VaListMarker  VA_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugVPrint (
+  IN  UINTN         ErrorLevel,
+  IN  CONST CHAR8   *Format,
+  IN  VA_LIST       VaListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, VaListMarker, NULL);
+}
+
+
+/**
+  Prints a debug message to the debug output device if the specified
+  error level is enabled.
+  This function use BASE_LIST which would provide a more compatible
+  service than VA_LIST.
+
+  If any bit in ErrorLevel is also set in DebugPrintErrorLevelLib function
+  GetDebugPrintErrorLevel (), then print the message specified by Format and
+  the associated variable argument list to the debug output device.
+
+  If Format is NULL, then ASSERT().
+
+  @param  ErrorLevel      The error level of the debug message.
+  @param  Format          Format string for the debug message to print.
+  @param  BaseListMarker  BASE_LIST marker for the variable argument list.
+
+**/
+VOID
+EFIAPI
+DebugBPrint (
+  IN  UINTN         ErrorLevel,
+  IN  CONST CHAR8   *Format,
+  IN  BASE_LIST     BaseListMarker
+  )
+{
+  DebugPrintMarker (ErrorLevel, Format, mVaListNull, BaseListMarker);
+}
+
+
+/**
+  Prints an assert message containing a filename, line number, and description.
+  This may be followed by a breakpoint or a dead loop.
+
+  Print a message of the form "ASSERT <FileName>(<LineNumber>): <Description>\n"
+  to the debug output device.  If DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED bit of
+  PcdDebugProperyMask is set then CpuBreakpoint() is called. Otherwise, if
+  DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED bit of PcdDebugProperyMask is set then
+  CpuDeadLoop() is called.  If neither of these bits are set, then this function
+  returns immediately after the message is printed to the debug output device.
+  DebugAssert() must actively prevent recursion.  If DebugAssert() is called while
+  processing another DebugAssert(), then DebugAssert() must return immediately.
+
+  If FileName is NULL, then a <FileName> string of "(NULL) Filename" is printed.
+  If Description is NULL, then a <Description> string of "(NULL) Description" is printed.
+
+  @param  FileName     The pointer to the name of the source file that generated the assert condition.
+  @param  LineNumber   The line number in the source file that generated the assert condition
+  @param  Description  The pointer to the description of the assert condition.
+
+**/
+VOID
+EFIAPI
+DebugAssert (
+  IN CONST CHAR8  *FileName,
+  IN UINTN        LineNumber,
+  IN CONST CHAR8  *Description
+  )
+{
+  CHAR8             Buffer[MAX_DEBUG_MESSAGE_LENGTH];
+  DEBUG_LOG_BUFFER  *DebugLog;
+
+  //
+  // Generate the ASSERT() message in Ascii format
+  //
+  AsciiSPrint (Buffer, sizeof (Buffer), "ASSERT [%a] %a(%d): %a\n", gEfiCallerBaseName, FileName, LineNumber, Description);
+
+  //
+  // The timer that drains the debug log may never run again. Send the
+  // messages printed before the assert, unless a message is still being
+  // copied into the log, then the assert itself, to the Serial Port right
+  // away.
+  //
+  DebugLog = GetDebugLogBuffer ();
+  if ((DebugLog != NULL) && ((DebugLog->Flags & DEBUG_LOG_BUFFER_FLAG_SYNCHRONOUS) == 0)) {
+    DebugLogDrain (DebugLog, SerialPortWrite);
+  }
+  SerialPortWrite ((UINT8 *)Buffer, AsciiStrLen (Buffer));
+
+  //
+  // Generate a Breakpoint, DeadLoop, or NOP based on PCD settings
+  //
+  if ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_BREAKPOINT_ENABLED) != 0) {
+    CpuBreakpoint ();
+  } else if ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_ASSERT_DEADLOOP_ENABLED) != 0) {
+    CpuDeadLoop ();
+  }
+}
+
+
+/**
+  Fills a target buffer with PcdDebugClearMemoryValue, and returns the target buffer.
+
+  This function fills Length bytes of Buffer with the value specified by
+  PcdDebugClearMemoryValue, and returns Buffer.
+
+  If Buffer is NULL, then ASSERT().
+  If Length is greater than (MAX_ADDRESS - Buffer + 1), then ASSERT().
+
+  @param   Buffer  The pointer to the target buffer to be filled with PcdDebugClearMemoryValue.
+  @param   Length  The number of bytes in Buffer to fill with zeros PcdDebugClearMemoryValue.
+
+  @return  Buffer  The pointer to the target buffer filled with PcdDebugClearMemoryValue.
+
+**/
+VOID *
+EFIAPI
+DebugClearMemory (
+  OUT VOID  *Buffer,
+  IN UINTN  Length
+  )
+{
+  //
+  // If Buffer is NULL, then ASSERT().
+  //
+  ASSERT (Buffer != NULL);
+
+  //
+  // SetMem() checks for the the ASSERT() condition on Length and returns Buffer
+  //
+  return SetMem (Buffer, Length, PcdGet8(PcdDebugClearMemoryValue));
+}
+
+
+/**
+  Returns TRUE if ASSERT() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugAssertEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN) ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_ASSERT_ENABLED) != 0);
+}
+
+
+/**
+  Returns TRUE if DEBUG() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_PRINT_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN) ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_PRINT_ENABLED) != 0);
+}
+
+
+/**
+  Returns TRUE if DEBUG_CODE() macros are enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_DEBUG_CODE_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugCodeEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN) ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_DEBUG_CODE_ENABLED) != 0);
+}
+
+
+/**
+  Returns TRUE if DEBUG_CLEAR_MEMORY() macro is enabled.
+
+  This function returns TRUE if the DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of
+  PcdDebugProperyMask is set.  Otherwise FALSE is returned.
+
+  @retval  TRUE    The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is set.
+  @retval  FALSE   The DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED bit of PcdDebugProperyMask is clear.
+
+**/
+BOOLEAN
+EFIAPI
+DebugClearMemoryEnabled (
+  VOID
+  )
+{
+  return (BOOLEAN) ((PcdGet8(PcdDebugPropertyMask) & DEBUG_PROPERTY_CLEAR_MEMORY_ENABLED) != 0);
+}
+
+/**
+  Returns TRUE if any one of the bit is set both in ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  This function compares the bit mask of ErrorLevel and PcdFixedDebugPrintErrorLevel.
+
+  @retval  TRUE    Current ErrorLevel is supported.
+  @retval  FALSE   Current ErrorLevel is not supported.
+
+**/
+BOOLEAN
+EFIAPI
+DebugPrintLevelEnabled (
+  IN  CONST UINTN        ErrorLevel
+  )
+{
+  return (BOOLEAN) ((ErrorLevel & PcdGet32(PcdFixedDebugPrintErrorLevel)) != 0);
+}
+
@@ -87,6 +87,13 @@ EFI_NARROW_GLYPH     mCursorGlyph = {
 
 CHAR16       SpaceStr[] = { NARROW_CHAR, ' ', 0 };
 
+//
+// The glyph cache is only used once the font package notifications that
+// flush it are registered.
+//
+BOOLEAN              mGlyphCacheEnabled = FALSE;
+GLYPH_CACHE_ENTRY    mGlyphCache[GLYPH_CACHE_SIZE];
+
 EFI_DRIVER_BINDING_PROTOCOL gGraphicsConsoleDriverBinding = {
   GraphicsConsoleControllerDriverSupported,
   GraphicsConsoleControllerDriverStart,
@@ -1768,6 +1775,14 @@ DrawUnicodeWeightAtCursorN (
   EFI_HII_ROW_INFO                  *RowInfoArray;
   UINTN                             RowInfoArraySize;
 
+  //
+  // Most of the characters are drawn from the glyph cache.
+  //
+  Status = DrawCachedGlyphsAtCursorN (This, UnicodeWeight, Count);
+  if (Status != EFI_UNSUPPORTED) {
+    return Status;
+  }
+
   Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
   Blt = (EFI_IMAGE_OUTPUT *) AllocateZeroPool (sizeof (EFI_IMAGE_OUTPUT));
   if (Blt == NULL) {
@@ -1890,6 +1905,207 @@ DrawUnicodeWeightAtCursorN (
   return Status;
 }
 
+/**
+  Get the glyph cache entry of a character. The character is rendered by the
+  HII Font protocol in white on black if it is not in the cache yet.
+
+  @param  Char                  The character to look up.
+
+  @return The glyph cache entry, or NULL if the character can not be drawn from
+          the glyph cache.
+
+**/
+GLYPH_CACHE_ENTRY *
+GetCachedGlyph (
+  IN  CHAR16                           Char
+  )
+{
+  EFI_STATUS                        Status;
+  GLYPH_CACHE_ENTRY                 *Entry;
+  EFI_IMAGE_OUTPUT                  Image;
+  EFI_IMAGE_OUTPUT                  *Blt;
+  EFI_FONT_DISPLAY_INFO             *FontInfo;
+  EFI_HII_ROW_INFO                  *RowInfoArray;
+  UINTN                             RowInfoArraySize;
+  CHAR16                            String[2];
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *Pixel;
+  UINTN                             PosX;
+  UINTN                             PosY;
+  UINT8                             Rows[EFI_GLYPH_HEIGHT];
+
+  Entry = &mGlyphCache[Char % GLYPH_CACHE_SIZE];
+  if (Entry->State != GLYPH_CACHE_EMPTY && Entry->Char == Char) {
+    return (Entry->State == GLYPH_CACHE_VALID) ? Entry : NULL;
+  }
+
+  FontInfo = (EFI_FONT_DISPLAY_INFO *) AllocateZeroPool (sizeof (EFI_FONT_DISPLAY_INFO));
+  if (FontInfo == NULL) {
+    return NULL;
+  }
+  FontInfo->ForegroundColor = mGraphicsEfiColors[EFI_WHITE];
+  FontInfo->BackgroundColor = mGraphicsEfiColors[EFI_BLACK];
+
+  //
+  // Leave room around the narrow glyph cell, so that wider or taller glyphs
+  // are detected instead of being clipped.
+  //
+  ZeroMem (&Image, sizeof (Image));
+  Image.Width        = 2 * EFI_GLYPH_WIDTH;
+  Image.Height       = 2 * EFI_GLYPH_HEIGHT;
+  Image.Image.Bitmap = AllocateZeroPool (Image.Width * Image.Height * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL));
+  if (Image.Image.Bitmap == NULL) {
+    FreePool (FontInfo);
+    return NULL;
+  }
+
+  String[0]    = Char;
+  String[1]    = L'\0';
+  Blt          = &Image;
+  RowInfoArray = NULL;
+  Status = mHiiFont->StringToImage (
+                       mHiiFont,
+                       EFI_HII_IGNORE_IF_NO_GLYPH | EFI_HII_IGNORE_LINE_BREAK,
+                       String,
+                       FontInfo,
+                       &Blt,
+                       0,
+                       0,
+                       &RowInfoArray,
+                       &RowInfoArraySize,
+                       NULL
+                       );
+
+  Entry->Char  = Char;
+  Entry->State = GLYPH_CACHE_UNCACHED;
+  if (Status == EFI_SUCCESS && RowInfoArraySize == 1 &&
+      RowInfoArray[0].LineWidth == EFI_GLYPH_WIDTH &&
+      RowInfoArray[0].LineHeight == EFI_GLYPH_HEIGHT) {
+    //
+    // Only a glyph made of the foreground and background colors can be
+    // drawn in other colors later.
+    //
+    Entry->State = GLYPH_CACHE_VALID;
+    for (PosY = 0; PosY < EFI_GLYPH_HEIGHT && Entry->State == GLYPH_CACHE_VALID; PosY++) {
+      Rows[PosY] = 0;
+      Pixel      = Image.Image.Bitmap + PosY * Image.Width;
+      for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+        if (CompareMem (&Pixel[PosX], &FontInfo->ForegroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) == 0) {
+          Rows[PosY] |= (UINT8) (BIT7 >> PosX);
+        } else if (CompareMem (&Pixel[PosX], &FontInfo->BackgroundColor, sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)) != 0) {
+          Entry->State = GLYPH_CACHE_UNCACHED;
+          break;
+        }
+      }
+    }
+    CopyMem (Entry->Rows, Rows, sizeof (Rows));
+  }
+
+  if (RowInfoArray != NULL) {
+    FreePool (RowInfoArray);
+  }
+  FreePool (Image.Image.Bitmap);
+  FreePool (FontInfo);
+
+  return (Entry->State == GLYPH_CACHE_VALID) ? Entry : NULL;
+}
+
+/**
+  Draw Unicode string on the Graphics Console device's screen from the glyph
+  cache. The string is composed in the line buffer and drawn by one Blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  UnicodeWeight         One Unicode string to be displayed.
+  @param  Count                 The count of Unicode string.
+
+  @retval EFI_UNSUPPORTED       Some character is not in the glyph cache, or no
+                                Graphics Output protocol and UGA Draw protocol
+                                exist.
+  @retval EFI_SUCCESS           Drawing Unicode string implemented successfully.
+  @return other                 The Blt to the device failed.
+
+**/
+EFI_STATUS
+DrawCachedGlyphsAtCursorN (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           *UnicodeWeight,
+  IN  UINTN                            Count
+  )
+{
+  EFI_STATUS                        Status;
+  GRAPHICS_CONSOLE_DEV              *Private;
+  GLYPH_CACHE_ENTRY                 *Glyph;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     Foreground;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     Background;
+  EFI_GRAPHICS_OUTPUT_BLT_PIXEL     *Pixel;
+  UINTN                             Width;
+  UINTN                             Index;
+  UINTN                             PosX;
+  UINTN                             PosY;
+  UINTN                             GlyphX;
+  UINTN                             GlyphY;
+
+  Private = GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS (This);
+  if (!mGlyphCacheEnabled || Count == 0 || Private->LineBuffer == NULL ||
+      Count > Private->ModeData[This->Mode->Mode].Columns) {
+    return EFI_UNSUPPORTED;
+  }
+  if (Private->GraphicsOutput == NULL && !FeaturePcdGet (PcdUgaConsumeSupport)) {
+    return EFI_UNSUPPORTED;
+  }
+
+  GetTextColors (This, &Foreground, &Background);
+
+  //
+  // Compose the string in the line buffer.
+  //
+  Width = Count * EFI_GLYPH_WIDTH;
+  for (Index = 0; Index < Count; Index++) {
+    Glyph = GetCachedGlyph (UnicodeWeight[Index]);
+    if (Glyph == NULL) {
+      return EFI_UNSUPPORTED;
+    }
+    Pixel = Private->LineBuffer + Index * EFI_GLYPH_WIDTH;
+    for (PosY = 0; PosY < EFI_GLYPH_HEIGHT; PosY++) {
+      for (PosX = 0; PosX < EFI_GLYPH_WIDTH; PosX++) {
+        Pixel[PosX] = ((Glyph->Rows[PosY] & (BIT7 >> PosX)) != 0) ? Foreground : Background;
+      }
+      Pixel += Width;
+    }
+  }
+
+  GlyphX = This->Mode->CursorColumn * EFI_GLYPH_WIDTH + Private->ModeData[This->Mode->Mode].DeltaX;
+  GlyphY = This->Mode->CursorRow * EFI_GLYPH_HEIGHT + Private->ModeData[This->Mode->Mode].DeltaY;
+  if (Private->GraphicsOutput != NULL) {
+    Status = Private->GraphicsOutput->Blt (
+                                        Private->GraphicsOutput,
+                                        Private->LineBuffer,
+                                        EfiBltBufferToVideo,
+                                        0,
+                                        0,
+                                        GlyphX,
+                                        GlyphY,
+                                        Width,
+                                        EFI_GLYPH_HEIGHT,
+                                        Width * sizeof (EFI_GRAPHICS_OUTPUT_BLT_PIXEL)
+                                        );
+  } else {
+    Status = Private->UgaDraw->Blt (
+                                 Private->UgaDraw,
+                                 (EFI_UGA_PIXEL *) Private->LineBuffer,
+                                 EfiUgaBltBufferToVideo,
+                                 0,
+                                 0,
+                                 GlyphX,
+                                 GlyphY,
+                                 Width,
+                                 EFI_GLYPH_HEIGHT,
+                                 Width * sizeof (EFI_UGA_PIXEL)
+                                 );
+  }
+
+  return Status;
+}
+
 /**
   Flush the cursor on the screen.
 
@@ -2010,6 +2226,40 @@ FlushCursor (
   return EFI_SUCCESS;
 }
 
+/**
+  HII Database package notification function for font packages.
+
+  A new or removed font package may change how a character is rendered, so the
+  glyph cache is flushed.
+
+  @param  PackageType           Package type of the notification.
+  @param  PackageGuid           If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then
+                                this is the pointer to the GUID from the Guid
+                                field of EFI_HII_PACKAGE_GUID_HEADER. Otherwise,
+                                it must be NULL.
+  @param  Package               Points to the package referred to by the
+                                notification.
+  @param  Handle                The handle of the package list which contains the
+                                specified package.
+  @param  NotifyType            The type of change concerning the database.
+
+  @retval EFI_SUCCESS           The glyph cache is flushed.
+
+**/
+EFI_STATUS
+EFIAPI
+GlyphCacheNotify (
+  IN UINT8                              PackageType,
+  IN CONST EFI_GUID                     *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER       *Package,
+  IN EFI_HII_HANDLE                     Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE       NotifyType
+  )
+{
+  ZeroMem (mGlyphCache, sizeof (mGlyphCache));
+  return EFI_SUCCESS;
+}
+
 /**
   HII Database Protocol notification event handler.
 
@@ -2031,6 +2281,11 @@ RegisterFontPackage (
   UINT8                                *Package;
   UINT8                                *Location;
   EFI_HII_DATABASE_PROTOCOL            *HiiDatabase;
+  UINT8                                PackageTypes[2];
+  EFI_HII_DATABASE_NOTIFY_TYPE         NotifyTypes[3];
+  EFI_HANDLE                           NotifyHandle;
+  UINTN                                TypeIndex;
+  UINTN                                NotifyIndex;
 
   //
   // Locate HII Database Protocol
@@ -2085,6 +2340,31 @@ RegisterFontPackage (
                  );
   ASSERT (mHiiHandle != NULL);
   FreePool (Package);
+
+  //
+  // Enable the glyph cache once it is flushed on every font package change.
+  //
+  PackageTypes[0] = EFI_HII_PACKAGE_SIMPLE_FONTS;
+  PackageTypes[1] = EFI_HII_PACKAGE_FONTS;
+  NotifyTypes[0]  = EFI_HII_DATABASE_NOTIFY_NEW_PACK;
+  NotifyTypes[1]  = EFI_HII_DATABASE_NOTIFY_ADD_PACK;
+  NotifyTypes[2]  = EFI_HII_DATABASE_NOTIFY_REMOVE_PACK;
+  for (TypeIndex = 0; TypeIndex < ARRAY_SIZE (PackageTypes); TypeIndex++) {
+    for (NotifyIndex = 0; NotifyIndex < ARRAY_SIZE (NotifyTypes); NotifyIndex++) {
+      Status = HiiDatabase->RegisterPackageNotify (
+                              HiiDatabase,
+                              PackageTypes[TypeIndex],
+                              NULL,
+                              GlyphCacheNotify,
+                              NotifyTypes[NotifyIndex],
+                              &NotifyHandle
+                              );
+      if (EFI_ERROR (Status)) {
+        return;
+      }
+    }
+  }
+  mGlyphCacheEnabled = TRUE;
 }
 
 /**
@@ -70,6 +70,24 @@ typedef struct {
 #define GRAPHICS_CONSOLE_CON_OUT_DEV_FROM_THIS(a) \
   CR (a, GRAPHICS_CONSOLE_DEV, SimpleTextOutput, GRAPHICS_CONSOLE_DEV_SIGNATURE)
 
+//
+// Glyph cache. An entry holds the monochrome bitmap of one narrow character as
+// rendered by the HII Font protocol, one byte per row with BIT7 being the
+// leftmost pixel. Characters which can not be described that way are marked
+// so that they are always drawn by the HII Font protocol.
+//
+#define GLYPH_CACHE_SIZE        256
+
+#define GLYPH_CACHE_EMPTY       0
+#define GLYPH_CACHE_VALID       1
+#define GLYPH_CACHE_UNCACHED    2
+
+typedef struct {
+  CHAR16  Char;
+  UINT8   State;
+  UINT8   Rows[EFI_GLYPH_HEIGHT];
+} GLYPH_CACHE_ENTRY;
+
 
 //
 // EFI Component Name Functions
@@ -546,6 +564,28 @@ DrawUnicodeWeightAtCursorN (
   IN  UINTN                            Count
   );
 
+/**
+  Draw Unicode string on the Graphics Console device's screen from the glyph
+  cache. The string is composed in the line buffer and drawn by one Blt.
+
+  @param  This                  Protocol instance pointer.
+  @param  UnicodeWeight         One Unicode string to be displayed.
+  @param  Count                 The count of Unicode string.
+
+  @retval EFI_UNSUPPORTED       Some character is not in the glyph cache, or no
+                                Graphics Output protocol and UGA Draw protocol
+                                exist.
+  @retval EFI_SUCCESS           Drawing Unicode string implemented successfully.
+  @return other                 The Blt to the device failed.
+
+**/
+EFI_STATUS
+DrawCachedGlyphsAtCursorN (
+  IN  EFI_SIMPLE_TEXT_OUTPUT_PROTOCOL  *This,
+  IN  CHAR16                           *UnicodeWeight,
+  IN  UINTN                            Count
+  );
+
 /**
   Flush the cursor on the screen.
 
@@ -65,6 +65,11 @@ typedef struct {
 
 #define KEYBOARD_TIMER_INTERVAL         200000  // 0.02s
 
+//
+// Bytes collected by OutputString() before they are handed to SerialIo->Write()
+//
+#define TERMINAL_OUTPUT_BUFFER_SIZE     256
+
 #define TERMINAL_DEV_SIGNATURE  SIGNATURE_32 ('t', 'm', 'n', 'l')
 
 #define TERMINAL_CONSOLE_IN_EX_NOTIFY_SIGNATURE SIGNATURE_32 ('t', 'm', 'e', 'n')
@@ -176,22 +176,23 @@ TerminalConOutOutputString (
   EFI_SIMPLE_TEXT_OUTPUT_MODE *Mode;
   UINTN                       MaxColumn;
   UINTN                       MaxRow;
-  UINTN                       Length;
   UTF8_CHAR                   Utf8Char;
   CHAR8                       GraphicChar;
   CHAR8                       AsciiChar;
   EFI_STATUS                  Status;
   UINT8                       ValidBytes;
-  CHAR8                       CrLfStr[2];
+  UINT8                       OutputBuffer[TERMINAL_OUTPUT_BUFFER_SIZE];
+  UINTN                       OutputLength;
   //
   //  flag used to indicate whether condition happens which will cause
   //  return EFI_WARN_UNKNOWN_GLYPH
   //
   BOOLEAN                     Warning;
 
-  ValidBytes  = 0;
-  Warning     = FALSE;
-  AsciiChar   = 0;
+  ValidBytes   = 0;
+  Warning      = FALSE;
+  AsciiChar    = 0;
+  OutputLength = 0;
 
   //
   //  get Terminal device data structure pointer.
@@ -215,6 +216,21 @@ TerminalConOutOutputString (
           );
 
   for (; *WString != CHAR_NULL; WString++) {
+    //
+    // Make room for the longest output of one character: a 3-byte UTF-8
+    // sequence, or an ASCII character followed by CR LF.
+    //
+    if (OutputLength + sizeof (UTF8_CHAR) > sizeof (OutputBuffer)) {
+      Status = TerminalDevice->SerialIo->Write (
+                                          TerminalDevice->SerialIo,
+                                          &OutputLength,
+                                          OutputBuffer
+                                          );
+      if (EFI_ERROR (Status)) {
+        goto OutputError;
+      }
+      OutputLength = 0;
+    }
 
     switch (TerminalDevice->TerminalType) {
 
@@ -255,31 +271,13 @@ TerminalConOutOutputString (
         GraphicChar = AsciiChar;
       }
 
-      Length = 1;
-
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          &GraphicChar
-                                          );
-
-      if (EFI_ERROR (Status)) {
-        goto OutputError;
-      }
-
+      OutputBuffer[OutputLength++] = (UINT8) GraphicChar;
       break;
 
     case TerminalTypeVtUtf8:
       UnicodeToUtf8 (*WString, &Utf8Char, &ValidBytes);
-      Length = ValidBytes;
-      Status = TerminalDevice->SerialIo->Write (
-                                          TerminalDevice->SerialIo,
-                                          &Length,
-                                          (UINT8 *) &Utf8Char
-                                          );
-      if (EFI_ERROR (Status)) {
-        goto OutputError;
-      }
+      CopyMem (&OutputBuffer[OutputLength], &Utf8Char, ValidBytes);
+      OutputLength += ValidBytes;
       break;
     }
     //
@@ -325,20 +323,8 @@ TerminalConOutOutputString (
           // the driver, but only if we're not in the middle of
           // printing an escape sequence.
           //
-          CrLfStr[0] = '\r';
-          CrLfStr[1] = '\n';
-
-          Length = sizeof(CrLfStr);
-
-          Status = TerminalDevice->SerialIo->Write (
-                                                TerminalDevice->SerialIo,
-                                                &Length,
-                                                CrLfStr
-                                                );
-
-          if (EFI_ERROR (Status)) {
-            goto OutputError;
-          }
+          OutputBuffer[OutputLength++] = '\r';
+          OutputBuffer[OutputLength++] = '\n';
         }
       }
       break;
@@ -347,6 +333,21 @@ TerminalConOutOutputString (
 
   }
 
+  //
+  // Send the whole string in one write, so the serial driver can fill its
+  // transmit FIFO instead of waiting for it to drain after every byte.
+  //
+  if (OutputLength != 0) {
+    Status = TerminalDevice->SerialIo->Write (
+                                        TerminalDevice->SerialIo,
+                                        &OutputLength,
+                                        OutputBuffer
+                                        );
+    if (EFI_ERROR (Status)) {
+      goto OutputError;
+    }
+  }
+
   if (Warning) {
     return EFI_WARN_UNKNOWN_GLYPH;
   }
@@ -0,0 +1,181 @@
+/** @file
+  Produce the in-memory debug log and drain it to the serial port.
+
+  Modules linked with UefiDebugLibMemoryLog append their DEBUG() messages to
+  the log instead of waiting for the serial port. This driver allocates the
+  log, installs it in the EFI System Table configuration table, and sends the
+  messages to the serial port from a periodic timer event. Each timer period
+  it writes no more than the serial port takes without waiting, so the serial
+  output may lag behind the messages.
+
+  When PcdDebugLogBinaryRecords is TRUE, the log holds records, and the
+  DEBUG() messages stored as binary records are formatted here rather than by
+  the modules that print them.
+
+Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#include <Uefi.h>
+#include <Guid/DebugLogBuffer.h>
+#include <Guid/EventGroup.h>
+#include <Library/BaseLib.h>
+#include <Library/BaseMemoryLib.h>
+#include <Library/DebugLib.h>
+#include <Library/DebugLogBufferLib.h>
+#include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
+#include <Library/SerialPortLib.h>
+#include <Library/UefiBootServicesTableLib.h>
+
+//
+// Period of the timer that drains the debug log, in 100ns units (10ms)
+//
+#define DEBUG_LOG_DRAIN_INTERVAL  100000
+
+DEBUG_LOG_BUFFER  *mDebugLog;
+EFI_EVENT         mDebugLogDrainEvent;
+
+/**
+  Drain the debug log periodically.
+
+  Only PcdDebugLogDrainSize bytes are sent, and only when the transmit buffer
+  of the serial port is empty, so that SerialPortWrite() does not wait. What
+  is left is sent by the next calls.
+
+  Nothing is sent while a message is still being copied into the log, that
+  is when the timer interrupted a writer. The next call picks it up.
+
+  @param  Event        Event whose notification function is being invoked.
+  @param  Context      Pointer to the notification function's context.
+
+**/
+VOID
+EFIAPI
+DebugLogDrainNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  UINT32  Control;
+
+  //
+  // A serial port that can't report its state gets PcdDebugLogDrainSize bytes
+  // each time.
+  //
+  if (!EFI_ERROR (SerialPortGetControl (&Control)) &&
+      ((Control & EFI_SERIAL_OUTPUT_BUFFER_EMPTY) == 0)) {
+    return;
+  }
+
+  DebugLogDrainPartial (mDebugLog, SerialPortWrite, PcdGet32 (PcdDebugLogDrainSize));
+}
+
+/**
+  Stop the drain timer and send what is left in the debug log.
+
+  Messages printed after this point are written to the serial port by
+  UefiDebugLibMemoryLog directly, and still appended to the log.
+
+  @param  Event        Event whose notification function is being invoked.
+  @param  Context      Pointer to the notification function's context.
+
+**/
+VOID
+EFIAPI
+DebugLogExitBootServicesNotify (
+  IN EFI_EVENT  Event,
+  IN VOID       *Context
+  )
+{
+  gBS->SetTimer (mDebugLogDrainEvent, TimerCancel, 0);
+  mDebugLog->Flags |= DEBUG_LOG_BUFFER_FLAG_SYNCHRONOUS;
+  DebugLogDrain (mDebugLog, SerialPortWrite);
+}
+
+/**
+  The entry point of DebugLogDxe. It allocates the debug log, installs it in
+  the EFI System Table and starts the drain timer.
+
+  @param  ImageHandle     The firmware allocated handle for the EFI image.
+  @param  SystemTable     A pointer to the EFI System Table.
+
+  @retval EFI_SUCCESS             The debug log is installed.
+  @retval EFI_OUT_OF_RESOURCES    The debug log can't be allocated.
+  @return Others                  The drain events can't be created, or the
+                                  debug log can't be installed.
+
+**/
+EFI_STATUS
+EFIAPI
+DebugLogDxeEntryPoint (
+  IN EFI_HANDLE        ImageHandle,
+  IN EFI_SYSTEM_TABLE  *SystemTable
+  )
+{
+  EFI_STATUS  Status;
+  UINT32      Size;
+  EFI_EVENT   ExitBootServicesEvent;
+
+  //
+  // The ring is used with (Offset & (Size - 1)), so its size is a power of two.
+  //
+  Size = GetPowerOfTwo32 (MAX (PcdGet32 (PcdDebugLogBufferSize), EFI_PAGE_SIZE));
+
+  //
+  // Runtime memory is left alone by the OS, so the log can still be read
+  // after boot.
+  //
+  mDebugLog = AllocateRuntimePages (EFI_SIZE_TO_PAGES (sizeof (DEBUG_LOG_BUFFER) + Size));
+  if (mDebugLog == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+  ZeroMem (mDebugLog, sizeof (DEBUG_LOG_BUFFER));
+  mDebugLog->Signature = DEBUG_LOG_BUFFER_SIGNATURE;
+  mDebugLog->Size      = Size;
+  if (FeaturePcdGet (PcdDebugLogBinaryRecords)) {
+    mDebugLog->Flags = DEBUG_LOG_BUFFER_FLAG_RECORDS;
+  }
+
+  SerialPortInitialize ();
+
+  Status = gBS->CreateEvent (
+                  EVT_TIMER | EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  DebugLogDrainNotify,
+                  NULL,
+                  &mDebugLogDrainEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    goto Error;
+  }
+
+  Status = gBS->CreateEventEx (
+                  EVT_NOTIFY_SIGNAL,
+                  TPL_CALLBACK,
+                  DebugLogExitBootServicesNotify,
+                  NULL,
+                  &gEfiEventExitBootServicesGuid,
+                  &ExitBootServicesEvent
+                  );
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (mDebugLogDrainEvent);
+    goto Error;
+  }
+
+  Status = gBS->InstallConfigurationTable (&gEdkiiDebugLogBufferGuid, mDebugLog);
+  if (EFI_ERROR (Status)) {
+    gBS->CloseEvent (ExitBootServicesEvent);
+    gBS->CloseEvent (mDebugLogDrainEvent);
+    goto Error;
+  }
+
+  gBS->SetTimer (mDebugLogDrainEvent, TimerPeriodic, DEBUG_LOG_DRAIN_INTERVAL);
+  return EFI_SUCCESS;
+
+Error:
+  FreePages (mDebugLog, EFI_SIZE_TO_PAGES (sizeof (DEBUG_LOG_BUFFER) + Size));
+  mDebugLog = NULL;
+  return Status;
+}
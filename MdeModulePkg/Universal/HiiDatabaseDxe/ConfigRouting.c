@@ -383,60 +383,144 @@ OutputConfigBody (
 }
 
 /**
-  Append a string to a multi-string format.
+  Get the buffer size of a multi-string built by AppendToMultiString().
+
+  The buffer starts with MAX_STRING_LENGTH bytes and is doubled whenever it
+  is full, so the size can be derived from the length of the string it holds.
+
+  This is a internal function.
+
+  @param  StringSize             Size of the string in bytes, including the
+                                 NULL terminator.
+
+  @return The buffer size in bytes.
+
+**/
+UINTN
+GetMultiStringBufferSize (
+  IN UINTN                         StringSize
+  )
+{
+  UINTN BufferSize;
+
+  BufferSize = MAX_STRING_LENGTH;
+  while (BufferSize < StringSize) {
+    BufferSize *= 2;
+  }
+
+  return BufferSize;
+}
+
+/**
+  Append a string of known length to a multi-string format.
 
   This is a internal function.
 
   @param  MultiString            String in <MultiConfigRequest>,
                                  <MultiConfigAltResp>, or <MultiConfigResp>. On
-                                 input, the buffer length of  this string is
-                                 MAX_STRING_LENGTH. On output, the  buffer length
-                                 might be updated.
+                                 input, the buffer length of this string is
+                                 MAX_STRING_LENGTH, or was set by a previous
+                                 append. On output, the buffer length might be
+                                 updated.
+  @param  MultiStringLength      On input, the length of MultiString in
+                                 characters. On output, the new length.
   @param  AppendString           NULL-terminated Unicode string.
+  @param  AppendStringLength     The length of AppendString in characters.
 
   @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
+  @retval EFI_OUT_OF_RESOURCES   The buffer of MultiString can't be enlarged.
   @retval EFI_SUCCESS            AppendString is append to the end of MultiString
 
 **/
 EFI_STATUS
-AppendToMultiString (
+AppendToMultiStringWithLength (
   IN OUT EFI_STRING                *MultiString,
-  IN EFI_STRING                    AppendString
+  IN OUT UINTN                     *MultiStringLength,
+  IN EFI_STRING                    AppendString,
+  IN UINTN                         AppendStringLength
   )
 {
-  UINTN AppendStringSize;
-  UINTN MultiStringSize;
-  UINTN MaxLen;
+  UINTN      BufferSize;
+  UINTN      NewSize;
+  EFI_STRING NewString;
 
-  if (MultiString == NULL || *MultiString == NULL || AppendString == NULL) {
+  if (MultiString == NULL || *MultiString == NULL || MultiStringLength == NULL || AppendString == NULL) {
     return EFI_INVALID_PARAMETER;
   }
 
-  AppendStringSize = StrSize (AppendString);
-  MultiStringSize  = StrSize (*MultiString);
-  MaxLen = MAX_STRING_LENGTH / sizeof (CHAR16);
+  BufferSize = GetMultiStringBufferSize ((*MultiStringLength + 1) * sizeof (CHAR16));
+  NewSize    = (*MultiStringLength + AppendStringLength + 1) * sizeof (CHAR16);
 
   //
-  // Enlarge the buffer each time when length exceeds MAX_STRING_LENGTH.
+  // Double the buffer when it is full, so building a long string doesn't copy
+  // the whole string on every append.
   //
-  if (MultiStringSize + AppendStringSize > MAX_STRING_LENGTH ||
-      MultiStringSize > MAX_STRING_LENGTH) {
-    *MultiString = (EFI_STRING) ReallocatePool (
-                                  MultiStringSize,
-                                  MultiStringSize + AppendStringSize,
-                                  (VOID *) (*MultiString)
-                                  );
-    MaxLen = (MultiStringSize + AppendStringSize) / sizeof (CHAR16);
-    ASSERT (*MultiString != NULL);
+  if (NewSize > BufferSize) {
+    NewString = (EFI_STRING) ReallocatePool (
+                               BufferSize,
+                               GetMultiStringBufferSize (NewSize),
+                               (VOID *) (*MultiString)
+                               );
+    if (NewString == NULL) {
+      return EFI_OUT_OF_RESOURCES;
+    }
+    *MultiString = NewString;
   }
+
   //
   // Append the incoming string
   //
-  StrCatS (*MultiString, MaxLen, AppendString);
+  CopyMem (
+    *MultiString + *MultiStringLength,
+    AppendString,
+    (AppendStringLength + 1) * sizeof (CHAR16)
+    );
+  *MultiStringLength += AppendStringLength;
 
   return EFI_SUCCESS;
 }
 
+/**
+  Append a string to a multi-string format.
+
+  This is a internal function.
+
+  @param  MultiString            String in <MultiConfigRequest>,
+                                 <MultiConfigAltResp>, or <MultiConfigResp>. On
+                                 input, the buffer length of  this string is
+                                 MAX_STRING_LENGTH. On output, the  buffer length
+                                 might be updated.
+  @param  AppendString           NULL-terminated Unicode string.
+
+  @retval EFI_INVALID_PARAMETER  Any incoming parameter is invalid.
+  @retval EFI_SUCCESS            AppendString is append to the end of MultiString
+
+**/
+EFI_STATUS
+AppendToMultiString (
+  IN OUT EFI_STRING                *MultiString,
+  IN EFI_STRING                    AppendString
+  )
+{
+  EFI_STATUS Status;
+  UINTN      MultiStringLength;
+
+  if (MultiString == NULL || *MultiString == NULL || AppendString == NULL) {
+    return EFI_INVALID_PARAMETER;
+  }
+
+  MultiStringLength = StrLen (*MultiString);
+  Status = AppendToMultiStringWithLength (
+             MultiString,
+             &MultiStringLength,
+             AppendString,
+             StrLen (AppendString)
+             );
+  ASSERT_EFI_ERROR (Status);
+
+  return Status;
+}
+
 
 /**
   Get the value of <Number> in <BlockConfig> format, i.e. the value of OFFSET
@@ -5018,6 +5102,146 @@ Done:
 }
 
 
+/**
+  This function gets the <ConfigAltResp> of one driver handle which installs
+  the EFI_HII_CONFIG_ACCESS_PROTOCOL. The default settings from the IFR of the
+  HII package list that shares the device path of the handle are merged into
+  the settings returned by the driver.
+
+  @param  Private                Hii database private structure.
+  @param  ConfigAccessHandle     The driver handle with the
+                                 EFI_HII_CONFIG_ACCESS_PROTOCOL.
+  @param  AccessResults          Null-terminated Unicode string in
+                                 <ConfigAltResp> format. String to be allocated
+                                 by the called function. De-allocation is up to
+                                 the caller.
+
+  @retval EFI_SUCCESS            The AccessResults string is filled.
+  @retval Others                 The driver returned no configuration.
+
+**/
+EFI_STATUS
+ExportConfigFromHandle (
+  IN  HII_DATABASE_PRIVATE_DATA              *Private,
+  IN  EFI_HANDLE                             ConfigAccessHandle,
+  OUT EFI_STRING                             *AccessResults
+  )
+{
+  EFI_STATUS                          Status;
+  EFI_HII_CONFIG_ACCESS_PROTOCOL      *ConfigAccess;
+  EFI_STRING                          Progress;
+  EFI_STRING                          StringPtr;
+  EFI_STRING                          ConfigRequest;
+  EFI_DEVICE_PATH_PROTOCOL            *DevicePath;
+  EFI_HII_HANDLE                      HiiHandle;
+  EFI_STRING                          DefaultResults;
+  LIST_ENTRY                          *Link;
+  HII_DATABASE_RECORD                 *Database;
+  UINT8                               *DevicePathPkg;
+  UINT8                               *CurrentDevicePath;
+  BOOLEAN                             IfrDataParsedFlag;
+
+  Status = gBS->HandleProtocol (
+                  ConfigAccessHandle,
+                  &gEfiHiiConfigAccessProtocolGuid,
+                  (VOID **) &ConfigAccess
+                  );
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Get DevicePath and HiiHandle for this ConfigAccess driver handle
+  //
+  IfrDataParsedFlag = FALSE;
+  Progress         = NULL;
+  HiiHandle        = NULL;
+  DefaultResults   = NULL;
+  Database         = NULL;
+  ConfigRequest    = NULL;
+  DevicePath       = DevicePathFromHandle (ConfigAccessHandle);
+  if (DevicePath != NULL) {
+    for (Link = Private->DatabaseList.ForwardLink;
+         Link != &Private->DatabaseList;
+         Link = Link->ForwardLink
+        ) {
+      Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+      if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
+        CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
+        if (CompareMem (
+              DevicePath,
+              CurrentDevicePath,
+              GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *) CurrentDevicePath)
+              ) == 0) {
+          HiiHandle = Database->Handle;
+          break;
+        }
+      }
+    }
+  }
+
+  Status = ConfigAccess->ExtractConfig (
+                           ConfigAccess,
+                           NULL,
+                           &Progress,
+                           AccessResults
+                           );
+  if (EFI_ERROR (Status)) {
+    //
+    // Update AccessResults by getting default setting from IFR when HiiPackage is registered to HiiHandle
+    //
+    if (HiiHandle != NULL && DevicePath != NULL) {
+      IfrDataParsedFlag = TRUE;
+      Status = GetFullStringFromHiiFormPackages (Database, DevicePath, &ConfigRequest, &DefaultResults, NULL);
+      //
+      // Get the full request string to get the Current setting again.
+      //
+      if (!EFI_ERROR (Status) && ConfigRequest != NULL) {
+        Status = ConfigAccess->ExtractConfig (
+                                 ConfigAccess,
+                                 ConfigRequest,
+                                 &Progress,
+                                 AccessResults
+                                 );
+        FreePool (ConfigRequest);
+      } else {
+        Status = EFI_NOT_FOUND;
+      }
+    }
+  }
+
+  if (EFI_ERROR (Status)) {
+    return Status;
+  }
+
+  //
+  // Update AccessResults by getting default setting from IFR when HiiPackage is registered to HiiHandle
+  //
+  if (!IfrDataParsedFlag && HiiHandle != NULL && DevicePath != NULL) {
+    StringPtr = StrStr (*AccessResults, L"&GUID=");
+    if (StringPtr != NULL) {
+      *StringPtr = 0;
+    }
+    if (GetElementsFromRequest (*AccessResults)) {
+      Status = GetFullStringFromHiiFormPackages (Database, DevicePath, AccessResults, &DefaultResults, NULL);
+      ASSERT_EFI_ERROR (Status);
+    }
+    if (StringPtr != NULL) {
+      *StringPtr = L'&';
+    }
+  }
+  //
+  // Merge the default sting from IFR code into the got setting from driver.
+  //
+  if (DefaultResults != NULL) {
+    Status = MergeDefaultString (AccessResults, DefaultResults);
+    ASSERT_EFI_ERROR (Status);
+    FreePool (DefaultResults);
+  }
+
+  return EFI_SUCCESS;
+}
+
 /**
   This function allows the caller to request the current configuration for the
   entirety of the current HII database and returns the data in a
@@ -5048,24 +5272,12 @@ HiiConfigRoutingExportConfig (
   )
 {
   EFI_STATUS                          Status;
-  EFI_HII_CONFIG_ACCESS_PROTOCOL      *ConfigAccess;
   EFI_STRING                          AccessResults;
-  EFI_STRING                          Progress;
-  EFI_STRING                          StringPtr;
-  EFI_STRING                          ConfigRequest;
   UINTN                               Index;
   EFI_HANDLE                          *ConfigAccessHandles;
   UINTN                               NumberConfigAccessHandles;
   BOOLEAN                             FirstElement;
-  EFI_DEVICE_PATH_PROTOCOL            *DevicePath;
-  EFI_HII_HANDLE                      HiiHandle;
-  EFI_STRING                          DefaultResults;
   HII_DATABASE_PRIVATE_DATA           *Private;
-  LIST_ENTRY                          *Link;
-  HII_DATABASE_RECORD                 *Database;
-  UINT8                               *DevicePathPkg;
-  UINT8                               *CurrentDevicePath;
-  BOOLEAN                             IfrDataParsedFlag;
 
   if (This == NULL || Results == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -5097,102 +5309,9 @@ HiiConfigRoutingExportConfig (
   FirstElement = TRUE;
 
   for (Index = 0; Index < NumberConfigAccessHandles; Index++) {
-    Status = gBS->HandleProtocol (
-                    ConfigAccessHandles[Index],
-                    &gEfiHiiConfigAccessProtocolGuid,
-                    (VOID **) &ConfigAccess
-                    );
-    if (EFI_ERROR (Status)) {
-      continue;
-    }
-
-    //
-    // Get DevicePath and HiiHandle for this ConfigAccess driver handle
-    //
-    IfrDataParsedFlag = FALSE;
-    Progress         = NULL;
-    HiiHandle        = NULL;
-    DefaultResults   = NULL;
-    Database         = NULL;
-    ConfigRequest    = NULL;
-    DevicePath       = DevicePathFromHandle (ConfigAccessHandles[Index]);
-    if (DevicePath != NULL) {
-      for (Link = Private->DatabaseList.ForwardLink;
-           Link != &Private->DatabaseList;
-           Link = Link->ForwardLink
-          ) {
-        Database = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
-        if ((DevicePathPkg = Database->PackageList->DevicePathPkg) != NULL) {
-          CurrentDevicePath = DevicePathPkg + sizeof (EFI_HII_PACKAGE_HEADER);
-          if (CompareMem (
-                DevicePath,
-                CurrentDevicePath,
-                GetDevicePathSize ((EFI_DEVICE_PATH_PROTOCOL *) CurrentDevicePath)
-                ) == 0) {
-            HiiHandle = Database->Handle;
-            break;
-          }
-        }
-      }
-    }
-
-    Status = ConfigAccess->ExtractConfig (
-                             ConfigAccess,
-                             NULL,
-                             &Progress,
-                             &AccessResults
-                             );
-    if (EFI_ERROR (Status)) {
-      //
-      // Update AccessResults by getting default setting from IFR when HiiPackage is registered to HiiHandle
-      //
-      if (HiiHandle != NULL && DevicePath != NULL) {
-        IfrDataParsedFlag = TRUE;
-        Status = GetFullStringFromHiiFormPackages (Database, DevicePath, &ConfigRequest, &DefaultResults, NULL);
-        //
-        // Get the full request string to get the Current setting again.
-        //
-        if (!EFI_ERROR (Status) && ConfigRequest != NULL) {
-          Status = ConfigAccess->ExtractConfig (
-                                   ConfigAccess,
-                                   ConfigRequest,
-                                   &Progress,
-                                   &AccessResults
-                                   );
-          FreePool (ConfigRequest);
-        } else {
-          Status = EFI_NOT_FOUND;
-        }
-      }
-    }
-
+    AccessResults = NULL;
+    Status = ExportConfigFromHandle (Private, ConfigAccessHandles[Index], &AccessResults);
     if (!EFI_ERROR (Status)) {
-      //
-      // Update AccessResults by getting default setting from IFR when HiiPackage is registered to HiiHandle
-      //
-      if (!IfrDataParsedFlag && HiiHandle != NULL && DevicePath != NULL) {
-        StringPtr = StrStr (AccessResults, L"&GUID=");
-        if (StringPtr != NULL) {
-          *StringPtr = 0;
-        }
-        if (GetElementsFromRequest (AccessResults)) {
-          Status = GetFullStringFromHiiFormPackages (Database, DevicePath, &AccessResults, &DefaultResults, NULL);
-          ASSERT_EFI_ERROR (Status);
-        }
-        if (StringPtr != NULL) {
-          *StringPtr = L'&';
-        }
-      }
-      //
-      // Merge the default sting from IFR code into the got setting from driver.
-      //
-      if (DefaultResults != NULL) {
-        Status = MergeDefaultString (&AccessResults, DefaultResults);
-        ASSERT_EFI_ERROR (Status);
-        FreePool (DefaultResults);
-        DefaultResults = NULL;
-      }
-
       //
       // Attach this <ConfigAltResp> to a <MultiConfigAltResp>. There is a '&'
       // which separates the first <ConfigAltResp> and the following ones.
@@ -5497,6 +5616,7 @@ HiiBlockToConfig (
   UINTN                               Index;
   UINT8                               *TemBuffer;
   CHAR16                              *TemString;
+  UINTN                               ConfigLength;
 
   TmpBuffer = NULL;
 
@@ -5568,8 +5688,13 @@ HiiBlockToConfig (
     return EFI_OUT_OF_RESOURCES;
   }
   TemString[StringPtr - ConfigRequest] = '\0';
-  AppendToMultiString(Config, TemString);
+  ConfigLength = 0;
+  Status = AppendToMultiStringWithLength (Config, &ConfigLength, TemString, StringPtr - ConfigRequest);
   FreePool (TemString);
+  if (EFI_ERROR (Status)) {
+    *Progress = ConfigRequest;
+    goto Exit;
+  }
 
   //
   // Parse each <RequestElement> if exists
@@ -5689,12 +5814,16 @@ HiiBlockToConfig (
     StrCatS (ConfigElement, Length, L"VALUE=");
     StrCatS (ConfigElement, Length, ValueStr);
 
-    AppendToMultiString (Config, ConfigElement);
+    Status = AppendToMultiStringWithLength (Config, &ConfigLength, ConfigElement, StrLen (ConfigElement));
 
     FreePool (ConfigElement);
     FreePool (ValueStr);
     ConfigElement = NULL;
     ValueStr = NULL;
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
 
     //
     // If '\0', parsing is finished. Otherwise skip '&' to continue
@@ -5702,7 +5831,11 @@ HiiBlockToConfig (
     if (*StringPtr == 0) {
       break;
     }
-    AppendToMultiString (Config, L"&");
+    Status = AppendToMultiStringWithLength (Config, &ConfigLength, L"&", 1);
+    if (EFI_ERROR (Status)) {
+      *Progress = ConfigRequest;
+      goto Exit;
+    }
     StringPtr++;
 
   }
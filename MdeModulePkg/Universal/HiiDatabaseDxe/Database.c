@@ -1497,6 +1497,7 @@ AdjustStringPackage (
       *BlockPtr = EFI_HII_SIBT_END;
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Skip2BlockSize;
       PackageList->PackageListHdr.PackageLength += Skip2BlockSize;
       StringPackage->MaxStringId = MaxStringId;
@@ -1616,6 +1617,15 @@ RemoveStringPackages (
 
   ListHead = &PackageList->StringPkgHdr;
 
+  //
+  // Drop the language cache of HiiGetString since it refers to the packages.
+  //
+  if (PackageList->LastLanguage != NULL) {
+    FreePool (PackageList->LastLanguage);
+    PackageList->LastLanguage = NULL;
+  }
+  PackageList->LastStringPkg = NULL;
+
   while (!IsListEmpty (ListHead)) {
     Package = CR (
                 ListHead->ForwardLink,
@@ -1636,6 +1646,7 @@ RemoveStringPackages (
 
     RemoveEntryList (&Package->StringEntry);
     PackageList->PackageListHdr.PackageLength -= Package->StringPkgHdr->Header.Length;
+    InvalidateStringIndex (Package);
     FreePool (Package->StringBlock);
     FreePool (Package->StringPkgHdr);
     //
@@ -3331,10 +3342,85 @@ ExportPackageList (
   return EFI_SUCCESS;
 }
 
+/**
+This is an internal function, mainly use to free the <ConfigAltResp> strings kept
+for the driver handles in a list.
+
+@param  ListHead               The list of HII_CONFIG_RESP to free.
+
+**/
+VOID
+FreeConfigRespList (
+  IN LIST_ENTRY                             *ListHead
+  )
+{
+  HII_CONFIG_RESP                     *ConfigResp;
+
+  while (!IsListEmpty (ListHead)) {
+    ConfigResp = CR (ListHead->ForwardLink, HII_CONFIG_RESP, ConfigRespEntry, HII_CONFIG_RESP_SIGNATURE);
+    RemoveEntryList (&ConfigResp->ConfigRespEntry);
+    if (ConfigResp->ConfigAltResp != NULL) {
+      FreePool (ConfigResp->ConfigAltResp);
+    }
+    FreePool (ConfigResp);
+  }
+}
+
+/**
+This is an internal function, mainly use to check whether the configuration of
+a driver handle may have been changed by a change of the packages registered
+with DriverHandle.
+
+@param  ConfigAccessHandle     The driver handle with the EFI_HII_CONFIG_ACCESS_PROTOCOL.
+@param  DriverHandle           The driver handle whose packages have been changed.
+@param  DriverDevicePath       The device path of DriverHandle, or NULL if none.
+
+@retval TRUE                   The configuration need to be extracted again.
+@retval FALSE                  The configuration is not affected.
+
+**/
+BOOLEAN
+IsConfigAccessHandleAffected (
+  IN EFI_HANDLE                             ConfigAccessHandle,
+  IN EFI_HANDLE                             DriverHandle,
+  IN EFI_DEVICE_PATH_PROTOCOL               *DriverDevicePath
+  )
+{
+  EFI_DEVICE_PATH_PROTOCOL            *DevicePath;
+  UINTN                               DevicePathSize;
+
+  if (ConfigAccessHandle == DriverHandle) {
+    return TRUE;
+  }
+
+  //
+  // The configuration is matched to the package list by the device path,
+  // see HiiConfigRoutingExportConfig ().
+  //
+  if (DriverDevicePath == NULL) {
+    return FALSE;
+  }
+  DevicePath = DevicePathFromHandle (ConfigAccessHandle);
+  if (DevicePath == NULL) {
+    return FALSE;
+  }
+  DevicePathSize = GetDevicePathSize (DriverDevicePath);
+  return (BOOLEAN) (GetDevicePathSize (DevicePath) == DevicePathSize &&
+                    CompareMem (DevicePath, DriverDevicePath, DevicePathSize) == 0);
+}
+
 /**
 This function mainly use to get and update ConfigResp string.
 
+The <ConfigAltResp> of each driver handle is kept, and only the configuration
+of the driver handles affected by DriverHandle, or of new driver handles, is
+extracted again. The result is the same string HiiConfigRoutingExportConfig ()
+returns, without calling the ExtractConfig () of every driver.
+
 @param  This                   A pointer to the EFI_HII_DATABASE_PROTOCOL instance.
+@param  DriverHandle           The driver handle whose form packages have been
+                               changed, or NULL to extract the configuration of
+                               all driver handles.
 
 @retval EFI_SUCCESS            Get the information successfully.
 @retval EFI_OUT_OF_RESOURCES   Not enough memory to store the Configuration Setting data.
@@ -3342,54 +3428,156 @@ This function mainly use to get and update ConfigResp string.
 **/
 EFI_STATUS
 HiiGetConfigRespInfo(
-  IN CONST EFI_HII_DATABASE_PROTOCOL        *This
+  IN CONST EFI_HII_DATABASE_PROTOCOL        *This,
+  IN EFI_HANDLE                             DriverHandle OPTIONAL
   )
 {
   EFI_STATUS                          Status;
   HII_DATABASE_PRIVATE_DATA           *Private;
-  EFI_STRING                          ConfigAltResp;
+  EFI_HANDLE                          *ConfigAccessHandles;
+  UINTN                               NumberConfigAccessHandles;
+  UINTN                               Index;
+  LIST_ENTRY                          ConfigRespList;
+  LIST_ENTRY                          *Link;
+  HII_CONFIG_RESP                     *ConfigResp;
+  EFI_DEVICE_PATH_PROTOCOL            *DriverDevicePath;
+  EFI_STRING                          StringPtr;
   UINTN                               ConfigSize;
-
-  ConfigAltResp        = NULL;
-  ConfigSize           = 0;
+  BOOLEAN                             FirstElement;
 
   Private = HII_DATABASE_DATABASE_PRIVATE_DATA_FROM_THIS (This);
 
   //
-  // Get ConfigResp string
+  // The pending form package changes are handled by this export.
   //
-  Status = HiiConfigRoutingExportConfig(&Private->ConfigRouting,&ConfigAltResp);
+  gExportConfigResp = FALSE;
 
-  if (!EFI_ERROR (Status)){
-    ConfigSize = StrSize(ConfigAltResp);
-    if (ConfigSize > gConfigRespSize){
-      //
-      // Do 25% overallocation to minimize the number of memory allocations after ReadyToBoot.
-      // Since lots of allocation after ReadyToBoot may change memory map and cause S4 resume issue.
-      //
-      gConfigRespSize = ConfigSize + (ConfigSize >> 2);
-      if (gRTConfigRespBuffer != NULL){
-        FreePool(gRTConfigRespBuffer);
-        DEBUG ((DEBUG_WARN, "[HiiDatabase]: Memory allocation is required after ReadyToBoot, which may change memory map and cause S4 resume issue.\n"));
+  NumberConfigAccessHandles = 0;
+  Status = gBS->LocateHandleBuffer (
+                  ByProtocol,
+                  &gEfiHiiConfigAccessProtocolGuid,
+                  NULL,
+                  &NumberConfigAccessHandles,
+                  &ConfigAccessHandles
+                  );
+  if (EFI_ERROR (Status)) {
+    FreeConfigRespList (&Private->ConfigRespList);
+    return EFI_SUCCESS;
+  }
+
+  DriverDevicePath = NULL;
+  if (DriverHandle != NULL) {
+    DriverDevicePath = DevicePathFromHandle (DriverHandle);
+  }
+
+  //
+  // Build the list of <ConfigAltResp> in the order of the driver handles,
+  // reusing the kept strings of the driver handles that are not affected.
+  //
+  InitializeListHead (&ConfigRespList);
+  ConfigSize = 0;
+  for (Index = 0; Index < NumberConfigAccessHandles; Index++) {
+    ConfigResp = NULL;
+    for (Link = Private->ConfigRespList.ForwardLink; Link != &Private->ConfigRespList; Link = Link->ForwardLink) {
+      ConfigResp = CR (Link, HII_CONFIG_RESP, ConfigRespEntry, HII_CONFIG_RESP_SIGNATURE);
+      if (ConfigResp->ConfigAccessHandle == ConfigAccessHandles[Index]) {
+        break;
       }
-      gRTConfigRespBuffer = (EFI_STRING) AllocateRuntimeZeroPool (gConfigRespSize);
-      if (gRTConfigRespBuffer == NULL){
-        FreePool(ConfigAltResp);
-        DEBUG ((DEBUG_ERROR, "[HiiDatabase]: No enough memory resource to store the ConfigResp string.\n"));
-        //
-        // Remove from the System Table when the configuration runtime buffer is freed.
-        //
-        gBS->InstallConfigurationTable (&gEfiHiiConfigRoutingProtocolGuid, NULL);
-        return EFI_OUT_OF_RESOURCES;
+      ConfigResp = NULL;
+    }
+
+    if (ConfigResp != NULL) {
+      RemoveEntryList (&ConfigResp->ConfigRespEntry);
+      if (DriverHandle == NULL ||
+          IsConfigAccessHandleAffected (ConfigAccessHandles[Index], DriverHandle, DriverDevicePath)) {
+        if (ConfigResp->ConfigAltResp != NULL) {
+          FreePool (ConfigResp->ConfigAltResp);
+          ConfigResp->ConfigAltResp = NULL;
+        }
+        if (EFI_ERROR (ExportConfigFromHandle (Private, ConfigAccessHandles[Index], &ConfigResp->ConfigAltResp))) {
+          ConfigResp->ConfigAltResp = NULL;
+        }
       }
     } else {
-      ZeroMem(gRTConfigRespBuffer,gConfigRespSize);
+      ConfigResp = (HII_CONFIG_RESP *) AllocateZeroPool (sizeof (HII_CONFIG_RESP));
+      if (ConfigResp == NULL) {
+        continue;
+      }
+      ConfigResp->Signature          = HII_CONFIG_RESP_SIGNATURE;
+      ConfigResp->ConfigAccessHandle = ConfigAccessHandles[Index];
+      if (EFI_ERROR (ExportConfigFromHandle (Private, ConfigAccessHandles[Index], &ConfigResp->ConfigAltResp))) {
+        ConfigResp->ConfigAltResp = NULL;
+      }
+    }
+    InsertTailList (&ConfigRespList, &ConfigResp->ConfigRespEntry);
+
+    if (ConfigResp->ConfigAltResp != NULL) {
+      //
+      // The string and either the '&' which separates it from the following
+      // one or the null terminator.
+      //
+      ConfigSize += StrLen (ConfigResp->ConfigAltResp) * sizeof (CHAR16) + sizeof (CHAR16);
     }
-    CopyMem(gRTConfigRespBuffer,ConfigAltResp,ConfigSize);
-    gBS->InstallConfigurationTable (&gEfiHiiConfigRoutingProtocolGuid, gRTConfigRespBuffer);
-    FreePool(ConfigAltResp);
+  }
+  FreePool (ConfigAccessHandles);
+  if (ConfigSize == 0) {
+    ConfigSize = sizeof (CHAR16);
+  }
+
+  //
+  // Drop the strings of the driver handles which no longer exist.
+  //
+  FreeConfigRespList (&Private->ConfigRespList);
+  while (!IsListEmpty (&ConfigRespList)) {
+    Link = ConfigRespList.ForwardLink;
+    RemoveEntryList (Link);
+    InsertTailList (&Private->ConfigRespList, Link);
+  }
+
+  if (ConfigSize > gConfigRespSize){
+    //
+    // Do 25% overallocation to minimize the number of memory allocations after ReadyToBoot.
+    // Since lots of allocation after ReadyToBoot may change memory map and cause S4 resume issue.
+    //
+    gConfigRespSize = ConfigSize + (ConfigSize >> 2);
+    if (gRTConfigRespBuffer != NULL){
+      FreePool(gRTConfigRespBuffer);
+      DEBUG ((DEBUG_WARN, "[HiiDatabase]: Memory allocation is required after ReadyToBoot, which may change memory map and cause S4 resume issue.\n"));
+    }
+    gRTConfigRespBuffer = (EFI_STRING) AllocateRuntimeZeroPool (gConfigRespSize);
+    if (gRTConfigRespBuffer == NULL){
+      gConfigRespSize = 0;
+      DEBUG ((DEBUG_ERROR, "[HiiDatabase]: No enough memory resource to store the ConfigResp string.\n"));
+      //
+      // Remove from the System Table when the configuration runtime buffer is freed.
+      //
+      gBS->InstallConfigurationTable (&gEfiHiiConfigRoutingProtocolGuid, NULL);
+      return EFI_OUT_OF_RESOURCES;
+    }
+  } else {
+    ZeroMem(gRTConfigRespBuffer,gConfigRespSize);
   }
 
+  //
+  // Attach each <ConfigAltResp> to a <MultiConfigAltResp>. There is a '&'
+  // which separates the first <ConfigAltResp> and the following ones.
+  //
+  StringPtr    = gRTConfigRespBuffer;
+  FirstElement = TRUE;
+  for (Link = Private->ConfigRespList.ForwardLink; Link != &Private->ConfigRespList; Link = Link->ForwardLink) {
+    ConfigResp = CR (Link, HII_CONFIG_RESP, ConfigRespEntry, HII_CONFIG_RESP_SIGNATURE);
+    if (ConfigResp->ConfigAltResp == NULL) {
+      continue;
+    }
+    if (!FirstElement) {
+      *StringPtr++ = L'&';
+    }
+    CopyMem (StringPtr, ConfigResp->ConfigAltResp, StrLen (ConfigResp->ConfigAltResp) * sizeof (CHAR16));
+    StringPtr   += StrLen (ConfigResp->ConfigAltResp);
+    FirstElement = FALSE;
+  }
+  gBS->InstallConfigurationTable (&gEfiHiiConfigRoutingProtocolGuid, gRTConfigRespBuffer);
+
   return EFI_SUCCESS;
 
 }
@@ -3397,7 +3585,14 @@ HiiGetConfigRespInfo(
 /**
 This is an internal function,mainly use to get HiiDatabase information.
 
+The exported image of each package list is kept at its place in the runtime
+buffer. Only the package list specified by Handle and the package lists which
+have not been exported yet are exported again, the others are moved only when
+the size of a package list before them changes.
+
 @param  This                   A pointer to the EFI_HII_DATABASE_PROTOCOL instance.
+@param  Handle                 The package list that has been added or changed,
+                               or NULL if no package list has been changed.
 
 @retval EFI_SUCCESS            Get the information successfully.
 @retval EFI_OUT_OF_RESOURCES   Not enough memory to store the Hiidatabase data.
@@ -3405,24 +3600,39 @@ This is an internal function,mainly use to get HiiDatabase information.
 **/
 EFI_STATUS
 HiiGetDatabaseInfo(
-  IN CONST EFI_HII_DATABASE_PROTOCOL        *This
+  IN CONST EFI_HII_DATABASE_PROTOCOL        *This,
+  IN EFI_HII_HANDLE                         Handle OPTIONAL
   )
 {
   EFI_STATUS                          Status;
-  EFI_HII_PACKAGE_LIST_HEADER         *DatabaseInfo;
+  HII_DATABASE_PRIVATE_DATA           *Private;
+  LIST_ENTRY                          *Link;
+  HII_DATABASE_RECORD                 *Node;
   UINTN                               DatabaseInfoSize;
+  UINTN                               Offset;
+  UINTN                               UsedSize;
 
-  DatabaseInfo         = NULL;
-  DatabaseInfoSize     = 0;
+  Private = HII_DATABASE_DATABASE_PRIVATE_DATA_FROM_THIS (This);
 
   //
-  // Get HiiDatabase information.
+  // Get the size of the package lists which need to be exported again.
   //
-  Status = HiiExportPackageLists(This, NULL, &DatabaseInfoSize, DatabaseInfo);
-
-  ASSERT(Status == EFI_BUFFER_TOO_SMALL);
+  DatabaseInfoSize = 0;
+  for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
+    Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+    if (Node->Handle == Handle) {
+      Node->ExportUpToDate = FALSE;
+    }
+    if (!Node->ExportUpToDate) {
+      UsedSize = 0;
+      Status = ExportPackageList (Private, Node->Handle, Node->PackageList, &UsedSize, 0, NULL);
+      ASSERT_EFI_ERROR (Status);
+      Node->ExportSize = UsedSize;
+    }
+    DatabaseInfoSize += Node->ExportSize;
+  }
 
-  if(DatabaseInfoSize > gDatabaseInfoSize ) {
+  if(DatabaseInfoSize > gDatabaseInfoSize || gRTDatabaseInfoBuffer == NULL) {
     //
     // Do 25% overallocation to minimize the number of memory allocations after ReadyToBoot.
     // Since lots of allocation after ReadyToBoot may change memory map and cause S4 resume issue.
@@ -3434,6 +3644,7 @@ HiiGetDatabaseInfo(
     }
     gRTDatabaseInfoBuffer = AllocateRuntimeZeroPool (gDatabaseInfoSize);
     if (gRTDatabaseInfoBuffer == NULL){
+      gDatabaseInfoSize = 0;
       DEBUG ((DEBUG_ERROR, "[HiiDatabase]: No enough memory resource to store the HiiDatabase info.\n"));
       //
       // Remove from the System Table when the configuration runtime buffer is freed.
@@ -3441,11 +3652,60 @@ HiiGetDatabaseInfo(
       gBS->InstallConfigurationTable (&gEfiHiiDatabaseProtocolGuid, NULL);
       return EFI_OUT_OF_RESOURCES;
     }
-  } else {
-    ZeroMem(gRTDatabaseInfoBuffer,gDatabaseInfoSize);
+    //
+    // Nothing is kept in the new buffer, all package lists are exported again.
+    //
+    for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
+      Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+      Node->ExportUpToDate = FALSE;
+    }
   }
-  Status = HiiExportPackageLists(This, NULL, &DatabaseInfoSize, gRTDatabaseInfoBuffer);
-  ASSERT_EFI_ERROR (Status);
+
+  //
+  // Move the kept package lists to their new place. The package lists moving
+  // toward the start of the buffer are moved first, in database order, then
+  // the ones moving toward the end, in reverse order, so that no kept package
+  // list is overwritten before it is moved. CopyMem () handles the overlap.
+  //
+  Offset = 0;
+  for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
+    Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+    if (Node->ExportUpToDate && Offset < Node->ExportOffset) {
+      CopyMem ((UINT8 *) gRTDatabaseInfoBuffer + Offset, (UINT8 *) gRTDatabaseInfoBuffer + Node->ExportOffset, Node->ExportSize);
+      Node->ExportOffset = Offset;
+    }
+    Offset += Node->ExportSize;
+  }
+  for (Link = Private->DatabaseList.BackLink; Link != &Private->DatabaseList; Link = Link->BackLink) {
+    Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+    Offset -= Node->ExportSize;
+    if (Node->ExportUpToDate && Offset > Node->ExportOffset) {
+      CopyMem ((UINT8 *) gRTDatabaseInfoBuffer + Offset, (UINT8 *) gRTDatabaseInfoBuffer + Node->ExportOffset, Node->ExportSize);
+    }
+    Node->ExportOffset = Offset;
+  }
+
+  //
+  // Export the package lists which have been added or changed.
+  //
+  for (Link = Private->DatabaseList.ForwardLink; Link != &Private->DatabaseList; Link = Link->ForwardLink) {
+    Node = CR (Link, HII_DATABASE_RECORD, DatabaseEntry, HII_DATABASE_RECORD_SIGNATURE);
+    if (!Node->ExportUpToDate) {
+      UsedSize = Node->ExportOffset;
+      Status = ExportPackageList (
+                 Private,
+                 Node->Handle,
+                 Node->PackageList,
+                 &UsedSize,
+                 DatabaseInfoSize,
+                 (EFI_HII_PACKAGE_LIST_HEADER *) ((UINT8 *) gRTDatabaseInfoBuffer + Node->ExportOffset)
+                 );
+      ASSERT_EFI_ERROR (Status);
+      ASSERT (UsedSize == Node->ExportOffset + Node->ExportSize);
+      Node->ExportUpToDate = TRUE;
+    }
+  }
+  ZeroMem ((UINT8 *) gRTDatabaseInfoBuffer + DatabaseInfoSize, gDatabaseInfoSize - DatabaseInfoSize);
   gBS->InstallConfigurationTable (&gEfiHiiDatabaseProtocolGuid, gRTDatabaseInfoBuffer);
 
   return EFI_SUCCESS;
@@ -3553,7 +3813,7 @@ HiiNewPackageList (
   // Only after ReadyToBoot, need to do the export.
   //
   if (gExportAfterReadyToBoot) {
-    HiiGetDatabaseInfo (This);
+    HiiGetDatabaseInfo (This, *Handle);
   }
   EfiReleaseLock (&mHiiDatabaseLock);
 
@@ -3570,7 +3830,7 @@ HiiNewPackageList (
   // When after ReadyToBoot and need to do the export for form package add.
   //
   if (gExportAfterReadyToBoot && gExportConfigResp) {
-    HiiGetConfigRespInfo (This);
+    HiiGetConfigRespInfo (This, DriverHandle);
   }
 
   return EFI_SUCCESS;
@@ -3606,6 +3866,7 @@ HiiRemovePackageList (
   HII_DATABASE_RECORD                 *Node;
   HII_DATABASE_PACKAGE_LIST_INSTANCE  *PackageList;
   HII_HANDLE                          *HiiHandle;
+  EFI_HANDLE                          DriverHandle;
 
   if (This == NULL) {
     return EFI_INVALID_PARAMETER;
@@ -3684,6 +3945,7 @@ HiiRemovePackageList (
       ASSERT (Private->HiiHandleCount >= 0);
 
       HiiHandle->Signature = 0;
+      DriverHandle = Node->DriverHandle;
       FreePool (HiiHandle);
       FreePool (Node->PackageList);
       FreePool (Node);
@@ -3693,7 +3955,7 @@ HiiRemovePackageList (
       // Only after ReadyToBoot, need to do the export.
       //
       if (gExportAfterReadyToBoot) {
-        HiiGetDatabaseInfo (This);
+        HiiGetDatabaseInfo (This, NULL);
       }
       EfiReleaseLock (&mHiiDatabaseLock);
 
@@ -3711,7 +3973,7 @@ HiiRemovePackageList (
       // When after ReadyToBoot and need to do the export for form package remove.
       //
       if (gExportAfterReadyToBoot && gExportConfigResp) {
-        HiiGetConfigRespInfo (This);
+        HiiGetConfigRespInfo (This, DriverHandle);
       }
       return EFI_SUCCESS;
     }
@@ -3830,7 +4092,7 @@ HiiUpdatePackageList (
       // Only after ReadyToBoot, need to do the export.
       //
       if (gExportAfterReadyToBoot && Status == EFI_SUCCESS) {
-        HiiGetDatabaseInfo (This);
+        HiiGetDatabaseInfo (This, Handle);
       }
       EfiReleaseLock (&mHiiDatabaseLock);
 
@@ -3848,7 +4110,7 @@ HiiUpdatePackageList (
       // When after ReadyToBoot and need to do the export for form package update.
       //
       if (gExportAfterReadyToBoot && gExportConfigResp && Status == EFI_SUCCESS) {
-        HiiGetConfigRespInfo (This);
+        HiiGetConfigRespInfo (This, Node->DriverHandle);
       }
 
       return Status;
@@ -152,6 +152,16 @@ typedef struct {
 // String Package definitions
 //
 #define HII_STRING_PACKAGE_SIGNATURE    SIGNATURE_32 ('h','i','s','p')
+
+//
+// Entry of the string id index of a string package. It records the string
+// block which holds a string id and the first string id of that block.
+//
+typedef struct {
+  UINT32                                BlockOffset;   // offset relative to StringBlock
+  EFI_STRING_ID                         StartStringId;
+} HII_STRING_BLOCK_INDEX;
+
 typedef struct _HII_STRING_PACKAGE_INSTANCE {
   UINTN                                 Signature;
   EFI_HII_STRING_PACKAGE_HDR            *StringPkgHdr;
@@ -160,6 +170,8 @@ typedef struct _HII_STRING_PACKAGE_INSTANCE {
   LIST_ENTRY                            FontInfoList;  // local font info list
   UINT8                                 FontId;
   EFI_STRING_ID                         MaxStringId;   // record StringId
+  HII_STRING_BLOCK_INDEX                *StringIndex;  // built on demand, NULL if not built
+  EFI_STRING_ID                         StringIndexCount;
 } HII_STRING_PACKAGE_INSTANCE;
 
 //
@@ -270,6 +282,11 @@ typedef struct _HII_DATABASE_PACKAGE_LIST_INSTANCE {
   HII_IMAGE_PACKAGE_INSTANCE            *ImagePkg;
   LIST_ENTRY                            SimpleFontPkgHdr;
   UINT8                                 *DevicePathPkg;
+  //
+  // The string package which matched the last language passed to HiiGetString.
+  //
+  CHAR8                                 *LastLanguage;
+  HII_STRING_PACKAGE_INSTANCE           *LastStringPkg;
 } HII_DATABASE_PACKAGE_LIST_INSTANCE;
 
 #define HII_HANDLE_SIGNATURE            SIGNATURE_32 ('h','i','h','l')
@@ -288,6 +305,13 @@ typedef struct _HII_DATABASE_RECORD {
   EFI_HANDLE                            DriverHandle;
   EFI_HII_HANDLE                        Handle;
   LIST_ENTRY                            DatabaseEntry;
+  //
+  // Location of this package list in the HII database image exported for
+  // runtime use after ReadyToBoot, and whether that image is still current.
+  //
+  UINTN                                 ExportOffset;
+  UINTN                                 ExportSize;
+  BOOLEAN                               ExportUpToDate;
 } HII_DATABASE_RECORD;
 
 #define HII_DATABASE_NOTIFY_SIGNATURE   SIGNATURE_32 ('h','i','d','n')
@@ -302,6 +326,19 @@ typedef struct _HII_DATABASE_NOTIFY {
   LIST_ENTRY                            DatabaseNotifyEntry;
 } HII_DATABASE_NOTIFY;
 
+#define HII_CONFIG_RESP_SIGNATURE       SIGNATURE_32 ('h','i','c','r')
+
+//
+// <ConfigAltResp> of one driver handle with the EFI_HII_CONFIG_ACCESS_PROTOCOL,
+// kept to build the ConfigResp string exported for runtime use after ReadyToBoot.
+//
+typedef struct _HII_CONFIG_RESP {
+  UINTN                                 Signature;
+  EFI_HANDLE                            ConfigAccessHandle;
+  EFI_STRING                            ConfigAltResp;  // NULL if the driver returned no configuration
+  LIST_ENTRY                            ConfigRespEntry;
+} HII_CONFIG_RESP;
+
 #define HII_DATABASE_PRIVATE_DATA_SIGNATURE SIGNATURE_32 ('H', 'i', 'D', 'p')
 
 typedef struct _HII_DATABASE_PRIVATE_DATA {
@@ -321,6 +358,7 @@ typedef struct _HII_DATABASE_PRIVATE_DATA {
   UINTN                                 Attribute;     // default system color
   EFI_GUID                              CurrentLayoutGuid;
   EFI_HII_KEYBOARD_LAYOUT               *CurrentLayout;
+  LIST_ENTRY                            ConfigRespList;
 } HII_DATABASE_PRIVATE_DATA;
 
 #define HII_FONT_DATABASE_PRIVATE_DATA_FROM_THIS(a) \
@@ -540,6 +578,19 @@ FindStringBlock (
   );
 
 
+/**
+  Release the string id index of a string package. It must be called whenever
+  the string blocks of the package are changed.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  );
+
+
 /**
   Parse all glyph blocks to find a glyph block specified by CharValue.
   If CharValue = (CHAR16) (-1), collect all default character cell information
@@ -2318,7 +2369,12 @@ GetSupportedLanguages (
 /**
 This function mainly use to get HiiDatabase information.
 
+Only the package list specified by Handle and package lists that have not been
+exported yet are exported again, the others are kept in the runtime buffer.
+
 @param  This                   A pointer to the EFI_HII_DATABASE_PROTOCOL instance.
+@param  Handle                 The package list that has been added or changed,
+                               or NULL if no package list has been changed.
 
 @retval EFI_SUCCESS            Get the information successfully.
 @retval EFI_OUT_OF_RESOURCES   Not enough memory to store the Hiidatabase data.
@@ -2326,13 +2382,20 @@ This function mainly use to get HiiDatabase information.
 **/
 EFI_STATUS
 HiiGetDatabaseInfo (
-  IN CONST EFI_HII_DATABASE_PROTOCOL        *This
+  IN CONST EFI_HII_DATABASE_PROTOCOL        *This,
+  IN EFI_HII_HANDLE                         Handle OPTIONAL
   );
 
 /**
 This function mainly use to get and update ConfigResp string.
 
+Only the configuration of the driver handle specified by DriverHandle and of
+driver handles that have not been exported yet is extracted again.
+
 @param  This                   A pointer to the EFI_HII_DATABASE_PROTOCOL instance.
+@param  DriverHandle           The driver handle whose form packages have been
+                               changed, or NULL to extract the configuration of
+                               all driver handles.
 
 @retval EFI_SUCCESS            Get the information successfully.
 @retval EFI_OUT_OF_RESOURCES   Not enough memory to store the Configuration Setting data.
@@ -2340,7 +2403,33 @@ This function mainly use to get and update ConfigResp string.
 **/
 EFI_STATUS
 HiiGetConfigRespInfo (
-  IN CONST EFI_HII_DATABASE_PROTOCOL        *This
+  IN CONST EFI_HII_DATABASE_PROTOCOL        *This,
+  IN EFI_HANDLE                             DriverHandle OPTIONAL
+  );
+
+/**
+  This function gets the <ConfigAltResp> of one driver handle which installs
+  the EFI_HII_CONFIG_ACCESS_PROTOCOL. The default settings from the IFR of the
+  HII package list that shares the device path of the handle are merged into
+  the settings returned by the driver.
+
+  @param  Private                Hii database private structure.
+  @param  ConfigAccessHandle     The driver handle with the
+                                 EFI_HII_CONFIG_ACCESS_PROTOCOL.
+  @param  AccessResults          Null-terminated Unicode string in
+                                 <ConfigAltResp> format. String to be allocated
+                                 by the called function. De-allocation is up to
+                                 the caller.
+
+  @retval EFI_SUCCESS            The AccessResults string is filled.
+  @retval Others                 The driver returned no configuration.
+
+**/
+EFI_STATUS
+ExportConfigFromHandle (
+  IN  HII_DATABASE_PRIVATE_DATA              *Private,
+  IN  EFI_HANDLE                             ConfigAccessHandle,
+  OUT EFI_STRING                             *AccessResults
   );
 
 //
@@ -95,7 +95,11 @@ HII_DATABASE_PRIVATE_DATA mPrivate = {
     0x0000,
     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}
   },
-  NULL
+  NULL,
+  {
+    (LIST_ENTRY *) NULL,
+    (LIST_ENTRY *) NULL
+  }
 };
 
 /**
@@ -138,8 +142,8 @@ OnReadyToBoot (
   // When ready to boot, we begin to export the HiiDatabase date.
   // And hook all the possible HiiDatabase change actions to export data.
   //
-  HiiGetDatabaseInfo (&mPrivate.HiiDatabase);
-  HiiGetConfigRespInfo (&mPrivate.HiiDatabase);
+  HiiGetDatabaseInfo (&mPrivate.HiiDatabase, NULL);
+  HiiGetConfigRespInfo (&mPrivate.HiiDatabase, NULL);
   gExportAfterReadyToBoot = TRUE;
 
   gBS->CloseEvent (Event);
@@ -188,6 +192,7 @@ InitializeHiiDatabase (
   InitializeListHead (&mPrivate.DatabaseNotifyList);
   InitializeListHead (&mPrivate.HiiHandleList);
   InitializeListHead (&mPrivate.FontInfoList);
+  InitializeListHead (&mPrivate.ConfigRespList);
 
   //
   // Create a event with EFI_HII_SET_KEYBOARD_LAYOUT_EVENT_GUID group type.
@@ -227,6 +227,232 @@ GetStringFontInfo (
 }
 
 
+/**
+  Release the string id index of a string package. It must be called whenever
+  the string blocks of the package are changed.
+
+  @param  StringPackage           Hii string package instance.
+
+**/
+VOID
+InvalidateStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  if (StringPackage->StringIndex != NULL) {
+    FreePool (StringPackage->StringIndex);
+    StringPackage->StringIndex = NULL;
+  }
+  StringPackage->StringIndexCount = 0;
+}
+
+
+/**
+  Parse all string blocks once and record, for each string id, the string block
+  which holds it together with the first string id of that block.
+
+  This is a internal function.
+
+  @param  StringPackage           Hii string package instance.
+
+  @retval EFI_SUCCESS             The string id index is built successfully.
+  @retval EFI_NOT_FOUND           The string blocks can not be indexed.
+  @retval EFI_OUT_OF_RESOURCES    The system is out of resources to accomplish the
+                                  task.
+
+**/
+EFI_STATUS
+BuildStringIndex (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage
+  )
+{
+  HII_STRING_BLOCK_INDEX               *StringIndex;
+  UINT8                                *BlockHdr;
+  UINTN                                BlockSize;
+  UINTN                                Index;
+  UINTN                                CurrentStringId;
+  UINTN                                BlockStartId;
+  UINT8                                *StringTextPtr;
+  UINT16                               StringCount;
+  UINT8                                Length8;
+  UINT32                               Length32;
+  EFI_HII_SIBT_EXT2_BLOCK              Ext2;
+  UINTN                                StringSize;
+
+  if (StringPackage->MaxStringId == 0) {
+    return EFI_NOT_FOUND;
+  }
+
+  StringIndex = AllocatePool (StringPackage->MaxStringId * sizeof (HII_STRING_BLOCK_INDEX));
+  if (StringIndex == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  CurrentStringId = 1;
+  StringSize      = 0;
+  BlockSize       = 0;
+  BlockHdr        = StringPackage->StringBlock;
+  while (*BlockHdr != EFI_HII_SIBT_END) {
+    StringCount = 0;
+    switch (*BlockHdr) {
+    case EFI_HII_SIBT_STRING_SCSU:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      BlockSize += StringTextPtr - BlockHdr + AsciiStrSize ((CHAR8 *) StringTextPtr);
+      StringCount = 1;
+      break;
+
+    case EFI_HII_SIBT_STRING_SCSU_FONT:
+      StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      BlockSize += StringTextPtr - BlockHdr + AsciiStrSize ((CHAR8 *) StringTextPtr);
+      StringCount = 1;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_SCSU:
+    case EFI_HII_SIBT_STRINGS_SCSU_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_SCSU) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_BLOCK) - sizeof (UINT8);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_SCSU_FONT_BLOCK) - sizeof (UINT8);
+      }
+      BlockSize += StringTextPtr - BlockHdr;
+      for (Index = 0; Index < StringCount; Index++) {
+        BlockSize += AsciiStrSize ((CHAR8 *) StringTextPtr);
+        StringTextPtr = StringTextPtr + AsciiStrSize ((CHAR8 *) StringTextPtr);
+      }
+      break;
+
+    case EFI_HII_SIBT_STRING_UCS2:
+    case EFI_HII_SIBT_STRING_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRING_UCS2) {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_STRING_BLOCK);
+      } else {
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRING_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+      BlockSize += StringTextPtr - BlockHdr + StringSize;
+      StringCount = 1;
+      break;
+
+    case EFI_HII_SIBT_STRINGS_UCS2:
+    case EFI_HII_SIBT_STRINGS_UCS2_FONT:
+      if (*BlockHdr == EFI_HII_SIBT_STRINGS_UCS2) {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_BLOCK) - sizeof (CHAR16);
+      } else {
+        CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8), sizeof (UINT16));
+        StringTextPtr = BlockHdr + sizeof (EFI_HII_SIBT_STRINGS_UCS2_FONT_BLOCK) - sizeof (CHAR16);
+      }
+      BlockSize += StringTextPtr - BlockHdr;
+      for (Index = 0; Index < StringCount; Index++) {
+        GetUnicodeStringTextOrSize (NULL, StringTextPtr, &StringSize);
+        BlockSize += StringSize;
+        StringTextPtr = StringTextPtr + StringSize;
+      }
+      break;
+
+    case EFI_HII_SIBT_DUPLICATE:
+      BlockSize += sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
+      StringCount = 1;
+      break;
+
+    case EFI_HII_SIBT_SKIP1:
+      StringCount = (UINT16) (*(UINT8*)((UINTN)BlockHdr + sizeof (EFI_HII_STRING_BLOCK)));
+      BlockSize  += sizeof (EFI_HII_SIBT_SKIP1_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_SKIP2:
+      CopyMem (&StringCount, BlockHdr + sizeof (EFI_HII_STRING_BLOCK), sizeof (UINT16));
+      BlockSize += sizeof (EFI_HII_SIBT_SKIP2_BLOCK);
+      break;
+
+    case EFI_HII_SIBT_EXT1:
+      CopyMem (
+        &Length8,
+        (UINT8*)((UINTN)BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8)),
+        sizeof (UINT8)
+        );
+      BlockSize += Length8;
+      break;
+
+    case EFI_HII_SIBT_EXT2:
+      CopyMem (&Ext2, BlockHdr, sizeof (EFI_HII_SIBT_EXT2_BLOCK));
+      BlockSize += Ext2.Length;
+      break;
+
+    case EFI_HII_SIBT_EXT4:
+      CopyMem (
+        &Length32,
+        (UINT8*)((UINTN)BlockHdr + sizeof (EFI_HII_STRING_BLOCK) + sizeof (UINT8)),
+        sizeof (UINT32)
+        );
+      BlockSize += Length32;
+      break;
+
+    default:
+      //
+      // Leave the unknown block to the linear search in FindStringBlock.
+      //
+      FreePool (StringIndex);
+      return EFI_NOT_FOUND;
+    }
+
+    BlockStartId = CurrentStringId;
+    for (Index = 0; Index < StringCount && CurrentStringId <= StringPackage->MaxStringId; Index++) {
+      StringIndex[CurrentStringId - 1].BlockOffset   = (UINT32) (BlockHdr - StringPackage->StringBlock);
+      StringIndex[CurrentStringId - 1].StartStringId = (EFI_STRING_ID) BlockStartId;
+      CurrentStringId++;
+    }
+    BlockHdr = StringPackage->StringBlock + BlockSize;
+  }
+
+  StringPackage->StringIndex      = StringIndex;
+  StringPackage->StringIndexCount = (EFI_STRING_ID) (CurrentStringId - 1);
+  return EFI_SUCCESS;
+}
+
+
+/**
+  Get the position from where FindStringBlock starts to search StringId. The
+  string id index of the string package is built on first use.
+
+  This is a internal function.
+
+  @param  StringPackage           Hii string package instance.
+  @param  StringId                The string's id, which is unique within
+                                  PackageList.
+  @param  BlockSize               Output the offset of the string block which
+                                  holds StringId, relative to StringBlock.
+  @param  CurrentStringId         Output the first string id of that block.
+
+**/
+VOID
+SeekStringBlock (
+  IN OUT HII_STRING_PACKAGE_INSTANCE  *StringPackage,
+  IN     EFI_STRING_ID                StringId,
+  OUT    UINTN                        *BlockSize,
+  OUT    EFI_STRING_ID                *CurrentStringId
+  )
+{
+  if (StringPackage->StringIndex == NULL) {
+    BuildStringIndex (StringPackage);
+  }
+
+  if (StringPackage->StringIndex == NULL || StringId > StringPackage->StringIndexCount) {
+    //
+    // Fall back to search from the first string block.
+    //
+    *BlockSize       = 0;
+    *CurrentStringId = 1;
+    return;
+  }
+
+  *BlockSize       = StringPackage->StringIndex[StringId - 1].BlockOffset;
+  *CurrentStringId = StringPackage->StringIndex[StringId - 1].StartStringId;
+}
+
+
 /**
   Parse all string blocks to find a String block specified by StringId.
   If StringId = (EFI_STRING_ID) (-1), find out all EFI_HII_SIBT_FONT blocks
@@ -308,11 +534,18 @@ FindStringBlock (
   ZeroMem (&Zero, sizeof (CHAR16));
 
   //
-  // Parse the string blocks to get the string text and font.
+  // Parse the string blocks to get the string text and font. A normal string id
+  // is searched from the string block which holds it.
   //
-  BlockHdr  = StringPackage->StringBlock;
   BlockSize = 0;
   Offset    = 0;
+  if (StringId != (EFI_STRING_ID) (-1) && StringId != 0) {
+    SeekStringBlock (StringPackage, StringId, &BlockSize, &CurrentStringId);
+    if (BlockSize != 0 && StartStringId != NULL) {
+      *StartStringId = CurrentStringId;
+    }
+  }
+  BlockHdr  = StringPackage->StringBlock + BlockSize;
   while (*BlockHdr != EFI_HII_SIBT_END) {
     switch (*BlockHdr) {
     case EFI_HII_SIBT_STRING_SCSU:
@@ -452,8 +685,7 @@ FindStringBlock (
           sizeof (EFI_STRING_ID)
           );
         ASSERT (StringId != CurrentStringId);
-        CurrentStringId = 1;
-        BlockSize       = 0;
+        SeekStringBlock (StringPackage, StringId, &BlockSize, &CurrentStringId);
       } else {
         BlockSize       += sizeof (EFI_HII_SIBT_DUPLICATE_BLOCK);
         CurrentStringId++;
@@ -841,6 +1073,7 @@ InsertLackStringBlock (
   }
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = StringBlock;
+  InvalidateStringIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += NewBlockSize - OldBlockSize;
 
   return EFI_SUCCESS;
@@ -1009,6 +1242,7 @@ SetStringWorker (
     ZeroMem (StringPackage->StringBlock, OldBlockSize);
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1043,6 +1277,7 @@ SetStringWorker (
     ZeroMem (StringPackage->StringBlock, OldBlockSize);
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = Block;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += (UINT32) (BlockSize - OldBlockSize);
     break;
 
@@ -1095,6 +1330,7 @@ SetStringWorker (
   ZeroMem (StringPackage->StringBlock, OldBlockSize);
   FreePool (StringPackage->StringBlock);
   StringPackage->StringBlock = Block;
+  InvalidateStringIndex (StringPackage);
   StringPackage->StringPkgHdr->Header.Length += Ext2.Length;
 
   return EFI_SUCCESS;
@@ -1281,6 +1517,7 @@ HiiNewString (
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
     }
@@ -1413,6 +1650,7 @@ HiiNewString (
     ZeroMem (StringPackage->StringBlock, OldBlockSize);
     FreePool (StringPackage->StringBlock);
     StringPackage->StringBlock = StringBlock;
+    InvalidateStringIndex (StringPackage);
     StringPackage->StringPkgHdr->Header.Length += Ucs2BlockSize;
     PackageListNode->PackageListHdr.PackageLength += Ucs2BlockSize;
 
@@ -1456,6 +1694,7 @@ HiiNewString (
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += Ucs2FontBlockSize;
 
@@ -1518,6 +1757,7 @@ HiiNewString (
       ZeroMem (StringPackage->StringBlock, OldBlockSize);
       FreePool (StringPackage->StringBlock);
       StringPackage->StringBlock = StringBlock;
+      InvalidateStringIndex (StringPackage);
       StringPackage->StringPkgHdr->Header.Length += FontBlockSize + Ucs2FontBlockSize;
       PackageListNode->PackageListHdr.PackageLength += FontBlockSize + Ucs2FontBlockSize;
 
@@ -1572,7 +1812,7 @@ Done:
   //
   if (gExportAfterReadyToBoot) {
     if (!EFI_ERROR (Status)) {
-      HiiGetDatabaseInfo(&Private->HiiDatabase);
+      HiiGetDatabaseInfo(&Private->HiiDatabase, PackageList);
     }
   }
 
@@ -1582,6 +1822,40 @@ Done:
 }
 
 
+/**
+  Remember the string package which matches Language in a package list, so that
+  HiiGetString does not need to compare the languages of all string packages
+  again for the same language.
+
+  This is a internal function.
+
+  @param  PackageList            The package list which holds StringPackage.
+  @param  Language               Points to the language which StringPackage matches.
+  @param  StringPackage          HII string package instance.
+
+**/
+VOID
+CacheStringPackage (
+  IN OUT HII_DATABASE_PACKAGE_LIST_INSTANCE  *PackageList,
+  IN     CONST CHAR8                         *Language,
+  IN     HII_STRING_PACKAGE_INSTANCE         *StringPackage
+  )
+{
+  CHAR8                               *LastLanguage;
+
+  LastLanguage = AllocateCopyPool (AsciiStrSize (Language), Language);
+  if (LastLanguage == NULL) {
+    return;
+  }
+
+  if (PackageList->LastLanguage != NULL) {
+    FreePool (PackageList->LastLanguage);
+  }
+  PackageList->LastLanguage  = LastLanguage;
+  PackageList->LastStringPkg = StringPackage;
+}
+
+
 /**
   This function retrieves the string specified by StringId which is associated
   with the specified PackageList in the language Language and copies it into
@@ -1660,19 +1934,29 @@ HiiGetString (
   if (PackageListNode != NULL) {
     //
     // First search: to match the StringId in the specified language.
+    // A package list holds at most one string package per language, so the
+    // package matched by the last language can be used directly.
     //
-    for (Link =  PackageListNode->StringPkgHdr.ForwardLink;
-         Link != &PackageListNode->StringPkgHdr;
-         Link =  Link->ForwardLink
-        ) {
+    if (PackageListNode->LastLanguage != NULL && AsciiStrCmp (PackageListNode->LastLanguage, Language) == 0) {
+      Status = GetStringWorker (Private, PackageListNode->LastStringPkg, StringId, String, StringSize, StringFontInfo);
+      if (Status != EFI_NOT_FOUND) {
+        return Status;
+      }
+    } else {
+      for (Link =  PackageListNode->StringPkgHdr.ForwardLink;
+           Link != &PackageListNode->StringPkgHdr;
+           Link =  Link->ForwardLink
+          ) {
         StringPackage = CR (Link, HII_STRING_PACKAGE_INSTANCE, StringEntry, HII_STRING_PACKAGE_SIGNATURE);
         if (HiiCompareLanguage (StringPackage->StringPkgHdr->Language, (CHAR8 *) Language)) {
+          CacheStringPackage (PackageListNode, Language, StringPackage);
           Status = GetStringWorker (Private, StringPackage, StringId, String, StringSize, StringFontInfo);
           if (Status != EFI_NOT_FOUND) {
             return Status;
           }
         }
       }
+    }
       //
       // Second search: to match the StringId in other available languages if exist.
       //
@@ -1780,7 +2064,7 @@ HiiSetString (
         // Only after ReadyToBoot to do the export.
         //
         if (gExportAfterReadyToBoot) {
-          HiiGetDatabaseInfo(&Private->HiiDatabase);
+          HiiGetDatabaseInfo(&Private->HiiDatabase, PackageList);
         }
         EfiReleaseLock (&mHiiDatabaseLock);
         return EFI_SUCCESS;
@@ -326,10 +326,6 @@ WriteMemory (
   IN  UINT64                       Size
   )
 {
-  EFI_PHYSICAL_ADDRESS  Address;
-
-  Address = Start;
-
   //
   // Add 4G memory address check for IA32 platform
   // NOTE: Without page table, there is no way to use memory above 4G.
@@ -338,10 +334,8 @@ WriteMemory (
     return EFI_SUCCESS;
   }
 
-  while (Address < (Start + Size)) {
-    CopyMem ((VOID *) (UINTN) Address, Private->MonoPattern, Private->MonoTestSize);
-    Address += Private->CoverageSpan;
-  }
+  FillMemoryPattern (Private, Start, Size);
+
   //
   // bug bug: we may need GCD service to make the code cache and data uncache,
   // if GCD do not support it or return fail, then just flush the whole cache.
@@ -353,6 +347,118 @@ WriteMemory (
   return EFI_SUCCESS;
 }
 
+/**
+  Write the memory test pattern into a range of physical memory without
+  flushing the cache.
+
+  This function does not use any UEFI service, so it may run on an AP.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+  @param[in] Start    The memory range's start address.
+  @param[in] Size     The memory range's size.
+
+**/
+VOID
+FillMemoryPattern (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size
+  )
+{
+  EFI_PHYSICAL_ADDRESS  Address;
+
+  Address = Start;
+  while (Address < (Start + Size)) {
+    CopyMem ((VOID *) (UINTN) Address, Private->MonoPattern, Private->MonoTestSize);
+    Address += Private->CoverageSpan;
+  }
+}
+
+/**
+  Compare the range of physical memory with the memory test pattern.
+
+  This function does not use any UEFI service, so it may run on an AP.
+
+  @param[in]  Private       Point to generic memory test driver's private data.
+  @param[in]  Start         The memory range's start address.
+  @param[in]  Size          The memory range's size.
+  @param[out] ErrorAddress  The address of the first miscompare found.
+
+  @retval TRUE   The whole range matches the memory test pattern.
+  @retval FALSE  A miscompare was found at ErrorAddress.
+
+**/
+BOOLEAN
+CompareMemoryPattern (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size,
+  OUT EFI_PHYSICAL_ADDRESS         *ErrorAddress
+  )
+{
+  EFI_PHYSICAL_ADDRESS  Address;
+
+  Address = Start;
+  while (Address < (Start + Size)) {
+    if (CompareMemWithoutCheckArgument (
+          (VOID *) (UINTN) (Address),
+          Private->MonoPattern,
+          Private->MonoTestSize
+          ) != 0) {
+      *ErrorAddress = Address;
+      return FALSE;
+    }
+    Address += Private->CoverageSpan;
+  }
+
+  return TRUE;
+}
+
+/**
+  Report an uncorrectable memory error found by the memory test.
+
+  @param[in] Address  The address of the memory error.
+
+  @retval EFI_DEVICE_ERROR      The memory error was reported.
+  @retval EFI_OUT_OF_RESOURCES  No memory to build the error data.
+
+**/
+EFI_STATUS
+ReportMemoryError (
+  IN  EFI_PHYSICAL_ADDRESS         Address
+  )
+{
+  EFI_MEMORY_EXTENDED_ERROR_DATA  *ExtendedErrorData;
+
+  //
+  // Report uncorrectable errors
+  //
+  ExtendedErrorData = AllocateZeroPool (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA));
+  if (ExtendedErrorData == NULL) {
+    return EFI_OUT_OF_RESOURCES;
+  }
+
+  ExtendedErrorData->DataHeader.HeaderSize  = (UINT16) sizeof (EFI_STATUS_CODE_DATA);
+  ExtendedErrorData->DataHeader.Size        = (UINT16) (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA) - sizeof (EFI_STATUS_CODE_DATA));
+  ExtendedErrorData->Granularity            = EFI_MEMORY_ERROR_DEVICE;
+  ExtendedErrorData->Operation              = EFI_MEMORY_OPERATION_READ;
+  ExtendedErrorData->Syndrome               = 0x0;
+  ExtendedErrorData->Address                = Address;
+  ExtendedErrorData->Resolution             = 0x40;
+
+  REPORT_STATUS_CODE_EX (
+      EFI_ERROR_CODE,
+      EFI_COMPUTING_UNIT_MEMORY | EFI_CU_MEMORY_EC_UNCORRECTABLE,
+      0,
+      &gEfiGenericMemTestProtocolGuid,
+      NULL,
+      (UINT8 *) ExtendedErrorData + sizeof (EFI_STATUS_CODE_DATA),
+      ExtendedErrorData->DataHeader.Size
+      );
+
+  return EFI_DEVICE_ERROR;
+}
+
 /**
   Verify the range of physical memory which covered by memory test pattern.
 
@@ -374,12 +480,7 @@ VerifyMemory (
   IN  UINT64                       Size
   )
 {
-  EFI_PHYSICAL_ADDRESS            Address;
-  INTN                            ErrorFound;
-  EFI_MEMORY_EXTENDED_ERROR_DATA  *ExtendedErrorData;
-
-  Address           = Start;
-  ExtendedErrorData = NULL;
+  EFI_PHYSICAL_ADDRESS            ErrorAddress;
 
   //
   // Add 4G memory address check for IA32 platform
@@ -394,43 +495,145 @@ VerifyMemory (
   // error here. If there is miscompare error here then check if generic
   // memory test driver can disable the bad DIMM.
   //
-  while (Address < (Start + Size)) {
-    ErrorFound = CompareMemWithoutCheckArgument (
-                  (VOID *) (UINTN) (Address),
-                  Private->MonoPattern,
-                  Private->MonoTestSize
-                  );
-    if (ErrorFound != 0) {
-      //
-      // Report uncorrectable errors
-      //
-      ExtendedErrorData = AllocateZeroPool (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA));
-      if (ExtendedErrorData == NULL) {
-        return EFI_OUT_OF_RESOURCES;
-      }
+  if (!CompareMemoryPattern (Private, Start, Size, &ErrorAddress)) {
+    return ReportMemoryError (ErrorAddress);
+  }
 
-      ExtendedErrorData->DataHeader.HeaderSize  = (UINT16) sizeof (EFI_STATUS_CODE_DATA);
-      ExtendedErrorData->DataHeader.Size        = (UINT16) (sizeof (EFI_MEMORY_EXTENDED_ERROR_DATA) - sizeof (EFI_STATUS_CODE_DATA));
-      ExtendedErrorData->Granularity            = EFI_MEMORY_ERROR_DEVICE;
-      ExtendedErrorData->Operation              = EFI_MEMORY_OPERATION_READ;
-      ExtendedErrorData->Syndrome               = 0x0;
-      ExtendedErrorData->Address                = Address;
-      ExtendedErrorData->Resolution             = 0x40;
+  return EFI_SUCCESS;
+}
 
-      REPORT_STATUS_CODE_EX (
-          EFI_ERROR_CODE,
-          EFI_COMPUTING_UNIT_MEMORY | EFI_CU_MEMORY_EC_UNCORRECTABLE,
-          0,
-          &gEfiGenericMemTestProtocolGuid,
-          NULL,
-          (UINT8 *) ExtendedErrorData + sizeof (EFI_STATUS_CODE_DATA),
-          ExtendedErrorData->DataHeader.Size
-          );
+/**
+  AP procedure testing the chunks of a memory block.
+
+  Every processor claims the next untested chunk until all chunks are
+  tested or a memory error has been found by any processor.
 
-      return EFI_DEVICE_ERROR;
+  @param[in, out] Buffer  Pointer to MEMORY_TEST_MP_CONTEXT.
+
+**/
+VOID
+EFIAPI
+MemoryTestApProcedure (
+  IN OUT VOID  *Buffer
+  )
+{
+  MEMORY_TEST_MP_CONTEXT  *Context;
+  UINT32                  Index;
+  EFI_PHYSICAL_ADDRESS    ChunkStart;
+  UINT64                  ChunkLength;
+  EFI_PHYSICAL_ADDRESS    ErrorAddress;
+
+  Context = (MEMORY_TEST_MP_CONTEXT *) Buffer;
+
+  while (Context->ErrorAddress == MAX_UINT64) {
+    Index = InterlockedIncrement (&Context->NextChunk) - 1;
+    if (Index >= Context->NumberOfChunks) {
+      break;
     }
 
-    Address += Private->CoverageSpan;
+    ChunkStart  = Context->Start + MultU64x32 (Context->ChunkSize, Index);
+    ChunkLength = MIN (Context->ChunkSize, Context->Start + Context->Length - ChunkStart);
+
+    FillMemoryPattern (Context->Private, ChunkStart, ChunkLength);
+    //
+    // CPU arch protocol can not be used on an AP, flush the cache directly.
+    //
+    WriteBackInvalidateDataCache ();
+
+    if (!CompareMemoryPattern (Context->Private, ChunkStart, ChunkLength, &ErrorAddress)) {
+      InterlockedCompareExchange64 (&Context->ErrorAddress, MAX_UINT64, ErrorAddress);
+    }
+  }
+}
+
+/**
+  Write and verify the memory test pattern over a range of physical memory,
+  using all the enabled processors.
+
+  The range is cut into BdsBlockSize chunks that are tested by the APs and
+  the BSP at the same time, each processor doing the write, cache flush and
+  verify of its own chunks. If the APs can not be started, the range is
+  tested on the BSP.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+  @param[in] Start    The memory range's start address.
+  @param[in] Size     The memory range's size.
+
+  @retval EFI_SUCCESS       No error found in the range of memory.
+  @retval EFI_DEVICE_ERROR  The range of memory have errors contained.
+  @retval Others            Failed to report the memory error.
+
+**/
+EFI_STATUS
+ParallelRangeTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size
+  )
+{
+  EFI_STATUS              Status;
+  MEMORY_TEST_MP_CONTEXT  Context;
+  EFI_EVENT               WaitEvent;
+  UINTN                   Index;
+
+  //
+  // Add 4G memory address check for IA32 platform
+  // NOTE: Without page table, there is no way to use memory above 4G.
+  //
+  if (Start + Size > MAX_ADDRESS) {
+    return EFI_SUCCESS;
+  }
+
+  if (Private->Mp == NULL || Private->NumberOfEnabledProcessors <= 1) {
+    WriteMemory (Private, Start, Size);
+    return VerifyMemory (Private, Start, Size);
+  }
+
+  Context.Private        = Private;
+  Context.Start          = Start;
+  Context.Length         = Size;
+  Context.ChunkSize      = Private->BdsBlockSize;
+  Context.NumberOfChunks = (UINT32) DivU64x64Remainder (Size + Private->BdsBlockSize - 1, Private->BdsBlockSize, NULL);
+  Context.NextChunk      = 0;
+  Context.ErrorAddress   = MAX_UINT64;
+
+  //
+  // Start the APs in non-blocking mode, so that the BSP tests chunks too.
+  //
+  Status = gBS->CreateEvent (0, TPL_CALLBACK, NULL, NULL, &WaitEvent);
+  if (!EFI_ERROR (Status)) {
+    Status = Private->Mp->StartupAllAPs (
+                            Private->Mp,
+                            MemoryTestApProcedure,
+                            FALSE,
+                            WaitEvent,
+                            0,
+                            &Context,
+                            NULL
+                            );
+    if (EFI_ERROR (Status)) {
+      gBS->CloseEvent (WaitEvent);
+    }
+  }
+  if (EFI_ERROR (Status)) {
+    DEBUG ((DEBUG_WARN, "%a: StartupAllAPs - %r, test on BSP\n", __FUNCTION__, Status));
+  }
+
+  //
+  // Test chunks along with the APs (all of them if the APs were not started).
+  //
+  MemoryTestApProcedure (&Context);
+
+  //
+  // The context is on the stack, so wait for the APs to be done with it.
+  //
+  if (!EFI_ERROR (Status)) {
+    gBS->WaitForEvent (1, &WaitEvent, &Index);
+    gBS->CloseEvent (WaitEvent);
+  }
+
+  if (Context.ErrorAddress != MAX_UINT64) {
+    return ReportMemoryError (Context.ErrorAddress);
   }
 
   return EFI_SUCCESS;
@@ -458,6 +661,9 @@ InitializeMemoryTest (
   EFI_STATUS                  Status;
   GENERIC_MEMORY_TEST_PRIVATE *Private;
   EFI_CPU_ARCH_PROTOCOL       *Cpu;
+  EFI_MP_SERVICES_PROTOCOL    *Mp;
+  UINTN                       NumberOfProcessors;
+  UINTN                       NumberOfEnabledProcessors;
 
   Private             = GENERIC_MEMORY_TEST_PRIVATE_FROM_THIS (This);
   *RequireSoftECCInit = FALSE;
@@ -492,6 +698,26 @@ InitializeMemoryTest (
   if (!EFI_ERROR (Status)) {
     Private->Cpu = Cpu;
   }
+
+  //
+  // get the MP services protocol to test memory on all the processors
+  //
+  Private->Mp                        = NULL;
+  Private->NumberOfEnabledProcessors = 1;
+  Status = gBS->LocateProtocol (
+                  &gEfiMpServiceProtocolGuid,
+                  NULL,
+                  (VOID **) &Mp
+                  );
+  if (!EFI_ERROR (Status)) {
+    Status = Mp->GetNumberOfProcessors (Mp, &NumberOfProcessors, &NumberOfEnabledProcessors);
+    if (!EFI_ERROR (Status) && NumberOfEnabledProcessors > 1) {
+      Private->Mp                        = Mp;
+      Private->NumberOfEnabledProcessors = NumberOfEnabledProcessors;
+    }
+  }
+  DEBUG ((DEBUG_INFO, "Generic memory test runs on %Lu processor(s)\n", (UINT64) Private->NumberOfEnabledProcessors));
+
   //
   // Create the CoverageSpan of the memory test base on the coverage level
   //
@@ -561,20 +787,31 @@ GenPerformMemoryTest (
   GENERIC_MEMORY_TEST_PRIVATE     *Private;
   EFI_MEMORY_RANGE_EXTENDED_DATA  *RangeData;
   UINT64                          BlockBoundary;
+  UINT64                          BlockSize;
 
   Private       = GENERIC_MEMORY_TEST_PRIVATE_FROM_THIS (This);
   *ErrorOut     = FALSE;
   RangeData     = NULL;
   BlockBoundary = 0;
 
+  //
+  // With MP services every call tests one BDS block per AP, so the test
+  // scales with the number of processors while BDS still gets progress
+  // after every call.
+  //
+  BlockSize = Private->BdsBlockSize;
+  if (Private->Mp != NULL) {
+    BlockSize = MultU64x32 (Private->BdsBlockSize, (UINT32) (Private->NumberOfEnabledProcessors - 1));
+  }
+
   //
   // In extensive mode the boundary of "mCurrentRange->Length" may will lost
   // some range that is not Private->BdsBlockSize size boundary, so need
   // the software mechanism to confirm all memory location be covered.
   //
   if (mCurrentAddress < (mCurrentRange->StartAddress + mCurrentRange->Length)) {
-    if ((mCurrentAddress + Private->BdsBlockSize) <= (mCurrentRange->StartAddress + mCurrentRange->Length)) {
-      BlockBoundary = Private->BdsBlockSize;
+    if ((mCurrentAddress + BlockSize) <= (mCurrentRange->StartAddress + mCurrentRange->Length)) {
+      BlockBoundary = BlockSize;
     } else {
       BlockBoundary = mCurrentRange->StartAddress + mCurrentRange->Length - mCurrentAddress;
     }
@@ -608,9 +845,7 @@ GenPerformMemoryTest (
       // The software memory test (R/W/V) perform here. It will detect the
       // memory mis-compare error.
       //
-      WriteMemory (Private, mCurrentAddress, BlockBoundary);
-
-      Status = VerifyMemory (Private, mCurrentAddress, BlockBoundary);
+      Status = ParallelRangeTest (Private, mCurrentAddress, BlockBoundary);
       if (EFI_ERROR (Status)) {
         //
         // If perform here, means there is mis-compare error, and no agent can
@@ -634,7 +869,7 @@ GenPerformMemoryTest (
     //
     // Update the current test address pointing to next BDS BLOCK
     //
-    mCurrentAddress += Private->BdsBlockSize;
+    mCurrentAddress += BlockSize;
 
     return EFI_SUCCESS;
   }
@@ -833,6 +1068,8 @@ GENERIC_MEMORY_TEST_PRIVATE mGenericMemoryTestPrivate = {
   EFI_GENERIC_MEMORY_TEST_PRIVATE_SIGNATURE,
   NULL,
   NULL,
+  NULL,
+  1,
   {
     InitializeMemoryTest,
     GenPerformMemoryTest,
@@ -13,6 +13,7 @@
 #include <Guid/StatusCodeDataTypeId.h>
 #include <Protocol/GenericMemoryTest.h>
 #include <Protocol/Cpu.h>
+#include <Protocol/MpService.h>
 
 #include <Library/DebugLib.h>
 #include <Library/UefiDriverEntryPoint.h>
@@ -23,6 +24,8 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/MemoryAllocationLib.h>
 #include <Library/UefiBootServicesTableLib.h>
+#include <Library/SynchronizationLib.h>
+#include <Library/CacheMaintenanceLib.h>
 
 //
 // Some global define
@@ -82,6 +85,12 @@ typedef struct {
   //
   EFI_CPU_ARCH_PROTOCOL             *Cpu;
 
+  //
+  // MP services protocol's pointer, used to spread the test over the APs
+  //
+  EFI_MP_SERVICES_PROTOCOL          *Mp;
+  UINTN                             NumberOfEnabledProcessors;
+
   //
   // generic memory test driver's protocol
   //
@@ -120,6 +129,21 @@ typedef struct {
   EFI_GENERIC_MEMORY_TEST_PRIVATE_SIGNATURE \
   )
 
+//
+// Work shared by the processors testing one block of memory in parallel.
+// The block is cut into chunks of ChunkSize bytes, and every processor
+// claims the next untested chunk through NextChunk.
+//
+typedef struct {
+  GENERIC_MEMORY_TEST_PRIVATE       *Private;
+  EFI_PHYSICAL_ADDRESS              Start;
+  UINT64                            Length;
+  UINT64                            ChunkSize;
+  UINT32                            NumberOfChunks;
+  volatile UINT32                   NextChunk;
+  volatile UINT64                   ErrorAddress;
+} MEMORY_TEST_MP_CONTEXT;
+
 //
 // Function Prototypes
 //
@@ -213,6 +237,84 @@ WriteMemory (
   IN  UINT64                       Size
   );
 
+/**
+  Write the memory test pattern into a range of physical memory without
+  flushing the cache.
+
+  This function does not use any UEFI service, so it may run on an AP.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+  @param[in] Start    The memory range's start address.
+  @param[in] Size     The memory range's size.
+
+**/
+VOID
+FillMemoryPattern (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size
+  );
+
+/**
+  Compare the range of physical memory with the memory test pattern.
+
+  This function does not use any UEFI service, so it may run on an AP.
+
+  @param[in]  Private       Point to generic memory test driver's private data.
+  @param[in]  Start         The memory range's start address.
+  @param[in]  Size          The memory range's size.
+  @param[out] ErrorAddress  The address of the first miscompare found.
+
+  @retval TRUE   The whole range matches the memory test pattern.
+  @retval FALSE  A miscompare was found at ErrorAddress.
+
+**/
+BOOLEAN
+CompareMemoryPattern (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size,
+  OUT EFI_PHYSICAL_ADDRESS         *ErrorAddress
+  );
+
+/**
+  Report an uncorrectable memory error found by the memory test.
+
+  @param[in] Address  The address of the memory error.
+
+  @retval EFI_DEVICE_ERROR      The memory error was reported.
+  @retval EFI_OUT_OF_RESOURCES  No memory to build the error data.
+
+**/
+EFI_STATUS
+ReportMemoryError (
+  IN  EFI_PHYSICAL_ADDRESS         Address
+  );
+
+/**
+  Write and verify the memory test pattern over a range of physical memory,
+  using all the enabled processors.
+
+  The range is cut into BdsBlockSize chunks that are tested by the APs, each
+  processor doing the write, cache flush and verify of its own chunks. If
+  there is no AP to run on, the range is tested on the BSP.
+
+  @param[in] Private  Point to generic memory test driver's private data.
+  @param[in] Start    The memory range's start address.
+  @param[in] Size     The memory range's size.
+
+  @retval EFI_SUCCESS       No error found in the range of memory.
+  @retval EFI_DEVICE_ERROR  The range of memory have errors contained.
+  @retval Others            Failed to report the memory error.
+
+**/
+EFI_STATUS
+ParallelRangeTest (
+  IN  GENERIC_MEMORY_TEST_PRIVATE  *Private,
+  IN  EFI_PHYSICAL_ADDRESS         Start,
+  IN  UINT64                       Size
+  );
+
 /**
   Verify the range of physical memory which covered by memory test pattern.
 
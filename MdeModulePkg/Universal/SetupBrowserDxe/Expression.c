@@ -899,6 +899,85 @@ IdToQuestion (
 }
 
 
+/**
+  Search the Question referenced by an expression OpCode.
+
+  IdToQuestion() walks every Statement of the FormSet, which makes evaluating
+  all conditional expressions of a large FormSet quadratic. The Question found
+  is kept in the OpCode and reused as long as the Expression is evaluated from
+  the same Form. The OpCodes live as long as the Statements they reference,
+  since both are freed by DestroyFormSet().
+
+  @param  FormSet                The formset which contains this OpCode.
+  @param  Form                   The form the Expression is evaluated from.
+  @param  OpCode                 The OpCode which references the Question.
+  @param  Second                 TRUE to search QuestionId2, FALSE for QuestionId.
+
+  @retval Pointer                The Question.
+  @retval NULL                   Specified Question not found in the formset.
+
+**/
+FORM_BROWSER_STATEMENT *
+OpCodeIdToQuestion (
+  IN     FORM_BROWSER_FORMSET  *FormSet,
+  IN     FORM_BROWSER_FORM     *Form,
+  IN OUT EXPRESSION_OPCODE     *OpCode,
+  IN     BOOLEAN               Second
+  )
+{
+  LIST_ENTRY              *Link;
+  EFI_QUESTION_ID         QuestionId;
+  FORM_BROWSER_FORM       **QuestionForm;
+  FORM_BROWSER_STATEMENT  **Question;
+
+  if (OpCode->QuestionScope != Form) {
+    OpCode->QuestionScope = Form;
+    OpCode->Question      = NULL;
+    OpCode->Question2     = NULL;
+  }
+
+  if (Second) {
+    QuestionId   = OpCode->QuestionId2;
+    QuestionForm = &OpCode->Question2Form;
+    Question     = &OpCode->Question2;
+  } else {
+    QuestionId   = OpCode->QuestionId;
+    QuestionForm = &OpCode->QuestionForm;
+    Question     = &OpCode->Question;
+  }
+
+  if (*Question == NULL) {
+    //
+    // Search in the form scope first, then in the formset scope
+    //
+    *QuestionForm = Form;
+    *Question     = IdToQuestion2 (Form, QuestionId);
+
+    Link = GetFirstNode (&FormSet->FormListHead);
+    while (*Question == NULL && !IsNull (&FormSet->FormListHead, Link)) {
+      *QuestionForm = FORM_BROWSER_FORM_FROM_LINK (Link);
+      *Question     = IdToQuestion2 (*QuestionForm, QuestionId);
+
+      Link = GetNextNode (&FormSet->FormListHead, Link);
+    }
+
+    if (*Question == NULL) {
+      return NULL;
+    }
+  }
+
+  if ((*QuestionForm != Form) && ((*Question)->Storage->Type == EFI_HII_VARSTORE_EFI_VARIABLE)) {
+    //
+    // EFI variable storage may be updated by Callback() asynchronous,
+    // to keep synchronous, always reload the Question Value.
+    //
+    GetQuestionValue (FormSet, *QuestionForm, *Question, GetSetValueWithHiiDriver);
+  }
+
+  return *Question;
+}
+
+
 /**
   Get Expression given its RuleId.
 
@@ -2580,7 +2659,7 @@ EvaluateExpression (
     // Built-in functions
     //
     case EFI_IFR_EQ_ID_VAL_OP:
-      Question = IdToQuestion (FormSet, Form, OpCode->QuestionId);
+      Question = OpCodeIdToQuestion (FormSet, Form, OpCode, FALSE);
       if (Question == NULL) {
         Value->Type = EFI_IFR_TYPE_UNDEFINED;
         break;
@@ -2600,13 +2679,13 @@ EvaluateExpression (
       break;
 
     case EFI_IFR_EQ_ID_ID_OP:
-      Question = IdToQuestion (FormSet, Form, OpCode->QuestionId);
+      Question = OpCodeIdToQuestion (FormSet, Form, OpCode, FALSE);
       if (Question == NULL) {
         Value->Type = EFI_IFR_TYPE_UNDEFINED;
         break;
       }
 
-      Question2 = IdToQuestion (FormSet, Form, OpCode->QuestionId2);
+      Question2 = OpCodeIdToQuestion (FormSet, Form, OpCode, TRUE);
       if (Question2 == NULL) {
         Value->Type = EFI_IFR_TYPE_UNDEFINED;
         break;
@@ -2625,7 +2704,7 @@ EvaluateExpression (
       break;
 
     case EFI_IFR_EQ_ID_VAL_LIST_OP:
-      Question = IdToQuestion (FormSet, Form, OpCode->QuestionId);
+      Question = OpCodeIdToQuestion (FormSet, Form, OpCode, FALSE);
       if (Question == NULL) {
         Value->Type = EFI_IFR_TYPE_UNDEFINED;
         break;
@@ -2651,7 +2730,7 @@ EvaluateExpression (
 
     case EFI_IFR_QUESTION_REF1_OP:
     case EFI_IFR_THIS_OP:
-      Question = IdToQuestion (FormSet, Form, OpCode->QuestionId);
+      Question = OpCodeIdToQuestion (FormSet, Form, OpCode, FALSE);
       if (Question == NULL) {
         Status = EFI_NOT_FOUND;
         goto Done;
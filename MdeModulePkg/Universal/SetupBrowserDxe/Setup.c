@@ -46,6 +46,8 @@ LIST_ENTRY      gBrowserFormSetList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserFor
 LIST_ENTRY      gBrowserHotKeyList  = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserHotKeyList);
 LIST_ENTRY      gBrowserStorageList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserStorageList);
 LIST_ENTRY      gBrowserSaveFailFormSetList = INITIALIZE_LIST_HEAD_VARIABLE (gBrowserSaveFailFormSetList);
+LIST_ENTRY      mFormSetIfrCacheList = INITIALIZE_LIST_HEAD_VARIABLE (mFormSetIfrCacheList);
+BOOLEAN         mFormSetIfrCacheEnabled = FALSE;
 
 BOOLEAN               mSystemSubmit = FALSE;
 BOOLEAN               gResetRequiredFormLevel;
@@ -869,6 +871,90 @@ FormDisplayCallback (
                   );
 }
 
+/**
+  Drop the cached FormSet IFR binaries of a HII package list.
+
+  Registered for every change of a Form package, so a cached IFR binary
+  never outlives the package it was copied from.
+
+  @param PackageType             Package type of the notification.
+  @param PackageGuid             If PackageType is EFI_HII_PACKAGE_TYPE_GUID, then this is
+                                 the pointer to the GUID from the Guid field of
+                                 EFI_HII_PACKAGE_GUID_HEADER. Otherwise, it must be NULL.
+  @param Package                 Points to the package referred to by the notification.
+  @param Handle                  The handle of the package list which contains the
+                                 specified package.
+  @param NotifyType              The type of change concerning the database.
+
+  @retval EFI_SUCCESS            Always return success.
+
+**/
+EFI_STATUS
+EFIAPI
+FormSetIfrCacheNotify (
+  IN UINT8                              PackageType,
+  IN CONST EFI_GUID                     *PackageGuid,
+  IN CONST EFI_HII_PACKAGE_HEADER       *Package,
+  IN EFI_HII_HANDLE                     Handle,
+  IN EFI_HII_DATABASE_NOTIFY_TYPE       NotifyType
+  )
+{
+  LIST_ENTRY           *Link;
+  FORMSET_IFR_CACHE    *Cache;
+
+  Link = GetFirstNode (&mFormSetIfrCacheList);
+  while (!IsNull (&mFormSetIfrCacheList, Link)) {
+    Cache = FORMSET_IFR_CACHE_FROM_LINK (Link);
+    Link = GetNextNode (&mFormSetIfrCacheList, Link);
+
+    if (Cache->HiiHandle == Handle) {
+      RemoveEntryList (&Cache->Link);
+      FreePool (Cache->BinaryData);
+      FreePool (Cache);
+    }
+  }
+
+  return EFI_SUCCESS;
+}
+
+/**
+  Enable the FormSet IFR binary cache.
+
+  The cache is only used when the browser is told about every change of a
+  Form package, so it stays disabled if any notification can't be registered.
+
+**/
+VOID
+InitializeFormSetIfrCache (
+  VOID
+  )
+{
+  EFI_STATUS                    Status;
+  EFI_HANDLE                    NotifyHandle;
+  UINTN                         Index;
+  EFI_HII_DATABASE_NOTIFY_TYPE  NotifyTypes[3];
+
+  NotifyTypes[0] = EFI_HII_DATABASE_NOTIFY_NEW_PACK;
+  NotifyTypes[1] = EFI_HII_DATABASE_NOTIFY_ADD_PACK;
+  NotifyTypes[2] = EFI_HII_DATABASE_NOTIFY_REMOVE_PACK;
+
+  for (Index = 0; Index < ARRAY_SIZE (NotifyTypes); Index++) {
+    Status = mHiiDatabase->RegisterPackageNotify (
+                             mHiiDatabase,
+                             EFI_HII_PACKAGE_FORMS,
+                             NULL,
+                             FormSetIfrCacheNotify,
+                             NotifyTypes[Index],
+                             &NotifyHandle
+                             );
+    if (EFI_ERROR (Status)) {
+      return;
+    }
+  }
+
+  mFormSetIfrCacheEnabled = TRUE;
+}
+
 /**
   Initialize Setup Browser driver.
 
@@ -948,6 +1034,8 @@ InitializeSetup (
 
   InitializeDisplayFormData ();
 
+  InitializeFormSetIfrCache ();
+
   Status = gBS->LocateProtocol (
                   &gEdkiiFormDisplayEngineProtocolGuid,
                   NULL,
@@ -5796,6 +5884,8 @@ GetIfrBinaryData (
   BOOLEAN                      ClassGuidMatch;
   EFI_GUID                     *ClassGuid;
   EFI_GUID                     *ComparingGuid;
+  LIST_ENTRY                   *Link;
+  FORMSET_IFR_CACHE            *Cache;
 
   OpCodeData = NULL;
   Package = NULL;
@@ -5810,6 +5900,29 @@ GetIfrBinaryData (
     ComparingGuid = FormSetGuid;
   }
 
+  //
+  // Use the copy taken last time if the Form package hasn't changed since.
+  //
+  Link = GetFirstNode (&mFormSetIfrCacheList);
+  while (!IsNull (&mFormSetIfrCacheList, Link)) {
+    Cache = FORMSET_IFR_CACHE_FROM_LINK (Link);
+    Link = GetNextNode (&mFormSetIfrCacheList, Link);
+
+    if ((Cache->HiiHandle == Handle) &&
+        (Cache->PlatformSetup == (BOOLEAN) (ComparingGuid == &gEfiHiiPlatformSetupFormsetGuid)) &&
+        CompareGuid (&Cache->RequestGuid, ComparingGuid)) {
+      *BinaryData = AllocateCopyPool (Cache->BinaryLength, Cache->BinaryData);
+      if (*BinaryData == NULL) {
+        return EFI_OUT_OF_RESOURCES;
+      }
+      *BinaryLength = Cache->BinaryLength;
+      if (FormSetGuid != NULL) {
+        CopyGuid (FormSetGuid, &Cache->FormSetGuid);
+      }
+      return EFI_SUCCESS;
+    }
+  }
+
   //
   // Get HII PackageList
   //
@@ -5899,6 +6012,24 @@ GetIfrBinaryData (
     return EFI_NOT_FOUND;
   }
 
+  if (mFormSetIfrCacheEnabled) {
+    Cache = AllocateZeroPool (sizeof (FORMSET_IFR_CACHE));
+    if (Cache != NULL) {
+      Cache->BinaryData = AllocateCopyPool (PackageHeader.Length - Offset2, OpCodeData);
+      if (Cache->BinaryData == NULL) {
+        FreePool (Cache);
+      } else {
+        Cache->Signature     = FORMSET_IFR_CACHE_SIGNATURE;
+        Cache->HiiHandle     = Handle;
+        Cache->PlatformSetup = (BOOLEAN) (ComparingGuid == &gEfiHiiPlatformSetupFormsetGuid);
+        Cache->BinaryLength  = PackageHeader.Length - Offset2;
+        CopyGuid (&Cache->RequestGuid, ComparingGuid);
+        CopyGuid (&Cache->FormSetGuid, &((EFI_IFR_FORM_SET *) OpCodeData)->Guid);
+        InsertTailList (&mFormSetIfrCacheList, &Cache->Link);
+      }
+    }
+  }
+
   if (FormSetGuid != NULL) {
     //
     // Return the FormSet GUID
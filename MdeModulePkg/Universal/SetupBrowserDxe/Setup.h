@@ -184,6 +184,9 @@ typedef union {
   UINT16                VarOffset;
 } VAR_STORE_INFO;
 
+typedef struct _FORM_BROWSER_STATEMENT FORM_BROWSER_STATEMENT;
+typedef struct _FORM_BROWSER_FORM      FORM_BROWSER_FORM;
+
 #define EXPRESSION_OPCODE_SIGNATURE  SIGNATURE_32 ('E', 'X', 'O', 'P')
 
 typedef struct {
@@ -201,6 +204,12 @@ typedef struct {
   EFI_QUESTION_ID   QuestionId;  // For EFI_IFR_EQ_ID_ID, EFI_IFR_EQ_ID_VAL_LIST, EFI_IFR_QUESTION_REF1
   EFI_QUESTION_ID   QuestionId2;
 
+  FORM_BROWSER_FORM       *QuestionScope;  // Form the QuestionId/QuestionId2 lookups were made from
+  FORM_BROWSER_FORM       *QuestionForm;   // Form which contains Question
+  FORM_BROWSER_STATEMENT  *Question;       // Question of QuestionId, NULL until looked up
+  FORM_BROWSER_FORM       *Question2Form;  // Form which contains Question2
+  FORM_BROWSER_STATEMENT  *Question2;      // Question of QuestionId2, NULL until looked up
+
   UINT16            ListLength;  // For EFI_IFR_EQ_ID_VAL_LIST
   UINT16            *ValueList;
 
@@ -292,8 +301,6 @@ typedef enum {
   ExpressOption
 } EXPRESS_LEVEL;
 
-typedef struct _FORM_BROWSER_STATEMENT FORM_BROWSER_STATEMENT;
-
 #define FORM_BROWSER_STATEMENT_SIGNATURE  SIGNATURE_32 ('F', 'S', 'T', 'A')
 
 struct _FORM_BROWSER_STATEMENT{
@@ -397,7 +404,7 @@ typedef struct {
 #define FORM_BROWSER_FORM_SIGNATURE  SIGNATURE_32 ('F', 'F', 'R', 'M')
 #define STANDARD_MAP_FORM_TYPE 0x01
 
-typedef struct {
+struct _FORM_BROWSER_FORM {
   UINTN                Signature;
   LIST_ENTRY           Link;
 
@@ -416,7 +423,7 @@ typedef struct {
   LIST_ENTRY           StatementListHead;    // List of Statements and Questions (FORM_BROWSER_STATEMENT)
   LIST_ENTRY           ConfigRequestHead;    // List of configreques for all storage.
   FORM_EXPRESSION_LIST *SuppressExpression;  // nesting inside of SuppressIf
-} FORM_BROWSER_FORM;
+};
 
 #define FORM_BROWSER_FORM_FROM_LINK(a)  CR (a, FORM_BROWSER_FORM, Link, FORM_BROWSER_FORM_SIGNATURE)
 
@@ -549,6 +556,25 @@ typedef struct {
 
 #define BROWSER_CONTEXT_FROM_LINK(a)  CR (a, BROWSER_CONTEXT, Link, BROWSER_CONTEXT_SIGNATURE)
 
+#define FORMSET_IFR_CACHE_SIGNATURE  SIGNATURE_32 ('F', 'I', 'F', 'C')
+
+//
+// Copy of a FormSet IFR binary, kept until the Form package it came from changes.
+//
+typedef struct {
+  UINTN                    Signature;
+  LIST_ENTRY               Link;
+
+  EFI_HII_HANDLE           HiiHandle;
+  EFI_GUID                 RequestGuid;       // GUID or class GUID used for the lookup
+  BOOLEAN                  PlatformSetup;     // Lookup was made with gEfiHiiPlatformSetupFormsetGuid
+  EFI_GUID                 FormSetGuid;       // GUID of the FormSet found
+  UINTN                    BinaryLength;
+  UINT8                    *BinaryData;
+} FORMSET_IFR_CACHE;
+
+#define FORMSET_IFR_CACHE_FROM_LINK(a)  CR (a, FORMSET_IFR_CACHE, Link, FORMSET_IFR_CACHE_SIGNATURE)
+
 //
 // Scope for get defaut value. It may be GetDefaultForNoStorage, GetDefaultForStorage or GetDefaultForAll.
 //
@@ -2,8 +2,9 @@
   TCG MOR (Memory Overwrite Request) Control Driver.
 
   This driver initialize MemoryOverwriteRequestControl variable. It
-  will clear MOR_CLEAR_MEMORY_BIT bit if it is set. It will also do TPer Reset for
-  those encrypted drives through EFI_STORAGE_SECURITY_COMMAND_PROTOCOL at EndOfDxe.
+  will clear MOR_CLEAR_MEMORY_BIT bit if it is set, optionally clearing the
+  free system memory first. It will also do TPer Reset for those encrypted drives
+  through EFI_STORAGE_SECURITY_COMMAND_PROTOCOL at EndOfDxe.
 
 Copyright (c) 2009 - 2018, Intel Corporation. All rights reserved.<BR>
 SPDX-License-Identifier: BSD-2-Clause-Patent
@@ -30,6 +31,7 @@ OnReadyToBoot (
 {
   EFI_STATUS  Status;
   UINTN       DataSize;
+  UINT64      ClearedSize;
 
   if (MOR_CLEAR_MEMORY_VALUE (mMorControl) == 0x0) {
     //
@@ -37,6 +39,26 @@ OnReadyToBoot (
     //
     return ;
   }
+
+  if (PcdGetBool (PcdMorClearFreeMemory)) {
+    //
+    // Overwrite the memory that may still hold secrets of the previous boot
+    // before it is handed to the OS loader.
+    //
+    PERF_INMODULE_BEGIN ("MorClearMemory");
+    Status = ParallelClearFreeMemory (&ClearedSize);
+    PERF_INMODULE_END ("MorClearMemory");
+    if (EFI_ERROR (Status)) {
+      //
+      // Leave MOR_CLEAR_MEMORY_BIT set, so that the memory is cleared on the
+      // next boot by the platform, as it is without PcdMorClearFreeMemory.
+      //
+      DEBUG ((EFI_D_ERROR, "TcgMor: Clear free memory failure, Status = %r\n", Status));
+      return;
+    }
+    DEBUG ((EFI_D_INFO, "TcgMor: Cleared 0x%lx bytes of free memory\n", ClearedSize));
+  }
+
   //
   // Clear MOR_CLEAR_MEMORY_BIT
   //
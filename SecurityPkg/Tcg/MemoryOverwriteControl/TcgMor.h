@@ -19,6 +19,9 @@ SPDX-License-Identifier: BSD-2-Clause-Patent
 #include <Library/DebugLib.h>
 #include <Library/UefiLib.h>
 #include <Library/MemoryAllocationLib.h>
+#include <Library/PcdLib.h>
+#include <Library/PerformanceLib.h>
+#include <Library/ParallelMemoryLib.h>
 
 #include <Protocol/StorageSecurityCommand.h>
 #include <Protocol/BlockIo.h>
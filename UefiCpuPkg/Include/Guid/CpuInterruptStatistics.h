@@ -0,0 +1,45 @@
+/** @file
+  The CPU interrupt statistics table records how often each interrupt vector
+  was dispatched to a registered handler and how long the handlers ran.
+
+  Copyright (c) 2026, omkkul01. All rights reserved.<BR>
+  SPDX-License-Identifier: BSD-2-Clause-Patent
+
+**/
+
+#ifndef _CPU_INTERRUPT_STATISTICS_H_
+#define _CPU_INTERRUPT_STATISTICS_H_
+
+#define EDKII_CPU_INTERRUPT_STATISTICS_GUID \
+  { \
+    0x3b8e0f46, 0x1c55, 0x4d2a, { 0x9a, 0x7e, 0x62, 0xd1, 0x0b, 0x84, 0xf3, 0x2c } \
+  }
+
+extern EFI_GUID gEdkiiCpuInterruptStatisticsGuid;
+
+//
+// Number of entries in the CPU interrupt statistics table, one per vector.
+//
+#define EDKII_CPU_INTERRUPT_STATISTICS_COUNT  256
+
+//
+// The EDKII CPU interrupt statistics table is installed as an EFI configuration
+// table by the DXE CpuExceptionHandlerLib instance when
+// PcdCpuInterruptStatisticsEnable is TRUE. It is an array of
+// EDKII_CPU_INTERRUPT_STATISTICS_COUNT elements indexed by vector number.
+// Counters are updated without locking, so the values are approximate when
+// interrupt handlers run on several processors at the same time.
+//
+typedef struct {
+  //
+  // The number of times a registered handler was invoked for the vector.
+  //
+  UINT64    Count;
+  //
+  // The accumulated time stamp counter ticks spent in the handler, including
+  // any nested interrupts it allowed.
+  //
+  UINT64    Cycles;
+} EDKII_CPU_INTERRUPT_STATISTICS;
+
+#endif
@@ -16,6 +16,12 @@
 //
 CONST UINT32 mErrorCodeFlag = 0x20227d00;
 
+//
+// 1 means the handler of the vector does not touch FX state, so that the X64
+// interrupt entry skips FXSAVE/FXRSTOR for it, otherwise 0
+//
+UINT32 mNoFxSaveVectorMask[CPU_INTERRUPT_NUM / 32];
+
 //
 // Define the maximum message length
 //
@@ -19,6 +19,7 @@
 #include <Library/BaseMemoryLib.h>
 #include <Library/SynchronizationLib.h>
 #include <Library/CpuExceptionHandlerLib.h>
+#include <Guid/CpuInterruptStatistics.h>
 
 #define  CPU_EXCEPTION_NUM          32
 #define  CPU_INTERRUPT_NUM         256
@@ -59,14 +60,16 @@ typedef struct {
 } EXCEPTION_HANDLER_TEMPLATE_MAP;
 
 typedef struct {
-  UINTN                       IdtEntryCount;
-  SPIN_LOCK                   DisplayMessageSpinLock;
-  RESERVED_VECTORS_DATA       *ReservedVectors;
-  EFI_CPU_INTERRUPT_HANDLER   *ExternalInterruptHandler;
+  UINTN                           IdtEntryCount;
+  SPIN_LOCK                       DisplayMessageSpinLock;
+  RESERVED_VECTORS_DATA           *ReservedVectors;
+  EFI_CPU_INTERRUPT_HANDLER       *ExternalInterruptHandler;
+  EDKII_CPU_INTERRUPT_STATISTICS  *InterruptStatistics;
 } EXCEPTION_HANDLER_DATA;
 
 extern CONST UINT32                mErrorCodeFlag;
 extern CONST UINTN                 mDoFarReturnFlag;
+extern UINT32                      mNoFxSaveVectorMask[];
 
 /**
   Return address map of exception handler template so that C code can generate
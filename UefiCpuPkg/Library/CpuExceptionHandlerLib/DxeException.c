@@ -100,6 +100,8 @@ InitializeCpuInterruptHandlers (
   UINT8                              *InterruptEntryCode;
   RESERVED_VECTORS_DATA              *ReservedVectors;
   EFI_CPU_INTERRUPT_HANDLER          *ExternalInterruptHandler;
+  EDKII_CPU_INTERRUPT_STATISTICS     *InterruptStatistics;
+  UINT8                              *NoFxSaveVectorList;
 
   Status = gBS->AllocatePool (
                   EfiBootServicesCode,
@@ -119,6 +121,33 @@ InitializeCpuInterruptHandlers (
   ExternalInterruptHandler = AllocateZeroPool (sizeof (EFI_CPU_INTERRUPT_HANDLER) * CPU_INTERRUPT_NUM);
   ASSERT (ExternalInterruptHandler != NULL);
 
+  //
+  // Publish per-vector interrupt statistics if required
+  //
+  InterruptStatistics = NULL;
+  if (FeaturePcdGet (PcdCpuInterruptStatisticsEnable)) {
+    InterruptStatistics = AllocateZeroPool (sizeof (EDKII_CPU_INTERRUPT_STATISTICS) * EDKII_CPU_INTERRUPT_STATISTICS_COUNT);
+    ASSERT (InterruptStatistics != NULL);
+    if (InterruptStatistics != NULL) {
+      Status = gBS->InstallConfigurationTable (&gEdkiiCpuInterruptStatisticsGuid, InterruptStatistics);
+      ASSERT_EFI_ERROR (Status);
+    }
+  }
+
+  //
+  // Mark interrupt vectors whose handlers do not touch FX state, so that the
+  // interrupt entry can skip saving and restoring it
+  //
+  NoFxSaveVectorList = (UINT8 *) FixedPcdGetPtr (PcdCpuInterruptNoFxSaveVectorList);
+  for (Index = 0; Index < FixedPcdGetSize (PcdCpuInterruptNoFxSaveVectorList); Index++) {
+    if (NoFxSaveVectorList[Index] == 0) {
+      break;
+    }
+    if (NoFxSaveVectorList[Index] >= CPU_EXCEPTION_NUM) {
+      mNoFxSaveVectorMask[NoFxSaveVectorList[Index] / 32] |= (UINT32) 1 << (NoFxSaveVectorList[Index] % 32);
+    }
+  }
+
   //
   // Read IDT descriptor and calculate IDT size
   //
@@ -159,6 +188,7 @@ InitializeCpuInterruptHandlers (
   mExceptionHandlerData.IdtEntryCount            = CPU_INTERRUPT_NUM;
   mExceptionHandlerData.ReservedVectors          = ReservedVectors;
   mExceptionHandlerData.ExternalInterruptHandler = ExternalInterruptHandler;
+  mExceptionHandlerData.InterruptStatistics      = InterruptStatistics;
   InitializeSpinLock (&mExceptionHandlerData.DisplayMessageSpinLock);
 
   UpdateIdtTable (IdtTable, &TemplateMap, &mExceptionHandlerData);
@@ -134,6 +134,7 @@ InitializeCpuExceptionHandlers (
   ASSERT (ExceptionHandlerData != NULL);
   ExceptionHandlerData->ReservedVectors          = ReservedVectors;
   ExceptionHandlerData->ExternalInterruptHandler = NULL;
+  ExceptionHandlerData->InterruptStatistics      = NULL;
   InitializeSpinLock (&ExceptionHandlerData->DisplayMessageSpinLock);
 
   Status = InitializeCpuExceptionHandlersWorker (VectorInfo, ExceptionHandlerData);
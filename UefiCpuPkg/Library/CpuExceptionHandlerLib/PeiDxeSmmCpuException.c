@@ -27,6 +27,8 @@ CommonExceptionHandlerWorker (
   EXCEPTION_HANDLER_CONTEXT      *ExceptionHandlerContext;
   RESERVED_VECTORS_DATA          *ReservedVectors;
   EFI_CPU_INTERRUPT_HANDLER      *ExternalInterruptHandler;
+  EDKII_CPU_INTERRUPT_STATISTICS *InterruptStatistics;
+  UINT64                         StartTsc;
 
   if (ExceptionType == VC_EXCEPTION) {
     EFI_STATUS  Status;
@@ -106,7 +108,18 @@ CommonExceptionHandlerWorker (
 
   if (ExternalInterruptHandler != NULL &&
       ExternalInterruptHandler[ExceptionType] != NULL) {
-    (ExternalInterruptHandler[ExceptionType]) (ExceptionType, SystemContext);
+    InterruptStatistics = ExceptionHandlerData->InterruptStatistics;
+    if (InterruptStatistics == NULL) {
+      (ExternalInterruptHandler[ExceptionType]) (ExceptionType, SystemContext);
+    } else {
+      //
+      // Count the interrupt and the cycles spent in its handler
+      //
+      StartTsc = AsmReadTsc ();
+      (ExternalInterruptHandler[ExceptionType]) (ExceptionType, SystemContext);
+      InterruptStatistics[ExceptionType].Count++;
+      InterruptStatistics[ExceptionType].Cycles += AsmReadTsc () - StartTsc;
+    }
   } else if (ExceptionType < CPU_EXCEPTION_NUM) {
     //
     // Get Spinlock to display CPU information
@@ -19,6 +19,7 @@ SMM_DISPATCHER_MP_SYNC_DATA                 *mSmmMpSyncData = NULL;
 UINTN                                       mSmmMpSyncDataSize;
 SMM_CPU_SEMAPHORES                          mSmmCpuSemaphores;
 UINTN                                       mSemaphoreSize;
+UINTN                                       mNumberOfPackageSlots;
 SPIN_LOCK                                   *mPFLock = NULL;
 SMM_CPU_SYNC_MODE                           mCpuSmmSyncMode;
 BOOLEAN                                     mMachineCheckSupported = FALSE;
@@ -113,9 +114,30 @@ LockdownSemaphore (
   return Value;
 }
 
+/**
+  Return the package semaphore in the given slot.
+
+  @param   Slot             Package slot index.
+
+  @return  Pointer to the package semaphore.
+
+**/
+volatile UINT32 *
+GetPackageSemaphore (
+  IN      UINTN                     Slot
+  )
+{
+  return (volatile UINT32 *)((UINTN)mSmmCpuSemaphores.SemaphoreCpu.PackageRun + mSemaphoreSize * Slot);
+}
+
 /**
   Wait all APs to performs an atomic compare exchange operation to release semaphore.
 
+  APs signal the semaphore of their own package rather than a single BSP
+  semaphore, so each AP only contends on a cache line shared with the other
+  threads of its package. The BSP collects the signals by sweeping the
+  package semaphores and consumes exactly NumberOfAPs of them.
+
   @param   NumberOfAPs      AP number
 
 **/
@@ -124,11 +146,30 @@ WaitForAllAPs (
   IN      UINTN                     NumberOfAPs
   )
 {
-  UINTN                             BspIndex;
+  UINTN                             Slot;
+  volatile UINT32                   *Sem;
+  UINT32                            Value;
+  UINT32                            Taken;
 
-  BspIndex = mSmmMpSyncData->BspIndex;
-  while (NumberOfAPs-- > 0) {
-    WaitForSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+  while (NumberOfAPs > 0) {
+    for (Slot = 0; Slot < mNumberOfPackageSlots && NumberOfAPs > 0; Slot++) {
+      Sem   = GetPackageSemaphore (Slot);
+      Value = *Sem;
+      if (Value == 0) {
+        continue;
+      }
+      Taken = (UINT32)MIN (Value, NumberOfAPs);
+      if (InterlockedCompareExchange32 (
+            (UINT32*)Sem,
+            Value,
+            Value - Taken
+            ) == Value) {
+        NumberOfAPs -= Taken;
+      }
+    }
+    if (NumberOfAPs > 0) {
+      CpuPause ();
+    }
   }
 }
 
@@ -772,7 +813,7 @@ APHandler (
     //
     // Notify BSP of arrival at this point
     //
-    ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+    ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
   }
 
   if (SmmCpuFeaturesNeedConfigureMtrrs()) {
@@ -789,7 +830,7 @@ APHandler (
     //
     // Signal BSP the completion of this AP
     //
-    ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+    ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
 
     //
     // Wait for BSP's signal to program MTRRs
@@ -804,7 +845,7 @@ APHandler (
     //
     // Signal BSP the completion of this AP
     //
-    ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+    ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
   }
 
   while (TRUE) {
@@ -851,7 +892,7 @@ APHandler (
     //
     // Notify BSP the readiness of this AP to program MTRRs
     //
-    ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+    ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
 
     //
     // Wait for the signal from BSP to program MTRRs
@@ -868,7 +909,7 @@ APHandler (
   //
   // Notify BSP the readiness of this AP to Reset states/semaphore for this processor
   //
-  ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+  ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
 
   //
   // Wait for the signal from BSP to Reset states/semaphore for this processor
@@ -883,7 +924,7 @@ APHandler (
   //
   // Notify BSP the readiness of this AP to exit SMM
   //
-  ReleaseSemaphore (mSmmMpSyncData->CpuData[BspIndex].Run);
+  ReleaseSemaphore (mSmmMpSyncData->CpuData[CpuIndex].PackageRun);
 
 }
 
@@ -1814,6 +1855,11 @@ InitializeSmmCpuSemaphores (
   mSmmCpuSemaphores.SemaphoreCpu.Run     = (UINT32 *)SemaphoreAddr;
   SemaphoreAddr += ProcessorCount * SemaphoreSize;
   mSmmCpuSemaphores.SemaphoreCpu.Present = (BOOLEAN *)SemaphoreAddr;
+  SemaphoreAddr += ProcessorCount * SemaphoreSize;
+  mSmmCpuSemaphores.SemaphoreCpu.Token   = (SPIN_LOCK *)SemaphoreAddr;
+  SemaphoreAddr += ProcessorCount * SemaphoreSize;
+  mSmmCpuSemaphores.SemaphoreCpu.PackageRun
+                                         = (UINT32 *)SemaphoreAddr;
 
   mPFLock                       = mSmmCpuSemaphores.SemaphoreGlobal.PFLock;
   mConfigSmmCodeAccessCheckLock = mSmmCpuSemaphores.SemaphoreGlobal.CodeAccessCheckLock;
@@ -1821,6 +1867,56 @@ InitializeSmmCpuSemaphores (
   mSemaphoreSize = SemaphoreSize;
 }
 
+/**
+  Assign each processor to the semaphore of its package.
+
+  Processors of the same package share one semaphore slot. Processors that
+  are not present yet (hot-plug) are assigned to slot 0; any slot is correct
+  since the BSP sweeps all of them, only locality is lost.
+
+**/
+VOID
+InitializePackageSemaphores (
+  VOID
+  )
+{
+  UINTN                      CpuIndex;
+  UINTN                      Index;
+  UINTN                      Slot;
+  UINTN                      NumberOfCpus;
+  EFI_PROCESSOR_INFORMATION  *ProcessorInfo;
+
+  NumberOfCpus  = gSmmCpuPrivate->SmmCoreEntryContext.NumberOfCpus;
+  ProcessorInfo = gSmmCpuPrivate->ProcessorInfo;
+  mNumberOfPackageSlots = 1;
+
+  for (CpuIndex = 0; CpuIndex < NumberOfCpus; CpuIndex++) {
+    Slot = 0;
+    if (ProcessorInfo[CpuIndex].ProcessorId != INVALID_APIC_ID) {
+      //
+      // Reuse the slot of the first processor found in the same package.
+      //
+      for (Index = 0; Index < CpuIndex; Index++) {
+        if (ProcessorInfo[Index].ProcessorId != INVALID_APIC_ID &&
+            ProcessorInfo[Index].Location.Package == ProcessorInfo[CpuIndex].Location.Package) {
+          break;
+        }
+      }
+      if (Index < CpuIndex) {
+        Slot = ((UINTN)mSmmMpSyncData->CpuData[Index].PackageRun - (UINTN)mSmmCpuSemaphores.SemaphoreCpu.PackageRun) / mSemaphoreSize;
+      } else if (CpuIndex != 0) {
+        Slot = mNumberOfPackageSlots++;
+      }
+    }
+    mSmmMpSyncData->CpuData[CpuIndex].PackageRun = GetPackageSemaphore (Slot);
+  }
+
+  for (Slot = 0; Slot < mNumberOfPackageSlots; Slot++) {
+    *GetPackageSemaphore (Slot) = 0;
+  }
+  DEBUG ((DEBUG_INFO, "SMM MP sync package slots = %Lu\n", (UINT64) mNumberOfPackageSlots));
+}
+
 /**
   Initialize un-cacheable data.
 
@@ -1858,6 +1954,8 @@ InitializeMpSyncData (
     *mSmmMpSyncData->InsideSmm     = FALSE;
     *mSmmMpSyncData->AllCpusInSync = FALSE;
 
+    InitializePackageSemaphores ();
+
     for (CpuIndex = 0; CpuIndex < gSmmCpuPrivate->SmmCoreEntryContext.NumberOfCpus; CpuIndex ++) {
       mSmmMpSyncData->CpuData[CpuIndex].Busy    =
         (SPIN_LOCK *)((UINTN)mSmmCpuSemaphores.SemaphoreCpu.Busy + mSemaphoreSize * CpuIndex);
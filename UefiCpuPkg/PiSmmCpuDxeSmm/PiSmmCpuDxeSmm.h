@@ -407,6 +407,11 @@ typedef struct {
   volatile BOOLEAN                  *Present;
   PROCEDURE_TOKEN                   *Token;
   EFI_STATUS                        *Status;
+  //
+  // Semaphore of the package this processor belongs to. APs signal the BSP
+  // through it so that arrival/completion traffic stays package local.
+  //
+  volatile UINT32                   *PackageRun;
 } SMM_CPU_DATA_BLOCK;
 
 typedef enum {
@@ -453,6 +458,7 @@ typedef struct {
   volatile UINT32                   *Run;
   volatile BOOLEAN                  *Present;
   SPIN_LOCK                         *Token;
+  volatile UINT32                   *PackageRun;
 } SMM_CPU_SEMAPHORE_CPU;
 
 ///